@@ -0,0 +1,102 @@
+///
+/// @file measure.hpp
+/// @brief Minimal benchmark registry and timing helpers for the benchmark binary
+///
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace bench
+{
+	struct Case
+	{
+		std::string_view name;
+		void (*function)();
+	};
+
+	// All registered benchmarks, in registration order
+	std::vector<Case>& cases() noexcept;
+
+	// Registers a benchmark during static initialization, see `BENCHMARK`
+	struct Registrar
+	{
+		Registrar(std::string_view name, void (*function)()) noexcept;
+	};
+
+	// Command line options shared by all benchmarks
+	struct Options
+	{
+		std::optional<std::filesystem::path> scene;  // Baked scene for model benchmarks, see `scene-bake`
+	};
+
+	const Options& options() noexcept;
+
+	// Wall time of repeated runs of one function
+	struct Timing
+	{
+		double median_us;
+		double min_us;
+		size_t run_count;
+	};
+
+	///
+	/// @brief Time repeated runs of a function
+	/// @details One warm-up run is discarded, then runs repeat until `budget` is spent and at least
+	/// `min_runs` are done
+	///
+	/// @param function Function to time, its return value is discarded
+	/// @param budget Total time to spend on timed runs
+	/// @param min_runs Minimum number of timed runs
+	/// @return Median and minimum time of a run
+	///
+	template <typename F>
+	Timing measure(
+		F&& function,
+		std::chrono::duration<double> budget = std::chrono::milliseconds(500),
+		size_t min_runs = 5
+	) noexcept
+	{
+		using Clock = std::chrono::steady_clock;
+
+		static_cast<void>(function());
+
+		std::vector<double> durations;
+		const auto start = Clock::now();
+
+		while (durations.size() < min_runs || Clock::now() - start < budget)
+		{
+			const auto run_start = Clock::now();
+			static_cast<void>(function());
+			durations.push_back(std::chrono::duration<double, std::micro>(Clock::now() - run_start).count());
+		}
+
+		std::ranges::nth_element(durations, durations.begin() + durations.size() / 2);
+		const auto median = durations[durations.size() / 2];
+
+		return {.median_us = median, .min_us = std::ranges::min(durations), .run_count = durations.size()};
+	}
+
+	// Print one timing row, labelled
+	void report(std::string_view label, const Timing& timing) noexcept;
+
+	// Print the speedup of `timing` over `baseline`, by median
+	void report_speedup(std::string_view label, const Timing& baseline, const Timing& timing) noexcept;
+
+	// Print a result mismatch between two compared implementations, making the run fail
+	void report_mismatch(std::string_view what) noexcept;
+
+	// Print an error that kept a benchmark from running, making the run fail
+	void report_error(std::string_view what) noexcept;
+}
+
+// Define and register a benchmark, the body follows the macro
+#define BENCHMARK(name)                                                                                      \
+	static void name() noexcept;                                                                             \
+	static const bench::Registrar name##_registrar(#name, name);                                             \
+	static void name() noexcept
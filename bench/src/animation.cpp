@@ -0,0 +1,143 @@
+#include "bench/measure.hpp"
+#include "gltf/animation.hpp"
+
+#include <cstring>
+#include <format>
+#include <glm/gtc/quaternion.hpp>
+#include <random>
+#include <ranges>
+
+// Append `values` to the only buffer of `model` behind a new accessor, returning the accessor index
+template <typename T>
+static int add_accessor(tinygltf::Model& model, std::span<const T> values) noexcept
+{
+	auto& data = model.buffers[0].data;
+	const auto byte_offset = data.size();
+	data.resize(byte_offset + values.size_bytes());
+	std::memcpy(data.data() + byte_offset, values.data(), values.size_bytes());
+
+	tinygltf::BufferView buffer_view;
+	buffer_view.buffer = 0;
+	buffer_view.byteOffset = byte_offset;
+	buffer_view.byteLength = values.size_bytes();
+	model.bufferViews.push_back(std::move(buffer_view));
+
+	tinygltf::Accessor accessor;
+	accessor.bufferView = static_cast<int>(model.bufferViews.size() - 1);
+	accessor.componentType = gltf::detail::AccessTypeTrait<T>::component_type;
+	accessor.type = gltf::detail::AccessTypeTrait<T>::type;
+	accessor.count = values.size();
+	model.accessors.push_back(std::move(accessor));
+
+	return static_cast<int>(model.accessors.size() - 1);
+}
+
+// Animation with `channel_count` linear channels cycling through translation, rotation and scale, three per
+// node, each with its own slightly jittered 30 fps keyframes
+static std::expected<gltf::Animation, util::Error> make_test_animation(
+	size_t channel_count,
+	size_t keyframe_count,
+	std::mt19937& rng
+) noexcept
+{
+	std::uniform_real_distribution<float> jitter(-0.01f, 0.01f), value(-1.0f, 1.0f);
+
+	tinygltf::Model model;
+	model.buffers.emplace_back();
+	model.nodes.resize((channel_count + 2) / 3);
+
+	tinygltf::Animation animation;
+
+	for (const auto channel_idx : std::views::iota(0zu, channel_count))
+	{
+		const auto timestamps = std::views::iota(0zu, keyframe_count)
+			| std::views::transform([&](size_t idx) { return float(idx) / 30.0f + jitter(rng); })
+			| std::ranges::to<std::vector>();
+
+		tinygltf::AnimationSampler sampler;
+		sampler.interpolation = "LINEAR";
+		sampler.input = add_accessor<float>(model, timestamps);
+
+		tinygltf::AnimationChannel channel;
+		channel.sampler = static_cast<int>(animation.samplers.size());
+		channel.target_node = static_cast<int>(channel_idx / 3);
+
+		if (channel_idx % 3 == 1)
+		{
+			const auto rotations = std::views::iota(0zu, keyframe_count)
+				| std::views::transform([&](size_t) {
+					  return glm::normalize(glm::quat(value(rng), value(rng), value(rng), value(rng)));
+				  })
+				| std::ranges::to<std::vector>();
+
+			channel.target_path = "rotation";
+			sampler.output = add_accessor<glm::quat>(model, rotations);
+		}
+		else
+		{
+			const auto vectors = std::views::iota(0zu, keyframe_count)
+				| std::views::transform([&](size_t) { return glm::vec3(value(rng), value(rng), value(rng)); })
+				| std::ranges::to<std::vector>();
+
+			channel.target_path = channel_idx % 3 == 0 ? "translation" : "scale";
+			sampler.output = add_accessor<glm::vec3>(model, vectors);
+		}
+
+		animation.samplers.push_back(std::move(sampler));
+		animation.channels.push_back(std::move(channel));
+	}
+
+	return gltf::Animation::from_tinygltf(model, animation);
+}
+
+BENCHMARK(animation_sample)
+{
+	constexpr size_t channel_count = 200, keyframe_count = 3000;
+
+	std::mt19937 rng(0x5eed);
+	const auto animation = make_test_animation(channel_count, keyframe_count, rng);
+	if (!animation)
+	{
+		bench::report_error(std::format("create animation failed: {}", animation.error()->front().message));
+		return;
+	}
+
+	// Playback from start to end at 60 fps
+	const auto [start_time, end_time] = animation->time_range();
+	const auto frame_count = static_cast<size_t>((end_time - start_time) * 60.0f) + 1;
+	const auto frame_time = [start_time](size_t frame) { return start_time + float(frame) / 60.0f; };
+
+	std::vector<gltf::Node::TransformOverride> overrides((channel_count + 2) / 3);
+	std::vector<uint32_t> cursors(animation->channel_count());
+
+	const auto search_timing = bench::measure([&] {
+		for (const auto frame : std::views::iota(0zu, frame_count))
+			animation->apply(overrides, frame_time(frame));
+	});
+	const auto cursor_timing = bench::measure([&] {
+		std::ranges::fill(cursors, 0u);
+		for (const auto frame : std::views::iota(0zu, frame_count))
+			animation->apply(overrides, frame_time(frame), cursors);
+	});
+
+	const auto sample_count = frame_count * channel_count;
+	bench::report(std::format("{} samples, search from scratch", sample_count), search_timing);
+	bench::report(std::format("{} samples, resume from cursors", sample_count), cursor_timing);
+	bench::report_speedup("speedup", search_timing, cursor_timing);
+
+	// Every frame of the playback poses the nodes identically
+	std::vector<gltf::Node::TransformOverride> search_overrides(overrides.size());
+	std::ranges::fill(cursors, 0u);
+
+	for (const auto frame : std::views::iota(0zu, frame_count))
+	{
+		animation->apply(search_overrides, frame_time(frame));
+		animation->apply(overrides, frame_time(frame), cursors);
+
+		if (overrides != search_overrides)
+		{
+			bench::report_mismatch(std::format("frame {}, cursor sampling differs from search", frame));
+			return;
+		}
+	}
+}
@@ -0,0 +1,141 @@
+#include "bench/measure.hpp"
+#include "graphics/bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <ranges>
+
+// Random boxes over a square ground area, sized like props and buildings in a city scene
+static graphics::BoxArray make_test_boxes(size_t count, std::mt19937& rng) noexcept
+{
+	const float extent = std::sqrt(float(count)) * 4.0f;
+	std::uniform_real_distribution<float> position(-extent, extent), height(0.0f, 10.0f), size(0.2f, 6.0f);
+
+	graphics::BoxArray boxes;
+	boxes.reserve(count);
+	for (const auto _ : std::views::iota(0zu, count))
+	{
+		const glm::vec3 box_min(position(rng), height(rng), position(rng));
+		boxes.push_back(box_min, box_min + glm::vec3(size(rng), size(rng), size(rng)));
+	}
+
+	return boxes;
+}
+
+// Camera above the ground looking across it, a 60 degree frustum sees a small part of the scene
+static std::array<glm::vec4, 6> test_frustum_planes() noexcept
+{
+	const auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+	const glm::vec3 eye(0.0f, 20.0f, 0.0f), target(100.0f, 0.0f, 40.0f);
+	const auto view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+	return graphics::compute_frustum_planes(projection * view);
+}
+
+// Per-box culling into a visibility mask, as done before the batched test
+static void scalar_boxes_in_frustum(
+	const graphics::BoxArray& boxes,
+	std::span<const glm::vec4> planes,
+	std::span<uint8_t> visibility
+) noexcept
+{
+	std::ranges::fill(visibility, 0);
+	for (const auto idx : std::views::iota(0zu, boxes.size()))
+		if (graphics::box_in_frustum(boxes.get_min(idx), boxes.get_max(idx), planes))
+			visibility[idx / 8] |= uint8_t(1u << (idx % 8));
+}
+
+BENCHMARK(boxes_in_frustum)
+{
+	const auto planes = test_frustum_planes();
+
+	for (const auto count : {1000zu, 10000zu, 100000zu})
+	{
+		std::mt19937 rng(static_cast<uint32_t>(count));
+		const auto boxes = make_test_boxes(count, rng);
+
+		std::vector<uint8_t> scalar_visibility(graphics::visibility_mask_size(count));
+		std::vector<uint8_t> batched_visibility(graphics::visibility_mask_size(count));
+
+		const auto scalar_timing =
+			bench::measure([&] { scalar_boxes_in_frustum(boxes, planes, scalar_visibility); });
+		const auto batched_timing =
+			bench::measure([&] { graphics::boxes_in_frustum(boxes, planes, batched_visibility); });
+
+		bench::report(std::format("{} boxes, box_in_frustum per box", count), scalar_timing);
+		bench::report(std::format("{} boxes, batched boxes_in_frustum", count), batched_timing);
+		bench::report_speedup("speedup", scalar_timing, batched_timing);
+
+		if (scalar_visibility != batched_visibility)
+			bench::report_mismatch(
+				std::format("{} boxes, boxes_in_frustum differs from box_in_frustum", count)
+			);
+	}
+}
+
+// Flat culling as done before the hierarchy, every box is tested
+static void flat_query(
+	const graphics::BoxArray& boxes,
+	std::span<const glm::vec4> planes,
+	std::vector<uint8_t>& visibility,
+	std::pmr::vector<uint32_t>& visible
+) noexcept
+{
+	visible.clear();
+	graphics::boxes_in_frustum(boxes, planes, visibility);
+	for (const auto idx : std::views::iota(0zu, boxes.size()))
+		if (graphics::is_visible(visibility, idx)) visible.push_back(static_cast<uint32_t>(idx));
+}
+
+BENCHMARK(bvh_query)
+{
+	const auto planes = test_frustum_planes();
+
+	for (const auto count : {1000zu, 10000zu, 100000zu})
+	{
+		std::mt19937 rng(static_cast<uint32_t>(count));
+		auto boxes = make_test_boxes(count, rng);
+		auto bvh = graphics::Bvh::build(boxes);
+
+		std::vector<uint8_t> visibility(graphics::visibility_mask_size(count));
+		std::pmr::vector<uint32_t> flat_visible, bvh_visible;
+
+		const auto flat_timing = bench::measure([&] { flat_query(boxes, planes, visibility, flat_visible); });
+		const auto bvh_timing = bench::measure([&] {
+			bvh_visible.clear();
+			bvh.query(planes, bvh_visible);
+		});
+
+		// 5% of the boxes move each frame, as animated drawcalls do
+		std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(count - 1));
+		std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+		const auto refit_timing = bench::measure([&] {
+			for (const auto _ : std::views::iota(0zu, count / 20))
+			{
+				const auto idx = pick(rng);
+				const glm::vec3 offset(jitter(rng), jitter(rng), jitter(rng));
+				const auto box_min = boxes.get_min(idx) + offset, box_max = boxes.get_max(idx) + offset;
+				boxes.set(idx, box_min, box_max);
+				bvh.set_box(idx, box_min, box_max);
+			}
+			bvh.refit();
+		});
+
+		bench::report(std::format("{} boxes, flat boxes_in_frustum", count), flat_timing);
+		bench::report(std::format("{} boxes, Bvh::query", count), bvh_timing);
+		bench::report_speedup("speedup", flat_timing, bvh_timing);
+		bench::report(std::format("{} boxes, move 5% and refit", count), refit_timing);
+
+		// Same visible set after the refits
+		flat_query(boxes, planes, visibility, flat_visible);
+		bvh_visible.clear();
+		bvh.query(planes, bvh_visible);
+		std::ranges::sort(bvh_visible);
+
+		if (flat_visible != bvh_visible)
+			bench::report_mismatch(std::format("{} boxes, Bvh::query differs from boxes_in_frustum", count));
+	}
+}
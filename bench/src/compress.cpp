@@ -0,0 +1,88 @@
+#include "bench/measure.hpp"
+#include "image/compress.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+#include <ranges>
+
+using RgbaImage = image::Image<image::Precision::U8, image::Format::RGBA>;
+using CompressFunction = std::expected<image::BCImage, util::Error> (*)(const RgbaImage&) noexcept;
+
+// Smooth gradients with noise on top, closer to real textures than pure noise or flat color
+static RgbaImage make_test_image(uint32_t size) noexcept
+{
+	std::mt19937 rng(size);
+	std::uniform_int_distribution<int> noise(-24, 24);
+
+	RgbaImage result{.size = {size, size}, .pixels = std::vector<glm::u8vec4>(size_t(size) * size)};
+	const auto coords = std::views::cartesian_product(std::views::iota(0u, size), std::views::iota(0u, size));
+	for (const auto [y, x] : coords)
+	{
+		const float u = float(x) / size, v = float(y) / size;
+		const glm::vec4 base(
+			0.5f + 0.5f * std::sin(u * 12.0f),
+			0.5f + 0.5f * std::cos(v * 9.0f),
+			u * v,
+			0.5f + 0.5f * std::sin((u + v) * 20.0f)
+		);
+		const auto channel = [&](float value) {
+			return static_cast<uint8_t>(std::clamp(int(value * 255.0f) + noise(rng), 0, 255));
+		};
+		result[x, y] = {channel(base.r), channel(base.g), channel(base.b), channel(base.a)};
+	}
+
+	return result;
+}
+
+static bool same_blocks(const image::BCImage& a, const image::BCImage& b) noexcept
+{
+	return a.size == b.size
+		&& std::ranges::equal(a.pixels, b.pixels, [](const auto& block_a, const auto& block_b) {
+			   return block_a.block == block_b.block;
+		   });
+}
+
+// Serial against parallel compression of the same images, which must give identical blocks
+static void compare_compression(
+	std::string_view format,
+	CompressFunction serial,
+	CompressFunction parallel
+) noexcept
+{
+	for (const auto size : {256u, 1024u, 2048u})
+	{
+		const auto test_image = make_test_image(size);
+		const auto label = std::format("{} {}x{}", format, size, size);
+
+		// Large BC7 images take seconds per run, so a few runs suffice
+		const auto run_serial = [&] { return serial(test_image); };
+		const auto run_parallel = [&] { return parallel(test_image); };
+		const auto serial_timing = bench::measure(run_serial, std::chrono::seconds(1), 3);
+		const auto parallel_timing = bench::measure(run_parallel, std::chrono::seconds(1), 3);
+
+		bench::report(label + " serial", serial_timing);
+		bench::report(label + " parallel", parallel_timing);
+		bench::report_speedup("speedup", serial_timing, parallel_timing);
+
+		const auto serial_result = serial(test_image), parallel_result = parallel(test_image);
+		if (!serial_result || !parallel_result || !same_blocks(*serial_result, *parallel_result))
+			bench::report_mismatch(label + " parallel blocks differ from serial");
+	}
+}
+
+BENCHMARK(compress_bc3)
+{
+	compare_compression("BC3", image::compress_to_bc3, image::compress_to_bc3_parallel);
+}
+
+BENCHMARK(compress_bc5)
+{
+	compare_compression("BC5", image::compress_to_bc5, image::compress_to_bc5_parallel);
+}
+
+BENCHMARK(compress_bc7)
+{
+	compare_compression("BC7", image::compress_to_bc7, image::compress_to_bc7_parallel);
+}
@@ -0,0 +1,87 @@
+#include "bench/measure.hpp"
+
+#include <cstdlib>
+#include <print>
+#include <span>
+
+namespace bench
+{
+	static Options parsed_options;
+	static size_t failures = 0;
+
+	std::vector<Case>& cases() noexcept
+	{
+		static std::vector<Case> registered_cases;
+		return registered_cases;
+	}
+
+	Registrar::Registrar(std::string_view name, void (*function)()) noexcept
+	{
+		cases().push_back({.name = name, .function = function});
+	}
+
+	const Options& options() noexcept
+	{
+		return parsed_options;
+	}
+
+	void report(std::string_view label, const Timing& timing) noexcept
+	{
+		std::println(
+			"  {:<44} median {:>11.2f} us   min {:>11.2f} us   ({} runs)",
+			label,
+			timing.median_us,
+			timing.min_us,
+			timing.run_count
+		);
+	}
+
+	void report_speedup(std::string_view label, const Timing& baseline, const Timing& timing) noexcept
+	{
+		std::println("  {:<44} {:.2f}x", label, baseline.median_us / timing.median_us);
+	}
+
+	void report_mismatch(std::string_view what) noexcept
+	{
+		failures++;
+		std::println(stderr, "  mismatch: {}", what);
+	}
+
+	void report_error(std::string_view what) noexcept
+	{
+		failures++;
+		std::println(stderr, "  error: {}", what);
+	}
+}
+
+// Usage: benchmark [--scene <baked scene>] [name filter], runs the benchmarks whose name contains the filter
+int main(int argc, const char* argv[])
+{
+	const auto args = std::span(argv, argc).subspan(1);
+	std::string_view filter;
+
+	for (size_t idx = 0; idx < args.size(); idx++)
+	{
+		const std::string_view arg = args[idx];
+		if (arg == "--scene" && idx + 1 < args.size())
+			bench::parsed_options.scene = args[++idx];
+		else
+			filter = arg;
+	}
+
+	for (const auto& [name, function] : bench::cases())
+	{
+		if (!name.contains(filter)) continue;
+
+		std::println("[{}]", name);
+		function();
+	}
+
+	if (bench::failures != 0)
+	{
+		std::println(stderr, "{} benchmark failures", bench::failures);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+#include "bench/measure.hpp"
+#include "util/name-index.hpp"
+
+#include <algorithm>
+#include <format>
+#include <random>
+#include <ranges>
+#include <string>
+
+// Indices with the given name by scanning every name, as node lookups did before the index
+static std::vector<uint32_t> linear_find(std::span<const std::string> names, std::string_view name) noexcept
+{
+	return std::views::iota(0u, static_cast<uint32_t>(names.size()))
+		| std::views::filter([&](uint32_t idx) { return names[idx] == name; })
+		| std::ranges::to<std::vector>();
+}
+
+BENCHMARK(name_index_find)
+{
+	// Node names as exported by modelling tools, some shared by several nodes
+	constexpr size_t node_count = 50000, distinct_count = 30000, query_count = 2000;
+
+	std::mt19937 rng(0x5eed);
+	std::uniform_int_distribution<size_t> pick_name(0, distinct_count - 1), pick_node(0, node_count - 1);
+
+	const auto names = std::views::iota(0zu, node_count)
+		| std::views::transform([&](size_t idx) {
+			  const auto name_idx = idx < distinct_count ? idx : pick_name(rng);
+			  return std::format("Armature.{:03}|Mesh_{}", name_idx % 7, name_idx);
+		  })
+		| std::ranges::to<std::vector>();
+
+	// Mostly existing names, one in ten missing
+	const auto queries = std::views::iota(0zu, query_count)
+		| std::views::transform([&](size_t idx) {
+			  return idx % 10 == 0 ? std::format("Missing_{}", idx) : names[pick_node(rng)];
+		  })
+		| std::ranges::to<std::vector>();
+
+	const auto make_entries = [&names] {
+		return std::views::zip(names, std::views::iota(0u))
+			| std::views::transform([](const auto& pair) {
+				   const auto& [name, idx] = pair;
+				   return std::pair<std::string_view, uint32_t>(name, idx);
+			   })
+			| std::ranges::to<std::vector>();
+	};
+
+	const auto build_timing = bench::measure([&] { return util::NameIndex(make_entries()); });
+	const util::NameIndex index(make_entries());
+
+	size_t match_count = 0;
+	const auto index_timing = bench::measure([&] {
+		for (const auto& query : queries) match_count += index.find(query).size();
+	});
+	const auto linear_timing = bench::measure([&] {
+		for (const auto& query : queries) match_count += linear_find(names, query).size();
+	});
+
+	bench::report(std::format("build over {} names", node_count), build_timing);
+	bench::report(std::format("{} lookups, linear scan", query_count), linear_timing);
+	bench::report(std::format("{} lookups, NameIndex::find", query_count), index_timing);
+	bench::report_speedup("speedup", linear_timing, index_timing);
+
+	const bool all_match = std::ranges::all_of(queries, [&](const std::string& query) {
+		return std::ranges::equal(index.find(query), linear_find(names, query));
+	});
+	if (!all_match || match_count == 0)
+		bench::report_mismatch("NameIndex::find differs from the linear scan");
+}
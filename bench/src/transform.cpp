@@ -0,0 +1,122 @@
+#include "bench/measure.hpp"
+#include "gltf/model.hpp"
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_init.h>
+#include <array>
+#include <format>
+#include <glm/gtc/matrix_transform.hpp>
+#include <memory_resource>
+#include <print>
+#include <ranges>
+#include <vector>
+
+using AnimationKeys = std::span<const gltf::AnimationKey>;
+
+// World bounds of every drawcall and world matrix of every node in one frame, copied out of the arena
+struct FrameResult
+{
+	std::vector<std::pair<glm::vec3, glm::vec3>> drawcall_bounds;
+	std::vector<glm::mat4> node_matrices;
+
+	bool operator==(const FrameResult&) const noexcept = default;
+};
+
+static void run_drawdata_benchmarks(gltf::Model& model) noexcept
+{
+	std::pmr::monotonic_buffer_resource arena;
+
+	const auto frame = [&model, &arena](const glm::mat4& transform, AnimationKeys keys) {
+		arena.release();
+		return model.generate_drawdata(transform, keys, {}, {}, &arena).primitive_drawcalls.size();
+	};
+
+	const auto frame_result = [&model, &arena](const glm::mat4& transform, AnimationKeys keys) {
+		arena.release();
+		const auto drawdata = model.generate_drawdata(transform, keys, {}, {}, &arena);
+		const auto bounds = [](const gltf::PrimitiveDrawcall& drawcall) {
+			return std::make_pair(drawcall.world_position_min, drawcall.world_position_max);
+		};
+
+		return FrameResult{
+			.drawcall_bounds = drawdata.primitive_drawcalls
+				| std::views::transform(bounds)
+				| std::ranges::to<std::vector>(),
+			.node_matrices = std::vector(std::from_range, drawdata.node_matrices),
+		};
+	};
+
+	// A moving model transform marks every node dirty, which is the cost of a full recompute
+	float offset = 0.0f;
+	const auto full_timing = bench::measure([&] {
+		offset += 0.01f;
+		return frame(glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f, 0.0f)), {});
+	});
+	bench::report("moving root, every node recomputed", full_timing);
+
+	// Nothing changes between frames, the cached drawcalls are reused as a whole
+	const auto static_timing = bench::measure([&] { return frame(glm::mat4(1.0f), {}); });
+	bench::report("static pose", static_timing);
+	bench::report_speedup("speedup over full recompute", full_timing, static_timing);
+
+	if (model.get_animations().empty())
+	{
+		std::println("  scene has no animations, animated benchmark skipped");
+		return;
+	}
+
+	// Animation 0 at 60 fps, only animated subtrees are recomputed
+	float time = 0.0f;
+	const auto animated_timing = bench::measure([&] {
+		time += 1.0f / 60.0f;
+		const std::array keys = {gltf::AnimationKey{.animation = 0u, .time = time}};
+		return frame(glm::mat4(1.0f), keys);
+	});
+	bench::report("animation 0 playing", animated_timing);
+	bench::report_speedup("speedup over full recompute", full_timing, animated_timing);
+
+	// The incremental result must match a full recompute of the same pose
+	const std::array keys = {gltf::AnimationKey{.animation = 0u, .time = time + 0.5f}};
+	const auto incremental = frame_result(glm::mat4(1.0f), keys);
+	frame(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f)), keys);
+	const auto recomputed = frame_result(glm::mat4(1.0f), keys);
+
+	if (incremental != recomputed) bench::report_mismatch("incremental drawdata differs from full recompute");
+}
+
+// Needs a baked scene and a GPU device to upload it to, set `SDL_VIDEODRIVER=offscreen` without a display
+BENCHMARK(model_generate_drawdata)
+{
+	const auto& scene = bench::options().scene;
+	if (!scene.has_value())
+	{
+		std::println("  skipped, pass a baked scene with --scene <path>");
+		return;
+	}
+
+	if (!SDL_Init(SDL_INIT_VIDEO))
+	{
+		bench::report_error(std::format("initialize SDL failed: {}", SDL_GetError()));
+		return;
+	}
+
+	SDL_GPUDevice* const device = SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV, false, "vulkan");
+	if (device == nullptr)
+	{
+		bench::report_error(std::format("create GPU device failed: {}", SDL_GetError()));
+		SDL_Quit();
+		return;
+	}
+
+	// The model releases its GPU resources before the device goes away
+	{
+		auto model = gltf::Model::from_baked(device, *scene, {}, {});
+		if (model)
+			run_drawdata_benchmarks(*model);
+		else
+			bench::report_error(std::format("load baked scene failed: {}", model.error()->front().message));
+	}
+
+	SDL_DestroyGPUDevice(device);
+	SDL_Quit();
+}
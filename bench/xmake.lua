@@ -0,0 +1,11 @@
+-- Library benchmarks, run with `xmake run benchmark` in release mode
+target("benchmark")
+	set_kind("binary")
+	set_languages("c++23")
+	set_group("bench")
+	set_default(false)
+
+	add_includedirs("include")
+	add_files("src/**.cpp")
+
+	add_deps("lib::gltf", "lib::image.compress", "lib::graphics.geometry", "lib::util")
@@ -1,14 +1,22 @@
 ///
 /// @file accessor.hpp
-/// @brief Provides a function to extract typed data from a glTF accessor
+/// @brief Provides typed views and extraction of data from a glTF accessor
 ///
 
 #pragma once
 
 #include "util/error.hpp"
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <format>
 #include <glm/glm.hpp>
+#include <iterator>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <tiny_gltf.h>
 #include <vector>
 
@@ -153,16 +161,147 @@ namespace gltf
 	}
 
 	///
-	/// @brief Extract typed data from an accessor
+	/// @brief Strided, read-only view over the elements of a glTF accessor
+	/// @details Elements are read with `memcpy`, so neither the stride nor the alignment of the underlying
+	/// buffer needs to match `T`. When the data is tightly packed and aligned, `contiguous` exposes it as a
+	/// plain span instead.
+	/// @warning The view points into the buffers of the tinygltf model, which must outlive it
 	///
-	/// @tparam T Type to extract
+	/// @tparam T Element type
+	///
+	template <typename T>
+		requires(detail::AccessTypeTrait<T>::available)
+	class AccessorView : public std::ranges::view_interface<AccessorView<T>>
+	{
+		const std::byte* data = nullptr;
+		size_t count = 0;
+		size_t stride = sizeof(T);
+
+	  public:
+
+		class Iterator
+		{
+			const std::byte* ptr = nullptr;
+			size_t stride = sizeof(T);
+
+		  public:
+
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::random_access_iterator_tag;
+
+			Iterator() = default;
+
+			Iterator(const std::byte* ptr, size_t stride) noexcept :
+				ptr(ptr),
+				stride(stride)
+			{}
+
+			T operator*() const noexcept
+			{
+				T value;
+				std::memcpy(&value, ptr, sizeof(T));
+				return value;
+			}
+
+			T operator[](difference_type offset) const noexcept { return *(*this + offset); }
+
+			Iterator& operator+=(difference_type offset) noexcept
+			{
+				ptr += offset * static_cast<difference_type>(stride);
+				return *this;
+			}
+
+			Iterator& operator-=(difference_type offset) noexcept { return *this += -offset; }
+			Iterator& operator++() noexcept { return *this += 1; }
+			Iterator& operator--() noexcept { return *this -= 1; }
+
+			Iterator operator++(int) noexcept
+			{
+				const auto copy = *this;
+				++*this;
+				return copy;
+			}
+
+			Iterator operator--(int) noexcept
+			{
+				const auto copy = *this;
+				--*this;
+				return copy;
+			}
+
+			friend Iterator operator+(Iterator it, difference_type offset) noexcept { return it += offset; }
+			friend Iterator operator+(difference_type offset, Iterator it) noexcept { return it += offset; }
+			friend Iterator operator-(Iterator it, difference_type offset) noexcept { return it -= offset; }
+
+			friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept
+			{
+				return (lhs.ptr - rhs.ptr) / static_cast<difference_type>(lhs.stride);
+			}
+
+			bool operator==(const Iterator& other) const noexcept { return ptr == other.ptr; }
+			auto operator<=>(const Iterator& other) const noexcept { return ptr <=> other.ptr; }
+		};
+
+		AccessorView() = default;
+
+		AccessorView(const std::byte* data, size_t count, size_t stride) noexcept :
+			data(data),
+			count(count),
+			stride(stride)
+		{}
+
+		Iterator begin() const noexcept { return {data, stride}; }
+		Iterator end() const noexcept { return {data + count * stride, stride}; }
+		size_t size() const noexcept { return count; }
+
+		T operator[](size_t idx) const noexcept
+		{
+			assert(idx < count);
+			return begin()[static_cast<std::ptrdiff_t>(idx)];
+		}
+
+		// Get a view of the first `new_count` elements
+		AccessorView first(size_t new_count) const noexcept
+		{
+			assert(new_count <= count);
+			return {data, new_count, stride};
+		}
+
+		///
+		/// @brief Get the elements as a span, if they are tightly packed and aligned for `T`
+		///
+		/// @return Span over the elements, or `std::nullopt` if the data is interleaved or misaligned
+		///
+		std::optional<std::span<const T>> contiguous() const noexcept
+		{
+			if (stride != sizeof(T)) return std::nullopt;
+			if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) return std::nullopt;
+
+			return std::span(reinterpret_cast<const T*>(data), count);
+		}
+
+		// Copy the elements into a vector
+		std::vector<T> to_vector() const noexcept
+		{
+			if (const auto packed = contiguous(); packed.has_value())
+				return std::vector<T>(packed->begin(), packed->end());
+
+			return std::vector<T>(std::from_range, *this);
+		}
+	};
+
+	///
+	/// @brief Get a typed view of the data of an accessor, without copying
+	///
+	/// @tparam T Element type
 	/// @param model Tinygltf model
 	/// @param accessor Accessor
-	/// @return Extract result, or error on failure
+	/// @return View of the accessor data, or error on failure
 	///
 	template <typename T>
 		requires(detail::AccessTypeTrait<T>::available)
-	std::expected<std::vector<T>, util::Error> extract_from_accessor(
+	std::expected<AccessorView<T>, util::Error> view_accessor(
 		const tinygltf::Model& model,
 		const tinygltf::Accessor& accessor
 	) noexcept
@@ -203,14 +342,32 @@ namespace gltf
 			return util::Error("Accessor byte range out of bounds of buffer data");
 		if (elem_size > byte_stride) return util::Error("Accessor element size greater than byte stride");
 
-		/* Extraction */
+		return AccessorView<T>(
+			reinterpret_cast<const std::byte*>(buffer.data.data()) + byte_offset,
+			elem_count,
+			byte_stride
+		);
+	}
 
-		std::vector<T> data(elem_count);
-		for (const auto idx : std::views::iota(0u, elem_count))
-			std::memcpy(&data[idx], &buffer.data[byte_offset + idx * byte_stride], elem_size);
+	///
+	/// @brief Extract typed data from an accessor
+	/// @note Prefer `view_accessor` when the data is only read once
+	///
+	/// @tparam T Type to extract
+	/// @param model Tinygltf model
+	/// @param accessor Accessor
+	/// @return Extract result, or error on failure
+	///
+	template <typename T>
+		requires(detail::AccessTypeTrait<T>::available)
+	std::expected<std::vector<T>, util::Error> extract_from_accessor(
+		const tinygltf::Model& model,
+		const tinygltf::Accessor& accessor
+	) noexcept
+	{
+		const auto view = view_accessor<T>(model, accessor);
+		if (!view) return view.error();
 
-		return std::move(data);
+		return view->to_vector();
 	}
-
-	/* Template Instantiation */
 }
@@ -1,11 +1,10 @@
 #pragma once
 
-#include "detail/animation/channel-def.hpp"
+#include "detail/animation/channels.hpp"
 #include "gltf/node.hpp"
 #include "util/error.hpp"
 
 #include <expected>
-#include <memory>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -16,6 +15,7 @@ namespace gltf
 	{
 		std::variant<uint32_t, std::string> animation;
 		float time;
+		float weight = 1.0f;  // Blend weight over preceding keys, 1 replaces them, see `Animation::blend`
 	};
 
 	class Animation
@@ -34,6 +34,21 @@ namespace gltf
 			const tinygltf::Animation& animation
 		) noexcept;
 
+		///
+		/// @brief Read an animation from a baked scene, see `bake`
+		///
+		/// @param reader Baked data reader
+		/// @param node_count Number of nodes in the model, for validating channel targets
+		/// @return Read animation or error
+		///
+		static std::expected<Animation, util::Error> from_baked(
+			detail::bake::Reader& reader,
+			size_t node_count
+		) noexcept;
+
+		// Serialize into a baked scene
+		void bake(detail::bake::Writer& writer) const noexcept;
+
 		///
 		/// @brief Apply the animation at the given time to node transform overrides
 		///
@@ -42,17 +57,54 @@ namespace gltf
 		///
 		void apply(std::span<Node::TransformOverride> overrides, float time) const noexcept;
 
+		///
+		/// @brief Apply the animation at the given time, resuming keyframe search from per-channel cursors
+		/// @details Cheaper than `apply` without cursors when time advances steadily across calls, such as
+		/// during playback
+		///
+		/// @param overrides Node transform overrides
+		/// @param time Absolute timestamp
+		/// @param cursors Keyframe cursors, one per channel (see `channel_count`), initially 0
+		///
+		void apply(
+			std::span<Node::TransformOverride> overrides,
+			float time,
+			std::span<uint32_t> cursors
+		) const noexcept;
+
+		///
+		/// @brief Blend the animation at the given time into node transform overrides
+		/// @details Each animated property becomes `mix(current, sampled, weight)`, where `current` is the
+		/// existing override, or the node's own transform if not overridden yet. Rotations use slerp.
+		///
+		/// @param overrides Node transform overrides
+		/// @param nodes Nodes of the model, providing the transforms to blend from
+		/// @param time Absolute timestamp
+		/// @param weight Blend weight in [0, 1]
+		/// @param cursors Keyframe cursors, one per channel (see `channel_count`), initially 0
+		///
+		void blend(
+			std::span<Node::TransformOverride> overrides,
+			std::span<const Node> nodes,
+			float time,
+			float weight,
+			std::span<uint32_t> cursors
+		) const noexcept;
+
+		// Number of channels, i.e. the number of cursors needed by `apply`
+		size_t channel_count() const noexcept { return channels.size(); }
+
+		// Time range covered by keyframes as (start, end), outside of which the pose is held
+		std::pair<float, float> time_range() const noexcept { return channels.time_range(); }
+
 		// Name of the animation, can be none
 		std::optional<std::string> name;
 
 	  private:
 
-		std::vector<std::unique_ptr<detail::animation::Channel>> channels;
+		detail::animation::Channels channels;
 
-		Animation(
-			std::optional<std::string> name,
-			std::vector<std::unique_ptr<detail::animation::Channel>> channels
-		) :
+		Animation(std::optional<std::string> name, detail::animation::Channels channels) :
 			name(std::move(name)),
 			channels(std::move(channels))
 		{}
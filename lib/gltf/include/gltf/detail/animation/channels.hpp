@@ -1,55 +1,107 @@
 #pragma once
 
-#include "channel-def.hpp"
+#include "gltf/detail/bake/stream.hpp"
+#include "gltf/node.hpp"
 #include "sampler.hpp"
+#include "util/inline.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
 
 namespace gltf::detail::animation
 {
-	class TranslationChannel : public Channel
+	// Target path of a channel, tagging channels in baked scenes
+	enum class ChannelPath : uint8_t
+	{
+		Translation,
+		Rotation,
+		Scale
+	};
+
+	///
+	/// @brief Channels of one target path, stored as parallel arrays
+	/// @details Channels of the same value type are evaluated in one loop over contiguous samplers, with no
+	/// virtual dispatch per channel
+	///
+	template <typename T>
+	struct ChannelGroup
 	{
-		uint32_t target_node;
-		Sampler<glm::vec3> sampler;
+		std::vector<uint32_t> target_nodes;  // Note: No out-of-bound check for target nodes
+		std::vector<Sampler<T>> samplers;
 
-	  public:
+		// Number of channels
+		size_t size() const noexcept { return samplers.size(); }
 
-		// Note: No out-of-bound check for `target_node`
-		TranslationChannel(uint32_t target_node, Sampler<glm::vec3> sampler) :
-			target_node(target_node),
-			sampler(std::move(sampler))
-		{}
+		// Union of the time ranges of all channels, empty (start > end) if there are none
+		std::pair<float, float> time_range() const noexcept
+		{
+			std::pair range(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest());
 
-		void apply(std::span<Node::TransformOverride> overrides, float time) const noexcept override;
-	};
+			for (const auto& sampler : samplers)
+			{
+				const auto [start, end] = sampler.time_range();
+				range = {std::min(range.first, start), std::max(range.second, end)};
+			}
 
-	class RotationChannel : public Channel
-	{
-		uint32_t target_node;
-		Sampler<glm::quat> sampler;
+			return range;
+		}
 
-	  public:
+		void push_back(uint32_t target_node, Sampler<T> sampler) noexcept
+		{
+			target_nodes.push_back(target_node);
+			samplers.push_back(std::move(sampler));
+		}
 
-		// Note: No out-of-bound check for `target_node`
-		RotationChannel(uint32_t target_node, Sampler<glm::quat> sampler) :
-			target_node(target_node),
-			sampler(std::move(sampler))
-		{}
+		///
+		/// @brief Sample every channel at the given time
+		///
+		/// @param time Absolute timestamp
+		/// @param cursors Keyframe cursors, one per channel, see `Sampler::sample`
+		/// @param write Receives each sampled value, as `write(target_node, value)`
+		///
+		template <typename F>
+		FORCE_INLINE void evaluate(float time, std::span<uint32_t> cursors, const F& write) const noexcept
+		{
+			for (const auto [target_node, sampler, cursor] : std::views::zip(target_nodes, samplers, cursors))
+				write(target_node, sampler.sample(time, cursor));
+		}
 
-		void apply(std::span<Node::TransformOverride> overrides, float time) const noexcept override;
+		// Serialize every channel into a baked scene, as `path` tag, target node and sampler
+		void bake(detail::bake::Writer& writer, ChannelPath path) const noexcept
+		{
+			for (const auto [target_node, sampler] : std::views::zip(target_nodes, samplers))
+			{
+				writer.write(path);
+				writer.write<uint32_t>(target_node);
+				sampler.bake(writer);
+			}
+		}
 	};
 
-	class ScaleChannel : public Channel
+	// All channels of an animation, grouped by target path
+	struct Channels
 	{
-		uint32_t target_node;
-		Sampler<glm::vec3> sampler;
+		ChannelGroup<glm::vec3> translation;
+		ChannelGroup<glm::quat> rotation;
+		ChannelGroup<glm::vec3> scale;
 
-	  public:
+		// Total number of channels
+		size_t size() const noexcept { return translation.size() + rotation.size() + scale.size(); }
 
-		// Note: No out-of-bound check for `target_node`
-		ScaleChannel(uint32_t target_node, Sampler<glm::vec3> sampler) :
-			target_node(target_node),
-			sampler(std::move(sampler))
-		{}
+		// Union of the time ranges of all channels, empty (start > end) if there are none
+		std::pair<float, float> time_range() const noexcept
+		{
+			const auto [translation_start, translation_end] = translation.time_range();
+			const auto [rotation_start, rotation_end] = rotation.time_range();
+			const auto [scale_start, scale_end] = scale.time_range();
 
-		void apply(std::span<Node::TransformOverride> overrides, float time) const noexcept override;
+			return {
+				std::min({translation_start, rotation_start, scale_start}),
+				std::max({translation_end, rotation_end, scale_end})
+			};
+		}
 	};
-}
\ No newline at end of file
+}
@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <tiny_gltf.h>
 #include <variant>
 #include <vector>
 
 #include "gltf/accessor.hpp"
+#include "gltf/detail/bake/stream.hpp"
 #include "interpolation.hpp"
 #include "util/error.hpp"
 #include "util/inline.hpp"
@@ -61,6 +63,10 @@ namespace gltf::detail::animation
 			assert(interpolation == Interpolation::Cubic);
 		}
 
+		// Sample with `find_upper` locating the first keyframe later than `time` in a keyframe span
+		template <typename F>
+		T sample_with(float time, const F& find_upper) const noexcept;
+
 	  public:
 
 		static std::expected<Sampler<T>, util::Error> from_tinygltf(
@@ -68,16 +74,90 @@ namespace gltf::detail::animation
 			const tinygltf::AnimationSampler& sampler
 		) noexcept;
 
+		///
+		/// @brief Read a sampler from a baked scene, see `bake`
+		///
+		/// @param reader Baked data reader
+		/// @return Sampler, or error if the data is malformed
+		///
+		static std::expected<Sampler<T>, util::Error> from_baked(detail::bake::Reader& reader) noexcept;
+
+		// Serialize into a baked scene, as interpolation, timestamps and values
+		void bake(detail::bake::Writer& writer) const noexcept;
+
+		// Timestamps of the first and last keyframe, sampling clamps to this range
+		std::pair<float, float> time_range() const noexcept
+		{
+			return std::visit(
+				[](const auto& keyframe_vec) {
+					return std::make_pair(keyframe_vec.front().first, keyframe_vec.back().first);
+				},
+				keyframes
+			);
+		}
+
+		// Sample at `time`, searching the keyframes from scratch
 		T operator[](float time) const noexcept;
 
+		///
+		/// @brief Sample at `time`, resuming the keyframe search from a cursor
+		/// @note Same result as `operator[]`, but O(1) amortised when time advances steadily
+		///
+		/// @param time Absolute timestamp
+		/// @param cursor Cursor owned by the caller, kept between calls and initially 0
+		/// @return Sampled value
+		///
+		T sample(float time, uint32_t& cursor) const noexcept;
+
 		Sampler(const Sampler&) = delete;
 		Sampler(Sampler&&) = default;
 		Sampler& operator=(const Sampler&) = delete;
 		Sampler& operator=(Sampler&&) = default;
 	};
 
+	///
+	/// @brief Find the first keyframe later than `time`, same result as `std::ranges::upper_bound`
+	/// @details Starts from the result of the previous lookup kept in `cursor`. As playback time only moves
+	/// forward, this is usually a step or two; seeking backward or far ahead falls back to binary search.
+	///
+	/// @param keyframes Keyframes sorted by time
+	/// @param time Absolute timestamp
+	/// @param cursor Index found by the previous lookup, updated with the new one
+	/// @return Index of the first keyframe later than `time`, or the keyframe count if none
+	///
+	template <typename K>
+	FORCE_INLINE inline size_t find_upper_keyframe(
+		std::span<const std::pair<float, K>> keyframes,
+		float time,
+		uint32_t& cursor
+	) noexcept
+	{
+		constexpr size_t max_steps = 4;
+		constexpr auto time_of = &std::pair<float, K>::first;
+
+		size_t upper = cursor;
+
+		if (upper <= keyframes.size() && (upper == 0 || keyframes[upper - 1].first <= time))
+		{
+			const auto limit = std::min(upper + max_steps, keyframes.size());
+			while (upper < limit && keyframes[upper].first <= time) upper++;
+
+			if (upper == limit && upper < keyframes.size() && keyframes[upper].first <= time)
+			{
+				const auto rest = keyframes.subspan(upper);
+				upper += std::ranges::upper_bound(rest, time, {}, time_of) - rest.begin();
+			}
+		}
+		else
+			upper = std::ranges::upper_bound(keyframes, time, {}, time_of) - keyframes.begin();
+
+		cursor = static_cast<uint32_t>(upper);
+		return upper;
+	}
+
 	template <typename T>
-	FORCE_INLINE inline T Sampler<T>::operator[](float time) const noexcept
+	template <typename F>
+	FORCE_INLINE inline T Sampler<T>::sample_with(float time, const F& find_upper) const noexcept
 	{
 		switch (interpolation)
 		{
@@ -86,9 +166,9 @@ namespace gltf::detail::animation
 		{
 			using Vec_type = std::vector<std::pair<float, T>>;
 			assert((std::holds_alternative<Vec_type>(keyframes)));
-			const auto& keyframe_vec = std::get<Vec_type>(keyframes);
+			const std::span<const std::pair<float, T>> keyframe_vec = std::get<Vec_type>(keyframes);
 
-			const auto upper = std::ranges::upper_bound(keyframe_vec, time, {}, &std::pair<float, T>::first);
+			const auto upper = keyframe_vec.begin() + find_upper(keyframe_vec);
 			if (upper == keyframe_vec.begin()) return upper->second;
 			if (upper == keyframe_vec.end()) return std::prev(upper)->second;
 
@@ -108,14 +188,10 @@ namespace gltf::detail::animation
 		{
 			using Vec_type = std::vector<std::pair<float, detail::animation::CubicKeyFrame<T>>>;
 			assert((std::holds_alternative<Vec_type>(keyframes)));
-			const auto& keyframe_vec = std::get<Vec_type>(keyframes);
+			const std::span<const std::pair<float, detail::animation::CubicKeyFrame<T>>> keyframe_vec =
+				std::get<Vec_type>(keyframes);
 
-			const auto upper = std::ranges::upper_bound(
-				keyframe_vec,
-				time,
-				{},
-				&std::pair<float, detail::animation::CubicKeyFrame<T>>::first
-			);
+			const auto upper = keyframe_vec.begin() + find_upper(keyframe_vec);
 			if (upper == keyframe_vec.begin()) return upper->second.value;
 			if (upper == keyframe_vec.end()) return std::prev(upper)->second.value;
 
@@ -134,6 +210,23 @@ namespace gltf::detail::animation
 		}
 	}
 
+	template <typename T>
+	FORCE_INLINE inline T Sampler<T>::operator[](float time) const noexcept
+	{
+		return sample_with(time, [time]<typename K>(std::span<const std::pair<float, K>> keyframe_vec) {
+			return std::ranges::upper_bound(keyframe_vec, time, {}, &std::pair<float, K>::first)
+				- keyframe_vec.begin();
+		});
+	}
+
+	template <typename T>
+	FORCE_INLINE inline T Sampler<T>::sample(float time, uint32_t& cursor) const noexcept
+	{
+		return sample_with(time, [time, &cursor](const auto& keyframe_vec) {
+			return find_upper_keyframe(keyframe_vec, time, cursor);
+		});
+	}
+
 	template <typename T>
 	std::expected<Sampler<T>, util::Error> Sampler<T>::from_tinygltf(
 		const tinygltf::Model& model,
@@ -157,13 +250,13 @@ namespace gltf::detail::animation
 
 		/* Extract Accessor Data */
 
-		auto timestamps_result = extract_from_accessor<float>(model, model.accessors[sampler.input]);
+		const auto timestamps_result = view_accessor<float>(model, model.accessors[sampler.input]);
 		if (!timestamps_result) return timestamps_result.error().forward("Extract timestamps failed");
-		const auto timestamps = std::move(*timestamps_result);
+		const auto timestamps = *timestamps_result;
 
-		auto values_result = extract_from_accessor<T>(model, model.accessors[sampler.output]);
+		const auto values_result = view_accessor<T>(model, model.accessors[sampler.output]);
 		if (!values_result) return values_result.error().forward("Extract values failed");
-		const auto values = std::move(*values_result);
+		const auto values = *values_result;
 
 		/* Validate Accessor Data */
 
@@ -231,4 +324,63 @@ namespace gltf::detail::animation
 			std::unreachable();
 		}
 	}
+
+	template <typename T>
+	void Sampler<T>::bake(detail::bake::Writer& writer) const noexcept
+	{
+		writer.write(interpolation);
+
+		std::visit(
+			[&writer](const auto& keyframe_vec) {
+				writer.write_array(keyframe_vec | std::views::keys | std::ranges::to<std::vector>());
+				writer.write_array(keyframe_vec | std::views::values | std::ranges::to<std::vector>());
+			},
+			keyframes
+		);
+	}
+
+	template <typename T>
+	std::expected<Sampler<T>, util::Error> Sampler<T>::from_baked(detail::bake::Reader& reader) noexcept
+	{
+		const auto interpolation_result = reader.read<Interpolation>();
+		if (!interpolation_result) return interpolation_result.error().forward("Read interpolation failed");
+
+		const auto timestamps = reader.read_array<float>();
+		if (!timestamps) return timestamps.error().forward("Read timestamps failed");
+
+		// Keyframes were validated and sorted when baking, only sizes are checked here
+		const auto zip_keyframes = [&timestamps]<typename V>(std::span<const V> values) {
+			return std::views::zip_transform(
+					   [](float timestamp, const V& value) { return std::make_pair(timestamp, value); },
+					   *timestamps,
+					   values
+				   )
+				| std::ranges::to<std::vector<std::pair<float, V>>>();
+		};
+
+		switch (*interpolation_result)
+		{
+		case Interpolation::Linear:
+		case Interpolation::Step:
+		{
+			const auto values = reader.read_array<T>();
+			if (!values) return values.error().forward("Read values failed");
+			if (timestamps->empty() || timestamps->size() != values->size())
+				return util::Error("Baked animation sampler has mismatched keyframes");
+
+			return Sampler<T>(zip_keyframes(*values), *interpolation_result);
+		}
+		case Interpolation::Cubic:
+		{
+			const auto values = reader.read_array<detail::animation::CubicKeyFrame<T>>();
+			if (!values) return values.error().forward("Read values failed");
+			if (timestamps->size() < 2 || timestamps->size() != values->size())
+				return util::Error("Baked animation sampler has mismatched keyframes");
+
+			return Sampler<T>(zip_keyframes(*values), *interpolation_result);
+		}
+		default:
+			return util::Error("Unknown interpolation in baked animation sampler");
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+///
+/// @file stream.hpp
+/// @brief Provides binary writer and reader for the baked scene format. Arrays are aligned so that the reader
+/// can hand out zero-copy views into a memory-mapped file.
+///
+
+#pragma once
+
+#include "util/as-byte.hpp"
+#include "util/error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gltf::detail::bake
+{
+	// Alignment of array payloads, relative to the start of the data
+	inline constexpr size_t array_alignment = 16;
+
+	// Types that can be written and read as raw bytes
+	template <typename T>
+	concept Bakeable = std::is_trivially_copyable_v<T> && alignof(T) <= array_alignment;
+
+	// Append-only binary writer
+	class Writer
+	{
+		std::vector<std::byte> buffer;
+
+	  public:
+
+		// Write a trivially copyable value
+		template <Bakeable T>
+		void write(const T& value) noexcept
+		{
+			buffer.append_range(util::as_bytes(value));
+		}
+
+		// Write an optional value, as a presence flag followed by the value
+		template <Bakeable T>
+		void write_optional(const std::optional<T>& value) noexcept
+		{
+			write<uint8_t>(value.has_value() ? 1 : 0);
+			if (value.has_value()) write(*value);
+		}
+
+		// Write a contiguous array, as an element count followed by the aligned payload
+		template <std::ranges::contiguous_range R>
+			requires(Bakeable<std::ranges::range_value_t<R>>)
+		void write_array(const R& values) noexcept
+		{
+			write<uint64_t>(std::ranges::size(values));
+			align();
+			buffer.append_range(util::as_bytes(values));
+		}
+
+		// Write a string, as a byte count followed by the characters
+		void write_string(const std::string& str) noexcept;
+
+		// Write an optional string
+		void write_optional_string(const std::optional<std::string>& str) noexcept;
+
+		// Pad the buffer to `array_alignment`
+		void align() noexcept;
+
+		// Get the written bytes
+		std::span<const std::byte> data() const noexcept { return buffer; }
+	};
+
+	///
+	/// @brief Bounds-checked binary reader, counterpart of `Writer`
+	/// @warning The data must be aligned to `array_alignment`, and outlive all views returned by `read_array`
+	///
+	class Reader
+	{
+		std::span<const std::byte> data;
+		size_t offset = 0;
+
+		std::expected<std::span<const std::byte>, util::Error> take(size_t size) noexcept;
+
+	  public:
+
+		explicit Reader(std::span<const std::byte> data) noexcept :
+			data(data)
+		{}
+
+		// Read a trivially copyable value
+		template <Bakeable T>
+		std::expected<T, util::Error> read() noexcept
+		{
+			return take(sizeof(T)).transform([](std::span<const std::byte> bytes) {
+				std::array<std::byte, sizeof(T)> storage;
+				std::ranges::copy(bytes, storage.begin());
+				return std::bit_cast<T>(storage);
+			});
+		}
+
+		// Read an optional value written by `Writer::write_optional`
+		template <Bakeable T>
+		std::expected<std::optional<T>, util::Error> read_optional() noexcept
+		{
+			const auto has_value = read<uint8_t>();
+			if (!has_value) return has_value.error();
+			if (*has_value == 0) return std::nullopt;
+
+			return read<T>().transform([](const T& value) { return std::optional<T>(value); });
+		}
+
+		///
+		/// @brief Read an array written by `Writer::write_array`
+		/// @note No copy is performed, the returned span points into the underlying data
+		///
+		/// @return View of the array, or error if the data is truncated
+		///
+		template <Bakeable T>
+		std::expected<std::span<const T>, util::Error> read_array() noexcept
+		{
+			const auto count = read<uint64_t>();
+			if (!count) return count.error();
+
+			if (const auto align_result = align(); !align_result) return align_result.error();
+			if (*count > (data.size() - offset) / sizeof(T))
+				return util::Error("Baked array exceeds the end of data");
+
+			return take(*count * sizeof(T)).transform([](std::span<const std::byte> bytes) {
+				return std::span(reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T));
+			});
+		}
+
+		// Read a string written by `Writer::write_string`
+		std::expected<std::string, util::Error> read_string() noexcept;
+
+		// Read an optional string written by `Writer::write_optional_string`
+		std::expected<std::optional<std::string>, util::Error> read_optional_string() noexcept;
+
+		// Skip padding up to `array_alignment`
+		std::expected<void, util::Error> align() noexcept;
+	};
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "gltf/accessor.hpp"
 #include "util/error.hpp"
 #include <expected>
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
 #include <optional>
+#include <span>
 #include <tiny_gltf.h>
 #include <vector>
 
@@ -12,10 +14,10 @@ namespace gltf::detail::mesh
 {
 	/* ACQUIRING RAW DATA*/
 	// This part extracts raw attribute data from the glTF primitive accessors, which is possibly still
-	// indexed
+	// indexed. Float attributes are returned as views into the tinygltf buffers, without copying
 
 	// Get raw positions, indexed by original indices
-	std::expected<std::vector<glm::vec3>, util::Error> get_raw_positions(
+	std::expected<AccessorView<glm::vec3>, util::Error> get_raw_positions(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept;
@@ -27,19 +29,19 @@ namespace gltf::detail::mesh
 	) noexcept;
 
 	// Get raw joint weights, indexed by original indices
-	std::expected<std::vector<glm::vec4>, util::Error> get_raw_joint_weights(
+	std::expected<AccessorView<glm::vec4>, util::Error> get_raw_joint_weights(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept;
 
 	// Get raw normals, indexed by original indices
-	std::expected<std::optional<std::vector<glm::vec3>>, util::Error> get_raw_normals(
+	std::expected<std::optional<AccessorView<glm::vec3>>, util::Error> get_raw_normals(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept;
 
 	// Get raw texcoords, indexed by original indices
-	std::expected<std::vector<glm::vec2>, util::Error> get_raw_texcoords(
+	std::expected<AccessorView<glm::vec2>, util::Error> get_raw_texcoords(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive,
 		const std::string& texcoord_name
@@ -149,15 +151,40 @@ namespace gltf::detail::mesh
 	) noexcept;
 
 	///
-	/// @brief Compute tangent data from **UNPACKED** position and texcoord0 data
-	/// @details This function calculates the TANGENT data from **UNPACKED** POSITION and TEXCOORD_0 data
+	/// @brief Compute tangent data from **UNPACKED** position, normal and texcoord0 data
+	/// @details Corners with identical attributes are welded first, then smooth tangents are computed on the
+	/// welded vertices with `compute_smooth_tangents`
 	///
 	/// @param position_vertices POSITION attribute data, must be in triangle list form
+	/// @param normal_vertices NORMAL attribute data, must be in triangle list form
 	/// @param texcoord0_vertices TEXCOORD_0 attribute data, must be in triangle list form
-	/// @return TANGENT attribute data, or error on failure
+	/// @return TANGENT attribute data with the bitangent sign in `w`, or error on failure
 	///
-	std::expected<std::vector<glm::vec3>, util::Error> compute_tangents(
+	std::expected<std::vector<glm::vec4>, util::Error> compute_tangents(
 		const std::vector<glm::vec3>& position_vertices,
+		const std::vector<glm::vec3>& normal_vertices,
 		const std::vector<glm::vec2>& texcoord0_vertices
 	) noexcept;
+
+	///
+	/// @brief Compute smooth per-vertex tangents of an indexed triangle list, following MikkTSpace
+	/// @details Each triangle tangent is projected onto the tangent plane of the vertex normal, and
+	/// accumulated with its corner angle as weight. Triangles with mirrored UV winding are accumulated
+	/// separately, so a vertex on a mirror seam gets two tangents. Corners of degenerate triangles take the
+	/// tangent of their neighbours, or any tangent perpendicular to the normal if there are none. The
+	/// bitangent sign goes into `w` as in glTF TANGENT, -1 for mirrored UV winding and +1 otherwise.
+	///
+	/// @param positions POSITION attribute data
+	/// @param normals NORMAL attribute data
+	/// @param texcoords TEXCOORD_0 attribute data
+	/// @param indices Triangle list indices, must be in range of all attributes
+	/// @return Normalized tangent and bitangent sign of each corner, corners sharing vertex and UV winding
+	/// share the tangent
+	///
+	std::vector<glm::vec4> compute_smooth_tangents(
+		std::span<const glm::vec3> positions,
+		std::span<const glm::vec3> normals,
+		std::span<const glm::vec2> texcoords,
+		std::span<const uint32_t> indices
+	) noexcept;
 }
\ No newline at end of file
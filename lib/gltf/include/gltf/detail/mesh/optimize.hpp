@@ -1,9 +1,16 @@
 #pragma once
 
+#include "gltf/mesh.hpp"
+
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <meshoptimizer.h>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -20,16 +27,23 @@ namespace gltf::detail::mesh
 	///
 	/// @tparam T Type of vertices
 	/// @param vertices List of vertices
+	/// @param indices Index list into `vertices`, empty if `vertices` is an unindexed triangle list
 	/// @return Pair of remapped vertex list and index list
 	///
 	template <Vertex_type T>
-	std::pair<std::vector<T>, std::vector<uint32_t>> remap_vertices(const std::vector<T>& vertices) noexcept
+	std::pair<std::vector<T>, std::vector<uint32_t>> remap_vertices(
+		const std::vector<T>& vertices,
+		std::span<const uint32_t> indices = {}
+	) noexcept
 	{
+		const auto index_data = indices.empty() ? nullptr : indices.data();
+		const auto index_count = indices.empty() ? vertices.size() : indices.size();
+
 		std::vector<uint32_t> remap_table(vertices.size());
 		const auto vertex_count = meshopt_generateVertexRemapCustom(
 			remap_table.data(),
-			nullptr,
-			vertices.size(),
+			index_data,
+			index_count,
 			&vertices[0].position.x,
 			vertices.size(),
 			sizeof(T),
@@ -41,7 +55,7 @@ namespace gltf::detail::mesh
 		);
 
 		std::vector<T> remapped_vertices(vertex_count);
-		std::vector<uint32_t> remapped_indices(vertices.size());
+		std::vector<uint32_t> remapped_indices(index_count);
 
 		meshopt_remapVertexBuffer(
 			remapped_vertices.data(),
@@ -51,41 +65,302 @@ namespace gltf::detail::mesh
 			remap_table.data()
 		);
 
-		meshopt_remapIndexBuffer(remapped_indices.data(), nullptr, vertices.size(), remap_table.data());
+		meshopt_remapIndexBuffer(remapped_indices.data(), index_data, index_count, remap_table.data());
 
 		return {std::move(remapped_vertices), std::move(remapped_indices)};
 	}
 
+	///
+	/// @brief Reorder triangles of an indexed primitive for vertex cache efficiency and less overdraw
+	///
+	/// @param vertices Vertex list
+	/// @param indices Index list, reordered in place
+	///
+	template <Vertex_type T>
+	void optimize_index_order(const std::vector<T>& vertices, std::vector<uint32_t>& indices) noexcept
+	{
+		meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertices.size());
+
+		meshopt_optimizeOverdraw(
+			indices.data(),
+			indices.data(),
+			indices.size(),
+			&vertices[0].position.x,
+			vertices.size(),
+			sizeof(T),
+			1.05f
+		);
+	}
+
 	///
 	/// @brief Optimize a full primitive (with all vertex attributes)
 	///
 	/// @param vertices Input vertex list
+	/// @param indices Index list into `vertices`, empty if `vertices` is an unindexed triangle list
 	/// @return Pair of optimized vertex list and index list
 	///
 	template <Vertex_type T>
 	std::pair<std::vector<T>, std::vector<uint32_t>> optimize_primitive(
-		const std::vector<T>& vertices
+		const std::vector<T>& vertices,
+		std::span<const uint32_t> indices = {}
 	) noexcept
 	{
-		auto [remapped_vertices, remapped_indices] = remap_vertices(vertices);
+		auto [remapped_vertices, remapped_indices] = remap_vertices(vertices, indices);
+		optimize_index_order(remapped_vertices, remapped_indices);
 
-		meshopt_optimizeVertexCache(
-			remapped_indices.data(),
-			remapped_indices.data(),
-			remapped_indices.size(),
-			remapped_vertices.size()
+		return {std::move(remapped_vertices), std::move(remapped_indices)};
+	}
+
+	///
+	/// @brief Point all vertices sharing a position to one of them with `meshopt_generateShadowIndexBuffer`
+	/// @details For streams whose other attributes are unused, e.g. shadow vertices of opaque materials.
+	/// Triangles are reordered for the vertex cache again, and vertices no longer referenced are dropped by
+	/// `optimize_vertex_fetch`.
+	///
+	/// @param vertices Vertex list, `position` must be the first member
+	/// @param indices Index list, rewritten in place
+	///
+	template <Vertex_type T>
+	void weld_positions(const std::vector<T>& vertices, std::vector<uint32_t>& indices) noexcept
+	{
+		static_assert(offsetof(T, position) == 0);
+
+		if (indices.empty()) return;
+
+		std::vector<uint32_t> welded_indices(indices.size());
+		meshopt_generateShadowIndexBuffer(
+			welded_indices.data(),
+			indices.data(),
+			indices.size(),
+			&vertices[0].position.x,
+			vertices.size(),
+			sizeof(glm::vec3),
+			sizeof(T)
 		);
 
-		meshopt_optimizeOverdraw(
-			remapped_indices.data(),
-			remapped_indices.data(),
-			remapped_indices.size(),
-			&remapped_vertices[0].position.x,
-			remapped_vertices.size(),
+		indices = std::move(welded_indices);
+		optimize_index_order(vertices, indices);
+	}
+
+	///
+	/// @brief Reorder vertices in order of first use with `meshopt_optimizeVertexFetch`, dropping vertices
+	/// that are never referenced
+	/// @note Must run after all index reordering, as it only preserves the order of `indices`
+	///
+	/// @param vertices Vertex list, reordered in place
+	/// @param indices Index list of all levels of detail, remapped in place
+	///
+	template <Vertex_type T>
+	void optimize_vertex_fetch(std::vector<T>& vertices, std::vector<uint32_t>& indices) noexcept
+	{
+		std::vector<T> fetch_ordered_vertices(vertices.size());
+		const auto vertex_count = meshopt_optimizeVertexFetch(
+			fetch_ordered_vertices.data(),
+			indices.data(),
+			indices.size(),
+			vertices.data(),
+			vertices.size(),
+			sizeof(T)
+		);
+
+		fetch_ordered_vertices.resize(vertex_count);
+		vertices = std::move(fetch_ordered_vertices);
+	}
+
+	///
+	/// @brief Simulate the post-transform cache over an index list with `meshopt_analyzeVertexCache`
+	///
+	/// @param indices Full detail index list
+	/// @param vertex_count Number of vertices referenced by `indices`
+	/// @return Statistics of the stream
+	///
+	inline StreamStatistics analyze_vertex_cache(
+		std::span<const uint32_t> indices,
+		size_t vertex_count
+	) noexcept
+	{
+		const auto statistics =
+			meshopt_analyzeVertexCache(indices.data(), indices.size(), vertex_count, 16, 0, 0);
+
+		return {
+			.vertex_count = vertex_count,
+			.triangle_count = indices.size() / 3,
+			.transformed_count = statistics.vertices_transformed
+		};
+	}
+
+	///
+	/// @brief Narrow an index list to 16-bit for upload
+	///
+	/// @param indices Index list
+	/// @return Narrowed indices, or `std::nullopt` if any index doesn't fit
+	///
+	inline std::optional<std::vector<uint16_t>> narrow_indices(std::span<const uint32_t> indices) noexcept
+	{
+		if (std::ranges::any_of(indices, [](uint32_t index) { return index > UINT16_MAX; }))
+			return std::nullopt;
+
+		return indices
+			| std::views::transform([](uint32_t index) { return static_cast<uint16_t>(index); })
+			| std::ranges::to<std::vector>();
+	}
+
+	///
+	/// @brief Generate a level of detail chain with `meshopt_simplify`
+	/// @details Each level targets `index_ratio` of the previous index count, but is simplified from the full
+	/// detail indices so that its error is measured against the original surface. If topology-preserving
+	/// simplification stalls within `max_error`, the level is retried with `meshopt_simplifySloppy` when
+	/// `sloppy_fallback` is set. The chain stops early once both stall.
+	///
+	/// @param vertices Vertex list
+	/// @param indices Full detail index list, levels of detail are appended to it
+	/// @param config Generation config
+	/// @return Levels of detail, full detail first
+	///
+	template <Vertex_type T>
+	std::vector<PrimitiveLod> generate_lods(
+		const std::vector<T>& vertices,
+		std::vector<uint32_t>& indices,
+		const LodConfig& config
+	) noexcept
+	{
+		const auto full_count = indices.size();
+		const auto min_index_count = std::max<size_t>(config.min_triangle_count, 1) * 3;
+
+		std::vector<PrimitiveLod> lods = {
+			{.first_index = 0, .index_count = static_cast<uint32_t>(full_count), .error = 0.0f}
+		};
+
+		std::vector<uint32_t> lod_indices(full_count);
+		size_t previous_count = full_count;
+
+		while (lods.size() < config.max_level_count)
+		{
+			const auto target_count = size_t(float(previous_count) * config.index_ratio) / 3 * 3;
+			if (target_count < min_index_count) break;
+
+			float error = 0.0f;
+			auto lod_count = meshopt_simplify(
+				lod_indices.data(),
+				indices.data(),
+				full_count,
+				&vertices[0].position.x,
+				vertices.size(),
+				sizeof(T),
+				target_count,
+				config.max_error,
+				0,
+				&error
+			);
+
+			// Stalled at less than half of the intended reduction
+			const auto stalled = [&] {
+				return lod_count == 0 || lod_count > (previous_count + target_count) / 2;
+			};
+
+			// Sloppy simplification ignores topology, so it keeps reducing where seams and borders lock
+			// vertices in place
+			if (stalled() && config.sloppy_fallback)
+				lod_count = meshopt_simplifySloppy(
+					lod_indices.data(),
+					indices.data(),
+					full_count,
+					&vertices[0].position.x,
+					vertices.size(),
+					sizeof(T),
+					nullptr,
+					target_count,
+					config.max_error,
+					&error
+				);
+
+			// Coarser levels won't do better
+			if (stalled()) break;
+
+			meshopt_optimizeVertexCache(lod_indices.data(), lod_indices.data(), lod_count, vertices.size());
+
+			lods.push_back(
+				{.first_index = static_cast<uint32_t>(indices.size()),
+				 .index_count = static_cast<uint32_t>(lod_count),
+				 .error = error}
+			);
+			indices.insert(indices.end(), lod_indices.begin(), lod_indices.begin() + lod_count);
+			previous_count = lod_count;
+		}
+
+		return lods;
+	}
+
+	///
+	/// @brief Split an indexed primitive into meshlets, reordering the indices so that each meshlet is a
+	/// contiguous range
+	///
+	/// @param vertices Vertex list
+	/// @param indices Full detail index list, rewritten in meshlet order
+	/// @return Meshlets in index order, with bounds for culling
+	///
+	template <Vertex_type T>
+	std::vector<Meshlet> build_meshlets(
+		const std::vector<T>& vertices,
+		std::vector<uint32_t>& indices
+	) noexcept
+	{
+		if (indices.empty()) return {};
+
+		const auto max_meshlet_count =
+			meshopt_buildMeshletsBound(indices.size(), meshlet_max_vertices, meshlet_max_triangles);
+		std::vector<meshopt_Meshlet> meshopt_meshlets(max_meshlet_count);
+		std::vector<uint32_t> meshlet_vertices(max_meshlet_count * meshlet_max_vertices);
+		std::vector<uint8_t> meshlet_triangles(max_meshlet_count * meshlet_max_triangles * 3);
+
+		const auto meshlet_count = meshopt_buildMeshlets(
+			meshopt_meshlets.data(),
+			meshlet_vertices.data(),
+			meshlet_triangles.data(),
+			indices.data(),
+			indices.size(),
+			&vertices[0].position.x,
+			vertices.size(),
 			sizeof(T),
-			1.05f
+			meshlet_max_vertices,
+			meshlet_max_triangles,
+			0.25f
 		);
 
-		return {std::move(remapped_vertices), std::move(remapped_indices)};
+		std::vector<Meshlet> meshlets;
+		std::vector<uint32_t> meshlet_indices;
+		meshlets.reserve(meshlet_count);
+		meshlet_indices.reserve(indices.size());
+
+		for (const auto& meshlet : meshopt_meshlets | std::views::take(meshlet_count))
+		{
+			const auto bounds = meshopt_computeMeshletBounds(
+				&meshlet_vertices[meshlet.vertex_offset],
+				&meshlet_triangles[meshlet.triangle_offset],
+				meshlet.triangle_count,
+				&vertices[0].position.x,
+				vertices.size(),
+				sizeof(T)
+			);
+
+			meshlets.push_back(
+				{.first_index = static_cast<uint32_t>(meshlet_indices.size()),
+				 .index_count = meshlet.triangle_count * 3,
+				 .center = glm::vec3(bounds.center[0], bounds.center[1], bounds.center[2]),
+				 .radius = bounds.radius,
+				 .cone_apex = glm::vec3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]),
+				 .cone_cutoff = bounds.cone_cutoff,
+				 .cone_axis = glm::vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2])}
+			);
+
+			// Meshlet triangles index into the meshlet vertices, map them back to the vertex list
+			const auto triangles =
+				std::span(meshlet_triangles).subspan(meshlet.triangle_offset, meshlet.triangle_count * 3);
+			for (const auto local_index : triangles)
+				meshlet_indices.push_back(meshlet_vertices[meshlet.vertex_offset + local_index]);
+		}
+
+		indices = std::move(meshlet_indices);
+		return meshlets;
 	}
 }
\ No newline at end of file
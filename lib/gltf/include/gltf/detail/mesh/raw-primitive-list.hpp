@@ -3,6 +3,7 @@
 #include "gltf/mesh.hpp"
 
 #include <expected>
+#include <optional>
 #include <vector>
 
 namespace gltf::detail::mesh
@@ -16,4 +17,34 @@ namespace gltf::detail::mesh
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept;
+
+	// Vertex list with a triangle list index buffer into it
+	template <typename T>
+	struct IndexedVertexList
+	{
+		std::vector<T> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	///
+	/// @brief Get the vertices of an indexed primitive without unpacking them into a triangle list
+	/// @details Attributes are read on the original vertex set, and a vertex is only split where the
+	/// triangles sharing it disagree on the tangent. Only indexed triangle lists with NORMAL qualify, others
+	/// should go through `get_primitive_list`.
+	///
+	/// @param model Tinygltf model
+	/// @param primitive Tinygltf primitive
+	/// @return Indexed vertex list, `std::nullopt` if the primitive doesn't qualify, or error on failure
+	///
+	std::expected<std::optional<IndexedVertexList<Vertex>>, util::Error> get_indexed_primitive_list(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive
+	) noexcept;
+
+	// Rigged counterpart of `get_indexed_primitive_list`
+	std::expected<std::optional<IndexedVertexList<RiggedVertex>>, util::Error>
+	get_indexed_rigged_primitive_list(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive
+	) noexcept;
 }
\ No newline at end of file
@@ -13,21 +13,24 @@ namespace gltf::detail::mesh
 	///
 	/// @brief Unpack vertices from index buffer
 	///
-	/// @tparam T Type of vertex
+	/// @tparam R Type of vertex range, e.g. `std::vector` or `AccessorView`
 	/// @param vertices Input vertices
 	/// @param indices Optional index buffer
-	/// @return Unpacked vertices if indices are provided, else original vertices
+	/// @return Unpacked vertices if indices are provided, else a copy of the original vertices
 	///
-	template <typename T>
-	std::expected<std::vector<T>, util::Error> unpack_from_indices(
-		const std::vector<T>& vertices,
+	template <std::ranges::random_access_range R>
+		requires(std::ranges::sized_range<R>)
+	std::expected<std::vector<std::ranges::range_value_t<R>>, util::Error> unpack_from_indices(
+		const R& vertices,
 		const std::optional<std::vector<uint32_t>>& indices
 	) noexcept
 	{
-		if (!indices.has_value()) return vertices;
+		using T = std::ranges::range_value_t<R>;
+
+		if (!indices.has_value()) return std::vector<T>(std::from_range, vertices);
 
 		auto find_out_of_bounds =
-			std::ranges::find_if(*indices, [size = vertices.size()](const uint32_t& idx) {
+			std::ranges::find_if(*indices, [size = std::ranges::size(vertices)](const uint32_t& idx) {
 				return std::cmp_greater_equal(idx, size);
 			});
 		if (find_out_of_bounds != indices->end())
@@ -36,16 +39,13 @@ namespace gltf::detail::mesh
 					"Index {} out of bounds at index_buffer[{}] (vertex count {})",
 					*find_out_of_bounds,
 					find_out_of_bounds - indices->begin(),
-					vertices.size()
+					std::ranges::size(vertices)
 				)
 			);
 
 		std::vector<T> remapped_vertices(indices->size());
 		for (const auto i : std::views::iota(0zu, indices->size()))
-		{
-			const auto& index = (*indices)[i];
-			remapped_vertices[i] = std::cmp_greater_equal(index, vertices.size()) ? T(0.0f) : vertices[index];
-		}
+			remapped_vertices[i] = std::ranges::begin(vertices)[(*indices)[i]];
 
 		return remapped_vertices;
 	}
@@ -55,13 +55,13 @@ namespace gltf::detail::mesh
 	/// @note Guaranteed to return triangle list form, with 3 vertices per triangle
 	///
 	/// @tparam T Type of vertex
-	/// @param vertices Input vertices
+	/// @param vertices Input vertices, returned as-is for triangle lists
 	/// @param mode Tinygltf primitive mode
 	/// @return Expected flattened vertices or error
 	///
 	template <typename T>
 	std::expected<std::vector<T>, util::Error> rearrange_vertices(
-		const std::vector<T>& vertices,
+		std::vector<T> vertices,
 		int mode
 	) noexcept
 	{
@@ -0,0 +1,159 @@
+///
+/// @file image-cache.hpp
+/// @brief Provides a persistent on-disk cache of compressed mipmap chains, keyed by image content.
+///
+
+#pragma once
+
+#include "graphics/util/quick-create.hpp"
+#include "image/compress.hpp"
+#include "util/error.hpp"
+#include "util/mapped-file.hpp"
+
+#include <atomic>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <tiny_gltf.h>
+
+namespace gltf
+{
+	///
+	/// @brief Content-addressed on-disk cache of BCn-compressed mipmap chains
+	/// @details
+	/// - Every entry lives in its own file, laid out so that the level data can be uploaded straight from a
+	/// memory mapping of the file.
+	/// - When the total size of the cache exceeds the cap, least recently used entries are evicted down to
+	/// `evict_target_ratio` of the cap. The total size is tracked in memory, the directory is only scanned
+	/// when opening the cache and when evicting.
+	/// - All methods are thread-safe.
+	///
+	class ImageCache
+	{
+	  public:
+
+		// Usage of the cached image, distinguishes the compress mode enums
+		enum class Usage : uint32_t
+		{
+			Color,
+			Normal
+		};
+
+		// Cache key, identifies a compressed mipmap chain
+		struct Key
+		{
+			uint64_t content_hash;     // Hash of the source image bytes and layout
+			uint32_t encoder_version;  // Version of the encoders, see `image::compress_encoder_version`
+			Usage usage;               // Usage of the image
+			uint32_t compress_mode;    // Underlying value of `ColorCompressMode` or `NormalCompressMode`
+			uint32_t srgb;             // Whether the image is used as sRGB texture
+
+			bool operator==(const Key&) const noexcept = default;
+
+			///
+			/// @brief Create a key from a glTF image
+			///
+			/// @param image Source image
+			/// @param usage Usage of the image
+			/// @param compress_mode Underlying value of the compress mode
+			/// @param srgb Whether the image is used as sRGB texture
+			/// @return Cache key
+			///
+			static Key from_image(
+				const tinygltf::Image& image,
+				Usage usage,
+				uint32_t compress_mode,
+				bool srgb
+			) noexcept;
+		};
+
+		// Cached mipmap chain, level data points into the mapped file
+		struct Entry
+		{
+			util::MappedFile file;
+			std::vector<graphics::ImageData> levels;
+		};
+
+		// Eviction stops at this fraction of the size cap, so that a full cache doesn't evict on every store
+		static constexpr double evict_target_ratio = 0.875;
+
+		// Cache statistics since creation
+		struct Stats
+		{
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			uint64_t evictions = 0;
+		};
+
+		///
+		/// @brief Create or open a cache directory
+		///
+		/// @param directory Cache directory, created if it doesn't exist
+		/// @param max_size Maximum total size of all cache entries in bytes
+		/// @return Image cache, or error on failure
+		///
+		static std::expected<std::shared_ptr<ImageCache>, util::Error> create(
+			const std::filesystem::path& directory,
+			uint64_t max_size
+		) noexcept;
+
+		///
+		/// @brief Look up a compressed mipmap chain
+		/// @note Corrupted or mismatched entries are counted as misses and removed
+		///
+		/// @param key Cache key
+		/// @return Cached entry, or `std::nullopt` if missing
+		///
+		std::optional<Entry> load(const Key& key) noexcept;
+
+		///
+		/// @brief Store a compressed mipmap chain, evicting old entries if the size cap is exceeded
+		///
+		/// @param key Cache key
+		/// @param mipmap_chain Compressed mipmap chain, level 0 first
+		///
+		std::expected<void, util::Error> store(
+			const Key& key,
+			std::span<const image::BCImage> mipmap_chain
+		) noexcept;
+
+		// Get cache statistics
+		Stats get_stats() const noexcept;
+
+	  private:
+
+		std::filesystem::path directory;
+		uint64_t max_size;
+
+		std::mutex size_mutex;
+		uint64_t total_size;  // Total size of all entries, guarded by `size_mutex`
+
+		std::atomic<uint64_t> hits = 0, misses = 0, evictions = 0;
+
+		ImageCache(std::filesystem::path directory, uint64_t max_size, uint64_t total_size) noexcept :
+			directory(std::move(directory)),
+			max_size(max_size),
+			total_size(total_size)
+		{}
+
+		// Get file path of an entry
+		std::filesystem::path entry_path(const Key& key) const noexcept;
+
+		// Update the tracked total size after an entry is added or removed, evicting if over the cap
+		void update_size(uint64_t added_size, uint64_t removed_size) noexcept;
+
+		// Rescan the directory and remove least recently used entries until the total size is under the
+		// eviction target. Must be called with `size_mutex` held
+		void evict() noexcept;
+
+	  public:
+
+		ImageCache(const ImageCache&) = delete;
+		ImageCache(ImageCache&&) = delete;
+		ImageCache& operator=(const ImageCache&) = delete;
+		ImageCache& operator=(ImageCache&&) = delete;
+	};
+}
@@ -1,13 +1,17 @@
 ///
 /// @file image.hpp
 /// @brief Provides functions to create GPU textures from glTF images. Compression and mipmapping are
-/// supported.
+/// supported. Encoding (CPU) and uploading (GPU) are also exposed separately for offline baking.
 ///
 
 #pragma once
 
+#include "detail/bake/stream.hpp"
 #include "gpu/texture.hpp"
+#include "graphics/util/quick-create.hpp"
+
 #include <glm/glm.hpp>
+#include <memory>
 #include <tiny_gltf.h>
 
 namespace gltf
@@ -28,6 +32,80 @@ namespace gltf
 		RG16_raw_RG8_BC5,  // Load RG16 as-is, but compress to BC5 after loading RG8
 	};
 
+	class ImageCache;
+
+	// Options for the compression stage of texture creation
+	struct CompressOptions
+	{
+		bool parallel = false;        // Split BCn block compression across a thread pool
+		ImageCache* cache = nullptr;  // Persistent cache of compressed mipmap chains, `nullptr` to disable
+	};
+
+	// Encoded texture data ready for upload, mipmap chain level 0 first
+	struct TextureData
+	{
+		SDL_GPUTextureFormat format;
+		std::vector<graphics::ImageData> levels;
+		std::shared_ptr<const void> storage;  // Owner of the memory `levels` point into, empty if external
+
+		// Serialize into a baked scene
+		void bake(detail::bake::Writer& writer) const noexcept;
+
+		///
+		/// @brief Read texture data from a baked scene
+		/// @note The levels point into the reader's data, `storage` is left empty
+		///
+		/// @param reader Baked data reader
+		/// @return Texture data, or error if the data is malformed
+		///
+		static std::expected<TextureData, util::Error> from_baked(detail::bake::Reader& reader) noexcept;
+	};
+
+	///
+	/// @brief Encode a color texture from a glTF image, without touching the GPU
+	/// @details Same as `create_color_texture_from_image`, but stops before uploading
+	///
+	/// @param image Image data
+	/// @param compress_mode Compression mode
+	/// @param srgb Whether to use sRGB format
+	/// @param options Compression options
+	/// @return Encoded texture data or error
+	///
+	std::expected<TextureData, util::Error> encode_color_texture(
+		const tinygltf::Image& image,
+		ColorCompressMode compress_mode,
+		bool srgb,
+		const CompressOptions& options
+	) noexcept;
+
+	///
+	/// @brief Encode a normal texture from a glTF image, without touching the GPU
+	/// @details Same as `create_normal_texture_from_image`, but stops before uploading
+	///
+	/// @param image Image data
+	/// @param compress_mode Compression mode
+	/// @param options Compression options
+	/// @return Encoded texture data or error
+	///
+	std::expected<TextureData, util::Error> encode_normal_texture(
+		const tinygltf::Image& image,
+		NormalCompressMode compress_mode,
+		const CompressOptions& options
+	) noexcept;
+
+	///
+	/// @brief Upload encoded texture data to a GPU texture
+	///
+	/// @param data Encoded texture data
+	/// @param name Name for the created texture
+	/// @return Created GPU texture or error
+	///
+	std::expected<gpu::Texture, util::Error> upload_texture(
+		SDL_GPUDevice* device,
+		const TextureData& data,
+		const std::string& name
+	) noexcept;
+
 	///
 	/// @brief Create a color texture from a glTF image
 	/// @details The process compresses and mipmaps the image using the given config at best effort. If
@@ -37,6 +115,7 @@ namespace gltf
 	/// @param image Image data
 	/// @param compress_mode Compression mode
 	/// @param srgb Whether to use sRGB format
+	/// @param options Compression options
 	/// @return Created GPU texture or error
 	///
 	std::expected<gpu::Texture, util::Error> create_color_texture_from_image(
@@ -44,6 +123,7 @@ namespace gltf
 		const tinygltf::Image& image,
 		ColorCompressMode compress_mode,
 		bool srgb,
+		const CompressOptions& options,
 		const std::string& name
 	) noexcept;
 
@@ -55,12 +135,14 @@ namespace gltf
 	///
 	/// @param image Image data
 	/// @param compress_mode Compression mode
+	/// @param options Compression options
 	/// @return Created GPU texture or error
 	///
 	std::expected<gpu::Texture, util::Error> create_normal_texture_from_image(
 		SDL_GPUDevice* device,
 		const tinygltf::Image& image,
 		NormalCompressMode compress_mode,
+		const CompressOptions& options,
 		const std::string& name
 	) noexcept;
 
@@ -14,6 +14,7 @@
 
 #include "gpu/sampler.hpp"
 #include "gpu/texture.hpp"
+#include "image-cache.hpp"
 #include "image.hpp"
 #include "sampler.hpp"
 #include "texture.hpp"
@@ -147,6 +148,8 @@ namespace gltf
 		{
 			ColorCompressMode color_mode = ColorCompressMode::RGBA8_BC7;
 			NormalCompressMode normal_mode = NormalCompressMode::RGn_BC5;
+			bool parallel_compress = false;  // Split BCn block compression across threads, if few images
+			std::shared_ptr<ImageCache> cache = nullptr;  // Persistent compressed image cache, optional
 		};
 
 		///
@@ -166,6 +169,39 @@ namespace gltf
 			const Load_progress_callback& progress_callback = nullptr
 		) noexcept;
 
+		///
+		/// @brief Encode all materials of a glTF model into a baked scene, without touching the GPU
+		/// @details Samplers are stored as glTF parameters, so that `SamplerConfig` can still be chosen at
+		/// load time. Images are stored as encoded (compressed and mipmapped) texture data.
+		///
+		/// @param writer Baked data writer
+		/// @param model Tinygltf model
+		/// @param image_config Image encoding config
+		/// @param progress_callback Progress callback, refer to `Load_progress_callback`
+		/// @return Void on success, or error on failure
+		///
+		static std::expected<void, util::Error> bake(
+			detail::bake::Writer& writer,
+			const tinygltf::Model& model,
+			const ImageConfig& image_config,
+			const Load_progress_callback& progress_callback = nullptr
+		) noexcept;
+
+		///
+		/// @brief Create `Material_list` from a baked scene, uploading textures directly from the baked data
+		///
+		/// @param reader Baked data reader
+		/// @param sampler_config Sampler creation config
+		/// @param progress_callback Progress callback, refer to `Load_progress_callback`
+		/// @return Material_list on success, or error on failure
+		///
+		static std::expected<MaterialList, util::Error> from_baked(
+			SDL_GPUDevice* device,
+			detail::bake::Reader& reader,
+			const SamplerConfig& sampler_config,
+			const Load_progress_callback& progress_callback = nullptr
+		) noexcept;
+
 		///
 		/// @brief Generate material cache
 		/// @warning Pay extra attention to the life span of the returned `Material_cache`. The material list
@@ -183,6 +219,14 @@ namespace gltf
 			std::optional<gpu::Texture> normal_texture;
 		};
 
+		// Encoded textures of an image, before uploading
+		struct EncodedImage
+		{
+			std::optional<TextureData> color_texture;
+			std::optional<TextureData> linear_texture;
+			std::optional<TextureData> normal_texture;
+		};
+
 		struct ImageRefCount
 		{
 			uint32_t color_refcount = 0;   // Use count as SRGB color texture (RGB/RGBA)
@@ -211,6 +255,20 @@ namespace gltf
 		// Create default sampler (fallback sampler)
 		std::expected<void, util::Error> create_default_sampler(SDL_GPUDevice* device) noexcept;
 
+		// Worker thread for encoding an image, CPU only
+		static std::expected<EncodedImage, util::Error> encode_image_thread(
+			const tinygltf::Image& image,
+			const ImageConfig& image_config,
+			ImageRefCount refcount
+		) noexcept;
+
+		// Upload the encoded textures of an image
+		static std::expected<ImageEntry, util::Error> upload_image(
+			SDL_GPUDevice* device,
+			const EncodedImage& encoded,
+			const std::string& name
+		) noexcept;
+
 		// Worker thread for loading an image
 		static std::expected<ImageEntry, util::Error> load_image_thread(
 			SDL_GPUDevice* device,
@@ -219,6 +277,16 @@ namespace gltf
 			ImageRefCount refcount
 		) noexcept;
 
+		// Run `task(image, refcount)` for every image of the model concurrently, results are in image order
+		template <
+			typename F,
+			typename R = typename std::invoke_result_t<F, const tinygltf::Image&, ImageRefCount>::value_type>
+		static std::expected<std::vector<R>, util::Error> for_each_image_parallel(
+			const tinygltf::Model& model,
+			const Load_progress_callback& progress_callback,
+			F task
+		) noexcept;
+
 		// Load all images from the model, concurrently
 		std::expected<void, util::Error> load_images(
 			SDL_GPUDevice* device,
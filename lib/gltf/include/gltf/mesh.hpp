@@ -5,11 +5,16 @@
 
 #pragma once
 
+#include "detail/bake/stream.hpp"
 #include "gpu/buffer.hpp"
+#include "meshlet.hpp"
 #include "util/inline.hpp"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 #include <optional>
+#include <span>
+#include <string>
 #include <tiny_gltf.h>
 #include <vector>
 
@@ -19,7 +24,7 @@ namespace gltf
 	{
 		glm::vec3 position;
 		glm::vec3 normal;
-		glm::vec3 tangent;
+		glm::vec4 tangent;  // Bitangent sign in w, as in glTF TANGENT
 		glm::vec2 texcoord;
 
 		bool operator==(const Vertex& other) const noexcept;
@@ -29,7 +34,7 @@ namespace gltf
 	{
 		glm::vec3 position;
 		glm::vec3 normal;
-		glm::vec3 tangent;
+		glm::vec4 tangent;  // Bitangent sign in w, as in glTF TANGENT
 		glm::vec2 texcoord;
 		glm::uvec4 joint_indices;
 		glm::vec4 joint_weights;
@@ -59,29 +64,163 @@ namespace gltf
 		static RiggedShadowVertex from_rigged_vertex(const RiggedVertex& vertex) noexcept;
 	};
 
+	// Compact counterpart of `Vertex`, 20 bytes instead of 48
+	struct QuantizedVertex
+	{
+		glm::u16vec4 position;        // Unorm16 relative to the primitive bounds, bitangent sign in w
+		glm::i16vec4 normal_tangent;  // Octahedral snorm16 normal in xy, tangent in zw
+		glm::u16vec2 texcoord;        // Half floats
+
+		///
+		/// @brief Quantize a vertex with `meshopt_quantize*`
+		///
+		/// @param vertex Full precision vertex
+		/// @param position_min Minimum of the primitive bounds
+		/// @param position_max Maximum of the primitive bounds
+		/// @return Quantized vertex
+		///
+		static QuantizedVertex from_vertex(
+			const Vertex& vertex,
+			const glm::vec3& position_min,
+			const glm::vec3& position_max
+		) noexcept;
+
+		// Decode back to full precision, same as the quantized vertex shaders
+		Vertex to_vertex(const glm::vec3& position_min, const glm::vec3& position_max) const noexcept;
+	};
+
+	// Compact counterpart of `ShadowVertex`, 12 bytes instead of 20
+	struct QuantizedShadowVertex
+	{
+		glm::u16vec4 position;  // Unorm16 relative to the primitive bounds, w unused
+		glm::u16vec2 texcoord;  // Half floats
+
+		static QuantizedShadowVertex from_shadow_vertex(
+			const ShadowVertex& vertex,
+			const glm::vec3& position_min,
+			const glm::vec3& position_max
+		) noexcept;
+
+		ShadowVertex to_shadow_vertex(const glm::vec3& position_min, const glm::vec3& position_max)
+			const noexcept;
+	};
+
+	// Vertex layout of a primitive on GPU side
+	enum class VertexFormat : uint8_t
+	{
+		Standard,   // `Vertex` and `ShadowVertex`
+		Rigged,     // `RiggedVertex` and `RiggedShadowVertex`
+		Quantized,  // `QuantizedVertex` and `QuantizedShadowVertex`
+	};
+
+	// Index range of one level of detail in an index buffer
+	struct PrimitiveLod
+	{
+		uint32_t first_index;
+		uint32_t index_count;
+		float error;  // Simplification error relative to the primitive extent, 0 for full detail
+	};
+
+	// Level of detail chain generation config, see `meshopt_simplify`
+	struct LodConfig
+	{
+		uint32_t max_level_count = 4;      // Including full detail, 1 disables simplification
+		float index_ratio = 0.5f;          // Target index count of each level relative to the previous one
+		float max_error = 0.05f;           // Maximum error relative to the primitive extent
+		uint32_t min_triangle_count = 64;  // Primitives below this are never simplified
+		bool sloppy_fallback = true;       // Retry stalled levels with `meshopt_simplifySloppy`
+	};
+
+	// Mesh loading config
+	struct MeshConfig
+	{
+		// Upload non-rigged primitives with `VertexFormat::Quantized`
+		bool quantize_vertices = false;
+
+		// Level of detail generation when parsing glTF. Baked scenes carry their own levels, of which only
+		// the first `max_level_count` are uploaded
+		LodConfig lod = {};
+	};
+
+	// Post-transform cache statistics of a vertex stream, see `meshopt_analyzeVertexCache`
+	struct StreamStatistics
+	{
+		size_t vertex_count = 0;       // Vertices in the stream
+		size_t triangle_count = 0;     // Triangles of the full detail level
+		size_t transformed_count = 0;  // Vertex shader invocations with a simulated 16-entry cache
+
+		// Average cache miss ratio, transformed vertices per triangle, 0.5 at best and 3 at worst
+		float acmr() const noexcept;
+
+		// Average transformed vertex ratio, transformed vertices per vertex, 1 at best
+		float atvr() const noexcept;
+
+		StreamStatistics& operator+=(const StreamStatistics& other) noexcept;
+	};
+
+	// Vertex stream statistics of primitives before and after optimization, summed over primitives
+	struct MeshStatistics
+	{
+		size_t primitive_count = 0;
+		StreamStatistics source;  // As extracted from glTF, also the shadow stream before optimization
+		StreamStatistics optimized;
+		StreamStatistics shadow_optimized;
+
+		MeshStatistics& operator+=(const MeshStatistics& other) noexcept;
+
+		// Multi-line summary, shown in the debug overlay and printed by the scene baker
+		std::string to_string() const noexcept;
+	};
+
+	///
+	/// @brief Pick the coarsest level of detail with acceptable projected error
+	///
+	/// @param lods Levels of detail, full detail first, must not be empty
+	/// @param projected_size Size of the primitive bounds on screen, relative to the screen size
+	/// @param max_error Maximum acceptable error on screen, relative to the screen size
+	/// @return Selected level of detail
+	///
+	FORCE_INLINE const PrimitiveLod& select_lod(
+		std::span<const PrimitiveLod> lods,
+		float projected_size,
+		float max_error
+	) noexcept
+	{
+		size_t level = 0;
+		while (level + 1 < lods.size() && lods[level + 1].error * projected_size <= max_error) level++;
+		return lods[level];
+	}
+
 	// Primitive Mesh Data
 	struct Primitive
 	{
 		std::vector<Vertex> vertices;
-		std::vector<uint32_t> indices;
+		std::vector<uint32_t> indices;  // All levels of detail, concatenated
+		std::vector<PrimitiveLod> lods;
+		std::vector<Meshlet> meshlets;  // Clusters of the full detail level
 
-		std::vector<ShadowVertex> shadow_vertices;
+		std::vector<ShadowVertex> shadow_vertices;  // Welded by position only for opaque materials
 		std::vector<uint32_t> shadow_indices;
+		std::vector<PrimitiveLod> shadow_lods;
 
 		std::optional<uint32_t> material;
 
 		glm::vec3 position_min, position_max;
 
+		MeshStatistics statistics;  // Optimization statistics, not baked
+
 		///
 		/// @brief Create a `Primitive` from a `tinygltf::Primitive`, performing validation
 		///
 		/// @param model Tinygltf model
 		/// @param primitive Tinygltf primitive
+		/// @param lod_config Level of detail generation config
 		/// @return Primitive on success, or error on failure
 		///
 		static std::expected<Primitive, util::Error> from_tinygltf(
 			const tinygltf::Model& model,
-			const tinygltf::Primitive& primitive
+			const tinygltf::Primitive& primitive,
+			const LodConfig& lod_config = {}
 		) noexcept;
 	};
 
@@ -89,25 +228,31 @@ namespace gltf
 	struct RiggedPrimitive
 	{
 		std::vector<RiggedVertex> vertices;
-		std::vector<uint32_t> indices;
+		std::vector<uint32_t> indices;  // All levels of detail, concatenated
+		std::vector<PrimitiveLod> lods;
 
 		std::vector<RiggedShadowVertex> shadow_vertices;
 		std::vector<uint32_t> shadow_indices;
+		std::vector<PrimitiveLod> shadow_lods;
 
 		std::optional<uint32_t> material;
 
 		glm::vec3 position_min, position_max;
 
+		MeshStatistics statistics;  // Optimization statistics, not baked
+
 		///
 		/// @brief Create a `Rigged_primitive` from a `tinygltf::Primitive`, performing validation
 		///
 		/// @param model Tinygltf model
 		/// @param primitive Tinygltf primitive
+		/// @param lod_config Level of detail generation config
 		/// @return Rigged_primitive on success, or error on failure
 		///
 		static std::expected<RiggedPrimitive, util::Error> from_tinygltf(
 			const tinygltf::Model& model,
-			const tinygltf::Primitive& primitive
+			const tinygltf::Primitive& primitive,
+			const LodConfig& lod_config = {}
 		) noexcept;
 	};
 
@@ -118,33 +263,83 @@ namespace gltf
 		SDL_GPUBufferBinding index_buffer_binding;
 		SDL_GPUBufferBinding shadow_vertex_buffer_binding;
 		SDL_GPUBufferBinding shadow_index_buffer_binding;
-		uint32_t index_count;
+		SDL_GPUIndexElementSize index_element_size;
+		SDL_GPUIndexElementSize shadow_index_element_size;
+		VertexFormat vertex_format;
+
+		// Levels of detail in the index buffers and meshlets of the full detail level, owned by the
+		// `PrimitiveGPU`
+		std::span<const PrimitiveLod> lods, shadow_lods;
+		std::span<const Meshlet> meshlets;
+
+		// Index range to draw, full detail by default. Renderers pick it from `lods` or `shadow_lods`
+		// depending on the pass.
+		PrimitiveLod lod;
+
+		// Dequantization of `VertexFormat::Quantized` positions: `offset + unorm * scale`
+		glm::vec3 position_offset, position_scale;
+	};
+
+	// Type-erased view of primitive mesh data, e.g. pointing into a baked scene
+	struct PrimitiveView
+	{
+		std::span<const std::byte> vertices;         // `Vertex` or `RiggedVertex` array
+		std::span<const uint32_t> indices;
+		std::span<const PrimitiveLod> lods;
+		std::span<const Meshlet> meshlets;  // Empty for rigged primitives
+		std::span<const std::byte> shadow_vertices;  // `ShadowVertex` or `RiggedShadowVertex` array
+		std::span<const uint32_t> shadow_indices;
+		std::span<const PrimitiveLod> shadow_lods;
+
+		std::optional<uint32_t> material;
+
+		glm::vec3 position_min, position_max;
 		bool rigged;
 	};
 
 	// Primitive Mesh Data for GPU
 	struct PrimitiveGPU
 	{
-		uint32_t index_count;
+		std::vector<PrimitiveLod> lods, shadow_lods;
+		std::vector<Meshlet> meshlets;
 
 		gpu::Buffer vertex_buffer;
 		gpu::Buffer index_buffer;
 		gpu::Buffer shadow_vertex_buffer;
 		gpu::Buffer shadow_index_buffer;
 
+		// 16-bit when all indices of the buffer fit, chosen at upload
+		SDL_GPUIndexElementSize index_element_size;
+		SDL_GPUIndexElementSize shadow_index_element_size;
+
 		std::optional<uint32_t> material;
 		glm::vec3 position_min, position_max;
-		bool rigged;
+		VertexFormat vertex_format;
+
+		///
+		/// @brief Create a `Primitive_gpu` from a type-erased view, uploading data to the GPU
+		///
+		/// @param view CPU-side primitive view
+		/// @param config Mesh config, non-rigged vertices are quantized before upload if enabled
+		/// @return GPU-side primitive, or error on failure
+		///
+		static std::expected<PrimitiveGPU, util::Error> from_view(
+			SDL_GPUDevice* device,
+			const PrimitiveView& view,
+			const MeshConfig& config = {}
+		) noexcept;
 
 		///
 		/// @brief Create a `Primitive_gpu` from a `Primitive`, uploading data to the GPU
 		///
 		/// @param primitive CPU-side primitive
+		/// @param config Mesh config
 		/// @return GPU-side primitive, or error on failure
 		///
 		static std::expected<PrimitiveGPU, util::Error> from_primitive(
 			SDL_GPUDevice* device,
-			const Primitive& primitive
+			const Primitive& primitive,
+			const MeshConfig& config = {}
 		) noexcept;
 
 		///
@@ -169,8 +364,15 @@ namespace gltf
 				 .index_buffer_binding = {.buffer = index_buffer, .offset = 0},
 				 .shadow_vertex_buffer_binding = {.buffer = shadow_vertex_buffer, .offset = 0},
 				 .shadow_index_buffer_binding = {.buffer = shadow_index_buffer, .offset = 0},
-				 .index_count = index_count,
-				 .rigged = rigged},
+				 .index_element_size = index_element_size,
+				 .shadow_index_element_size = shadow_index_element_size,
+				 .vertex_format = vertex_format,
+				 .lods = lods,
+				 .shadow_lods = shadow_lods,
+				 .meshlets = meshlets,
+				 .lod = lods.front(),
+				 .position_offset = position_min,
+				 .position_scale = position_max - position_min},
 				position_min,
 				position_max
 			};
@@ -188,12 +390,20 @@ namespace gltf
 		///
 		/// @param model Tinygltf model
 		/// @param mesh Tinygltf mesh
+		/// @param lod_config Level of detail generation config
 		/// @return Mesh on success, or error on failure
 		///
 		static std::expected<Mesh, util::Error> from_tinygltf(
 			const tinygltf::Model& model,
-			const tinygltf::Mesh& mesh
+			const tinygltf::Mesh& mesh,
+			const LodConfig& lod_config = {}
 		) noexcept;
+
+		// Serialize into a baked scene
+		void bake(detail::bake::Writer& writer) const noexcept;
+
+		// Sum optimization statistics of all primitives
+		MeshStatistics get_statistics() const noexcept;
 	};
 
 	// Mesh data on GPU side
@@ -205,11 +415,26 @@ namespace gltf
 		/// @brief Upload a `Mesh` to GPU, creating `Mesh_gpu`
 		///
 		/// @param mesh CPU-side mesh
+		/// @param config Mesh config
 		/// @return GPU-side mesh, or error on failure
 		///
 		static std::expected<MeshGPU, util::Error> from_mesh(
 			SDL_GPUDevice* device,
-			const Mesh& mesh
+			const Mesh& mesh,
+			const MeshConfig& config = {}
+		) noexcept;
+
+		///
+		/// @brief Upload a mesh from a baked scene, see `Mesh::bake`
+		///
+		/// @param reader Baked data reader
+		/// @param config Mesh config
+		/// @return GPU-side mesh, or error on failure
+		///
+		static std::expected<MeshGPU, util::Error> from_baked(
+			SDL_GPUDevice* device,
+			detail::bake::Reader& reader,
+			const MeshConfig& config = {}
 		) noexcept;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+///
+/// @file meshlet.hpp
+/// @brief Provides triangle clusters of primitives, with bounds for CPU cluster culling
+///
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gltf
+{
+	// Maximum vertex and triangle count of a meshlet, see `meshopt_buildMeshlets`
+	inline constexpr size_t meshlet_max_vertices = 64;
+	inline constexpr size_t meshlet_max_triangles = 124;
+
+	///
+	/// @brief Cluster of triangles, occupying a contiguous range of the full detail index buffer
+	/// @details Bounds are computed by `meshopt_computeMeshletBounds` in primitive local space
+	///
+	struct Meshlet
+	{
+		uint32_t first_index;
+		uint32_t index_count;
+
+		// Bounding sphere
+		glm::vec3 center;
+		float radius;
+
+		// Normal cone, all triangles are back-facing from eyes inside it, see `graphics::cone_backfacing`
+		glm::vec3 cone_apex;
+		float cone_cutoff;
+		glm::vec3 cone_axis;
+	};
+
+	///
+	/// @brief Cull the meshlets of a primitive on CPU, emitting index ranges of the visible ones
+	/// @details Meshlets outside the frustum are rejected, and back-facing ones too if `cull_backfacing` is
+	/// set. Consecutive visible meshlets are merged into one range. Tests run in primitive local space, so
+	/// meshlet bounds are never transformed.
+	///
+	/// @param meshlets Meshlets in index buffer order
+	/// @param world_matrix Primitive local to world transform
+	/// @param frustum_planes World space frustum planes, see `graphics::compute_frustum_planes`
+	/// @param eye_position World space eye position
+	/// @param cull_backfacing Reject back-facing meshlets, must be false for double-sided materials
+	/// @param ranges Output (first_index, index_count) ranges, appended to
+	///
+	void cull_meshlets(
+		std::span<const Meshlet> meshlets,
+		const glm::mat4& world_matrix,
+		std::span<const glm::vec4> frustum_planes,
+		const glm::vec3& eye_position,
+		bool cull_backfacing,
+		std::pmr::vector<std::pair<uint32_t, uint32_t>>& ranges
+	) noexcept;
+}
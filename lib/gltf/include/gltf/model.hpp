@@ -8,13 +8,18 @@
 #include "animation.hpp"
 #include "gltf/light.hpp"
 #include "gltf/skin.hpp"
+#include "graphics/bvh.hpp"
+#include "graphics/trs.hpp"
 #include "material.hpp"
 #include "mesh.hpp"
 #include "node.hpp"
+#include "util/name-index.hpp"
 
 #include <atomic>
 #include <cstdint>
-#include <unordered_map>
+#include <filesystem>
+#include <limits>
+#include <memory_resource>
 #include <variant>
 
 namespace gltf
@@ -44,14 +49,32 @@ namespace gltf
 		{
 			return std::get<uint32_t>(transform_or_joint_matrix_offset);
 		}
+
+		// Vertex format of the pipeline drawing this drawcall
+		FORCE_INLINE VertexFormat get_vertex_format() const noexcept
+		{
+			if (is_rigged()) return VertexFormat::Rigged;
+			return primitive.vertex_format == VertexFormat::Quantized ? VertexFormat::Quantized
+																	  : VertexFormat::Standard;
+		}
 	};
 
+	// Per-frame drawdata of a model, containers allocate from the memory resource given at generation
 	struct Drawdata
 	{
 		// Drawcall list
-		std::vector<PrimitiveDrawcall> primitive_drawcalls;
+		std::pmr::vector<PrimitiveDrawcall> primitive_drawcalls;
+
+		// Marks a BVH primitive without a drawcall in `bvh_drawcall_indices`
+		static constexpr uint32_t hidden_drawcall = std::numeric_limits<uint32_t>::max();
 
-		std::vector<glm::mat4> node_matrices;
+		// Culling hierarchy over all drawcalls of the model, owned by the model
+		const graphics::Bvh* primitive_bvh = nullptr;
+
+		// Index into `primitive_drawcalls` of each BVH primitive, or `hidden_drawcall`
+		std::pmr::vector<uint32_t> bvh_drawcall_indices;
+
+		std::pmr::vector<glm::mat4> node_matrices;
 
 		// Joint matrices
 		std::shared_ptr<DeferredSkinningResource> deferred_skin_resource;
@@ -73,15 +96,64 @@ namespace gltf
 		std::vector<uint32_t> root_nodes;   // List of root node indices
 		SkinList skin_list;                 // Collection of skins
 		std::vector<Light> lights;          // List of lights
+		MeshStatistics mesh_statistics;     // Mesh optimization statistics, empty for baked scenes
 
 		/*===== Accelerating Structures =====*/
 
 		std::vector<uint32_t> node_topo_order;                // Topological order of node indices
+		std::vector<uint32_t> node_level_offsets;             // Level starts in `node_topo_order`, plus end
 		std::vector<std::optional<uint32_t>> node_parents;    // Parent index for each node
 		std::vector<bool> renderable_nodes;                   // If node is renderable (children of root)
-		size_t primitive_count;                               // Total primitive count
 		std::unique_ptr<MaterialCache> material_bind_cache;   // Material bind cache
-		std::unordered_map<std::string, uint32_t> animation_name_map;  // Map of animation name to index
+		util::NameIndex node_names;                           // Node indices by name
+		util::NameIndex animation_names;                      // Animation indices by name
+
+		// Model-space bounds of all rigged drawcalls over time buckets of one animation
+		struct SkinBoundTable
+		{
+			float start_time = 0.0f;
+			float bucket_duration = 0.0f;
+			uint32_t bucket_count = 1;
+
+			// (min, max) indexed by `bucket * skinned_drawcall_count + skinned drawcall`, see
+			// `TransformState::skinned_drawcall_count`
+			std::vector<std::pair<glm::vec3, glm::vec3>> bounds;
+
+			// Get the bounds of a rigged drawcall over the bucket containing `time`, clamped to the table
+			std::pair<glm::vec3, glm::vec3> lookup(
+				size_t skinned_drawcall_count,
+				size_t skinned_drawcall,
+				float time
+			) const noexcept;
+		};
+
+		std::vector<SkinBoundTable> animation_skin_bounds;  // Per animation, see `precompute_skin_bounds`
+
+		/*===== Incremental Update State =====*/
+
+		// Node transforms and drawcalls kept across frames, only changed subtrees are recomputed
+		struct TransformState
+		{
+			bool initialized = false;                               // If the state holds a previous frame
+			glm::mat4 model_transform{1.0f};                        // Root transform of the last frame
+			std::vector<Node::TransformOverride> node_overrides;    // Overrides of the last frame
+			std::vector<Node::TransformOverride> next_overrides;    // Scratch for the current frame
+			std::vector<std::vector<uint32_t>> animation_cursors;   // Keyframe cursors, per animation channel
+			std::vector<glm::mat4> node_world_matrices;             // World matrices of the last frame
+			std::vector<JointBounds> skin_bounds;                   // Joint position bounds per skin
+			uint32_t skinned_drawcall_count = 0;                    // Drawcalls of rigged nodes
+			std::optional<std::pair<uint32_t, float>> sole_animation;  // (Animation, time) of a lone key
+			std::vector<bool> node_dirty;                           // If node changed in the current frame
+			graphics::TrsArray local_trs;                           // Local TRS, by topological position
+			std::vector<glm::mat4> local_matrices;                  // Local matrices, by topological position
+			std::vector<bool> matrix_local;  // If the glTF matrix is used as-is, by topological position
+			std::vector<PrimitiveDrawcall> drawcalls;               // Drawcalls of all renderable nodes
+			std::vector<std::pair<uint32_t, uint32_t>> node_drawcall_ranges;  // (offset, count) per node
+			std::vector<uint32_t> drawcall_nodes;  // Renderable nodes with a mesh, topologically ordered
+			graphics::Bvh drawcall_bvh;            // Culling hierarchy over `drawcalls`, refit as they move
+		};
+
+		TransformState transform_state;
 
 	  public:
 
@@ -107,6 +179,7 @@ namespace gltf
 		/// @param tinygltf_model Tinygltf model
 		/// @param sampler_config Sampler creation config
 		/// @param image_config Image compression config
+		/// @param mesh_config Mesh loading config, including level of detail generation
 		/// @param progress Progress reference for loading progress (optional)
 		/// @return Loaded Model or Error
 		///
@@ -115,25 +188,94 @@ namespace gltf
 			const tinygltf::Model& tinygltf_model,
 			const SamplerConfig& sampler_config,
 			const MaterialList::ImageConfig& image_config,
+			const MeshConfig& mesh_config,
+			const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress = std::nullopt
+		) noexcept;
+
+		///
+		/// @brief Bake a tinygltf model into a memory-mappable scene file
+		/// @details Runs every CPU stage of `from_tinygltf` (mesh optimization, tangent generation, texture
+		/// compression and mipmapping) once, and stores the results in a versioned container that
+		/// `from_baked` uploads without further processing.
+		///
+		/// @param tinygltf_model Tinygltf model
+		/// @param image_config Image compression config
+		/// @param lod_config Level of detail generation config
+		/// @param output_path Path of the baked scene file to write
+		/// @param progress Progress reference for baking progress (optional)
+		/// @return Mesh optimization statistics on success, or Error on failure
+		///
+		static std::expected<MeshStatistics, util::Error> bake(
+			const tinygltf::Model& tinygltf_model,
+			const MaterialList::ImageConfig& image_config,
+			const LodConfig& lod_config,
+			const std::filesystem::path& output_path,
+			const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress = std::nullopt
+		) noexcept;
+
+		///
+		/// @brief Load model from a baked scene file, see `bake`
+		/// @note The file is memory-mapped, and buffers/textures are uploaded directly from the mapping
+		///
+		/// @param path Path of the baked scene file
+		/// @param sampler_config Sampler creation config
+		/// @param mesh_config Mesh upload config, vertices are quantized at upload if enabled, and levels of
+		/// detail beyond `lod.max_level_count` are dropped
+		/// @param progress Progress reference for loading progress (optional)
+		/// @return Loaded Model or Error
+		///
+		static std::expected<Model, util::Error> from_baked(
+			SDL_GPUDevice* device,
+			const std::filesystem::path& path,
+			const SamplerConfig& sampler_config,
+			const MeshConfig& mesh_config,
 			const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress = std::nullopt
 		) noexcept;
 
 		///
 		/// @brief Generate drawdata for the model
+		/// @details Node transforms and drawcalls are cached between calls. Only nodes whose animation
+		/// overrides changed, and their subtrees, are recomputed.
 		/// @warning The life span of the returned drawdata is shorter than the life span of the model
 		///
 		/// @param model_transform Root model transform matrix
-		/// @param animation Animation keys to apply
+		/// @param animation Animation keys to apply in order, later keys replace or blend over earlier ones
 		/// @param emission_overrides Overrides for emissive factors (node_index, multiplier)
 		/// @param hidden_nodes List of node indices to hide
+		/// @param resource Memory resource for the drawdata containers, usually a per-frame arena
 		/// @return Drawdata, where drawcall's matrix denotes `Model->World` transform
 		///
 		Drawdata generate_drawdata(
 			const glm::mat4& model_transform,
 			std::span<const AnimationKey> animation,
 			std::span<const std::pair<uint32_t, float>> emission_overrides,
-			std::span<const uint32_t> hidden_nodes
-		) const noexcept;
+			std::span<const uint32_t> hidden_nodes,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+		) noexcept;
+
+		// Default sample rate of `precompute_skin_bounds`, in samples per second
+		static constexpr float default_skin_bound_sample_rate = 30.0f;
+
+		///
+		/// @brief Precompute bounds of rigged drawcalls for every animation
+		/// @details Each animation is sampled in model space, and the bounds of every rigged drawcall are
+		/// stored per time bucket. While the model is driven by a single full-weight animation key, rigged
+		/// bounds are then a table lookup transformed by the model transform, and the joint bounds pass is
+		/// skipped. Runs at load time with `default_skin_bound_sample_rate`.
+		/// @note Each sample bounds the primitive box transformed by every joint of its skin, which contains
+		/// any blend of them. A bucket unions the samples of itself and both neighbouring buckets, so motion
+		/// between samples is covered unless it leaves that window. Raise the rate for fast motion.
+		///
+		/// @param sample_rate Samples per second of animation time, must be positive
+		///
+		void precompute_skin_bounds(float sample_rate) noexcept;
+
+		///
+		/// @brief Get mesh optimization statistics, see `MeshStatistics::to_string`
+		///
+		/// @return Statistics of all meshes, empty if the model is loaded from a baked scene
+		///
+		const MeshStatistics& get_mesh_statistics() const noexcept { return mesh_statistics; }
 
 		///
 		/// @brief Get the list of animations
@@ -142,20 +284,31 @@ namespace gltf
 		///
 		std::span<const Animation> get_animations() const noexcept { return animations; }
 
+		///
+		/// @brief Find all nodes with a name
+		///
+		/// @param name Name of the nodes
+		/// @return Node indices in ascending order, empty if none
+		///
+		std::span<const uint32_t> find_nodes_by_name(std::string_view name) const noexcept
+		{
+			return node_names.find(name);
+		}
+
 		///
 		/// @brief Find a unique node by name
 		///
 		/// @param name Name of the node
 		/// @return If found and unique, the node index; otherwise, nullopt
 		///
-		std::optional<uint32_t> find_node_by_name(const std::string& name) const noexcept;
+		std::optional<uint32_t> find_node_by_name(std::string_view name) const noexcept;
 
 		///
 		/// @brief Get (node_index, Light) by name
 		///
 		/// @return If found, a (node_index, Light) pair
 		///
-		std::optional<std::pair<uint32_t, Light>> find_light_by_name(const std::string& name) const noexcept;
+		std::optional<std::pair<uint32_t, Light>> find_light_by_name(std::string_view name) const noexcept;
 
 	  private:
 
@@ -164,31 +317,45 @@ namespace gltf
 		// Compute parent indices for all nodes.
 		void compute_node_parents() noexcept;
 
-		// Compute topological order of nodes, must be called after `compute_node_parents()`.
+		// Compute topological order of nodes, grouped by depth level. Must be called after
+		// `compute_node_parents()`.
 		std::expected<void, util::Error> compute_topo_order() noexcept;
 
 		// Compute which nodes are renderable (children of root nodes). No loop checks are performed and must
 		// be called after `compute_topo_order()`.
 		void compute_renderable_nodes() noexcept;
 
+		// Initialize the persistent transform state and the drawcall layout of renderable nodes, must be
+		// called after `compute_renderable_nodes()`.
+		void init_transform_state() noexcept;
+
+		// Compute all accelerating structures, must be called once after construction
+		std::expected<void, util::Error> postprocess() noexcept;
+
 		/*===== Render Stage =====*/
 
-		// Compute node transform overrides from animation keys
-		std::vector<Node::TransformOverride> compute_node_overrides(
-			std::span<const AnimationKey> animation
-		) const noexcept;
+		// Compute node transform overrides from animation keys, and mark nodes whose overrides changed
+		void update_node_overrides(std::span<const AnimationKey> animation) noexcept;
 
-		// Compute world matrices for all nodes
-		std::vector<glm::mat4> compute_node_world_matrices(
-			const glm::mat4& model_transform,
-			std::span<const Node::TransformOverride> node_overrides
-		) const noexcept;
+		// Propagate dirty flags down the hierarchy level by level, and recompute world matrices of dirty
+		// nodes. Local matrices are composed in batches from the SoA transform store.
+		void update_node_world_matrices(const glm::mat4& model_transform) noexcept;
+
+		// Get the precomputed bounds table of the current frame, if a single animation sets the pose. Null
+		// otherwise, see `precompute_skin_bounds`
+		const SkinBoundTable* find_skin_bound_table() const noexcept;
+
+		// Recompute transforms and bounds of drawcalls belonging to dirty nodes, and refit the culling
+		// hierarchy over them. Rigged bounds are looked up in `skin_bound_table` if given, and read from
+		// `skin_bounds` otherwise, which must then be up to date.
+		void update_drawcalls(const SkinBoundTable* skin_bound_table) noexcept;
 
-		// Generate drawcalls from world matrices
-		std::vector<PrimitiveDrawcall> compute_drawcalls(
-			const std::vector<glm::mat4>& node_world_matrices,
+		// Collect drawcalls of visible nodes from the cached drawcalls, allocating from `resource`. Also
+		// returns the position of each cached drawcall in the list, see `Drawdata::bvh_drawcall_indices`
+		std::pair<std::pmr::vector<PrimitiveDrawcall>, std::pmr::vector<uint32_t>> collect_drawcalls(
 			std::span<const std::pair<uint32_t, float>> emission_overrides,
-			std::span<const uint32_t> hidden_nodes
+			std::span<const uint32_t> hidden_nodes,
+			std::pmr::memory_resource* resource
 		) const noexcept;
 
 		Model(
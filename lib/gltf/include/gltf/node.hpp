@@ -33,6 +33,8 @@ namespace gltf
 			{
 				return translation.has_value() || rotation.has_value() || scale.has_value();
 			}
+
+			bool operator==(const TransformOverride&) const noexcept = default;
 		};
 
 		// Node transform, under its parent's coordinate system
@@ -8,6 +8,8 @@
 
 #include <SDL3/SDL_gpu.h>
 #include <glm/glm.hpp>
+#include <limits>
+#include <memory_resource>
 #include <tiny_gltf.h>
 
 namespace gltf
@@ -19,6 +21,13 @@ namespace gltf
 		uint32_t offset;
 	};
 
+	// World-space bounds of the joint positions of a skin
+	struct JointBounds
+	{
+		glm::vec3 position_min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 position_max = glm::vec3(std::numeric_limits<float>::lowest());
+	};
+
 	// Collection of skins
 	struct SkinList
 	{
@@ -30,8 +39,20 @@ namespace gltf
 
 		static std::expected<SkinList, util::Error> from_tinygltf(const tinygltf::Model& model) noexcept;
 
-		std::vector<glm::mat4> compute_joint_matrices(
-			const std::vector<glm::mat4>& node_world_matrices
+		///
+		/// @brief Compute joint matrices of all skins, and the bounds of each skin's joints in the same pass
+		/// @details Joint world matrices are read once for both outputs, and multiplied with the inverse bind
+		/// matrices by an AVX2 kernel when available. The bounds pass is skipped if `skin_bounds` is empty
+		///
+		/// @param node_world_matrices World matrices of all nodes
+		/// @param skin_bounds Output joint bounds, one per skin, or empty if not needed
+		/// @param resource Memory resource for the joint matrices
+		/// @return Joint matrices of all skins, indexed by `Skin::offset` plus joint index
+		///
+		std::pmr::vector<glm::mat4> compute_joint_matrices(
+			std::span<const glm::mat4> node_world_matrices,
+			std::span<JointBounds> skin_bounds,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
 		) const noexcept;
 
 		FORCE_INLINE Skin operator[](size_t idx) const noexcept
@@ -54,7 +75,7 @@ namespace gltf
 	///
 	struct DeferredSkinningResource
 	{
-		std::vector<glm::mat4> joint_matrices_data;
+		std::pmr::vector<glm::mat4> joint_matrices_data;
 
 		// Initialize at render time, see `prepare_gpu_buffers`
 		std::shared_ptr<gpu::TransferBuffer> upload_buffer = nullptr;
@@ -67,7 +88,7 @@ namespace gltf
 		///
 		/// @param joint_matrices_data Computed joint matrices data, see `Skin_list::compute_joint_matrices`
 		///
-		DeferredSkinningResource(std::vector<glm::mat4> joint_matrices_data) :
+		DeferredSkinningResource(std::pmr::vector<glm::mat4> joint_matrices_data) :
 			joint_matrices_data(std::move(joint_matrices_data))
 		{}
 
@@ -2,12 +2,18 @@
 
 #include "gltf/detail/animation/channels.hpp"
 
+#include <cassert>
+#include <format>
+#include <ranges>
+#include <tuple>
+
 namespace gltf
 {
-	static std::expected<std::unique_ptr<detail::animation::Channel>, util::Error> parse_channel(
+	static std::expected<void, util::Error> parse_channel(
 		const tinygltf::Model& model,
 		const tinygltf::AnimationChannel& channel,
-		const tinygltf::AnimationSampler& sampler
+		const tinygltf::AnimationSampler& sampler,
+		detail::animation::Channels& channels
 	) noexcept
 	{
 		/* Check Target Index */
@@ -24,30 +30,26 @@ namespace gltf
 		{
 			auto sampler_result = detail::animation::Sampler<glm::vec3>::from_tinygltf(model, sampler);
 			if (!sampler_result) return sampler_result.error().forward("Parse translation sampler failed");
-			return std::make_unique<detail::animation::TranslationChannel>(
-				target_node,
-				std::move(*sampler_result)
-			);
+			channels.translation.push_back(target_node, std::move(*sampler_result));
 		}
 		else if (channel_target == "rotation")
 		{
 			auto sampler_result = detail::animation::Sampler<glm::quat>::from_tinygltf(model, sampler);
 			if (!sampler_result) return sampler_result.error().forward("Parse rotation sampler failed");
-			return std::make_unique<detail::animation::RotationChannel>(
-				target_node,
-				std::move(*sampler_result)
-			);
+			channels.rotation.push_back(target_node, std::move(*sampler_result));
 		}
 		else if (channel_target == "scale")
 		{
 			auto sampler_result = detail::animation::Sampler<glm::vec3>::from_tinygltf(model, sampler);
 			if (!sampler_result) return sampler_result.error().forward("Parse scale sampler failed");
-			return std::make_unique<detail::animation::ScaleChannel>(target_node, std::move(*sampler_result));
+			channels.scale.push_back(target_node, std::move(*sampler_result));
 		}
 		else
 			return util::Error(
 				std::format("Unknown or unsupported animation channel target path: {}", channel_target)
 			);
+
+		return {};
 	}
 
 	std::expected<Animation, util::Error> Animation::from_tinygltf(
@@ -55,8 +57,7 @@ namespace gltf
 		const tinygltf::Animation& animation
 	) noexcept
 	{
-		std::vector<std::unique_ptr<detail::animation::Channel>> channels;
-		channels.reserve(animation.channels.size());
+		detail::animation::Channels channels;
 
 		for (const auto& channel : animation.channels)
 		{
@@ -64,10 +65,9 @@ namespace gltf
 			if (sampler_index < 0 || std::cmp_greater_equal(sampler_index, animation.samplers.size()))
 				return util::Error("Invalid sampler index for animation channel");
 
-			auto channel_result = parse_channel(model, channel, animation.samplers[sampler_index]);
-			if (!channel_result) return channel_result.error().forward("Parse animation channel failed");
-
-			channels.push_back(std::move(*channel_result));
+			const auto& sampler = animation.samplers[sampler_index];
+			if (auto result = parse_channel(model, channel, sampler, channels); !result)
+				return result.error().forward("Parse animation channel failed");
 		}
 
 		return Animation(
@@ -76,8 +76,151 @@ namespace gltf
 		);
 	}
 
+	// Read a channel written by `ChannelGroup::bake`
+	static std::expected<void, util::Error> read_baked_channel(
+		detail::bake::Reader& reader,
+		size_t node_count,
+		detail::animation::Channels& channels
+	) noexcept
+	{
+		using namespace detail::animation;
+
+		const auto path = reader.read<ChannelPath>();
+		if (!path) return path.error().forward("Read channel path failed");
+
+		const auto target_node = reader.read<uint32_t>();
+		if (!target_node) return target_node.error().forward("Read channel target failed");
+		if (*target_node >= node_count) return util::Error("Invalid target node index for animation channel");
+
+		switch (*path)
+		{
+		case ChannelPath::Translation:
+		{
+			auto sampler_result = Sampler<glm::vec3>::from_baked(reader);
+			if (!sampler_result) return sampler_result.error().forward("Read translation sampler failed");
+			channels.translation.push_back(*target_node, std::move(*sampler_result));
+			return {};
+		}
+		case ChannelPath::Rotation:
+		{
+			auto sampler_result = Sampler<glm::quat>::from_baked(reader);
+			if (!sampler_result) return sampler_result.error().forward("Read rotation sampler failed");
+			channels.rotation.push_back(*target_node, std::move(*sampler_result));
+			return {};
+		}
+		case ChannelPath::Scale:
+		{
+			auto sampler_result = Sampler<glm::vec3>::from_baked(reader);
+			if (!sampler_result) return sampler_result.error().forward("Read scale sampler failed");
+			channels.scale.push_back(*target_node, std::move(*sampler_result));
+			return {};
+		}
+		default:
+			return util::Error("Unknown animation channel path in baked data");
+		}
+	}
+
+	std::expected<Animation, util::Error> Animation::from_baked(
+		detail::bake::Reader& reader,
+		size_t node_count
+	) noexcept
+	{
+		auto name = reader.read_optional_string();
+		if (!name) return name.error().forward("Read animation name failed");
+
+		const auto channel_count = reader.read<uint64_t>();
+		if (!channel_count) return channel_count.error().forward("Read channel count failed");
+
+		detail::animation::Channels channels;
+
+		for (const auto idx : std::views::iota(0zu, *channel_count))
+		{
+			if (auto result = read_baked_channel(reader, node_count, channels); !result)
+				return result.error().forward(std::format("Read animation channel {} failed", idx));
+		}
+
+		return Animation(std::move(*name), std::move(channels));
+	}
+
+	void Animation::bake(detail::bake::Writer& writer) const noexcept
+	{
+		using detail::animation::ChannelPath;
+
+		writer.write_optional_string(name);
+		writer.write<uint64_t>(channels.size());
+
+		channels.translation.bake(writer, ChannelPath::Translation);
+		channels.rotation.bake(writer, ChannelPath::Rotation);
+		channels.scale.bake(writer, ChannelPath::Scale);
+	}
+
+	// Split cursors into the ranges of translation, rotation and scale channels, in that order
+	static std::tuple<std::span<uint32_t>, std::span<uint32_t>, std::span<uint32_t>> split_cursors(
+		const detail::animation::Channels& channels,
+		std::span<uint32_t> cursors
+	) noexcept
+	{
+		assert(cursors.size() == channels.size());
+
+		return {
+			cursors.first(channels.translation.size()),
+			cursors.subspan(channels.translation.size(), channels.rotation.size()),
+			cursors.last(channels.scale.size())
+		};
+	}
+
 	void Animation::apply(std::span<Node::TransformOverride> overrides, float time) const noexcept
 	{
-		for (const auto& channel : channels) channel->apply(overrides, time);
+		std::vector<uint32_t> cursors(channels.size(), 0);
+		apply(overrides, time, cursors);
+	}
+
+	void Animation::apply(
+		std::span<Node::TransformOverride> overrides,
+		float time,
+		std::span<uint32_t> cursors
+	) const noexcept
+	{
+		const auto [translation_cursors, rotation_cursors, scale_cursors] = split_cursors(channels, cursors);
+
+		channels.translation.evaluate(time, translation_cursors, [overrides](uint32_t node, glm::vec3 value) {
+			overrides[node].translation = value;
+		});
+		channels.rotation.evaluate(time, rotation_cursors, [overrides](uint32_t node, glm::quat value) {
+			overrides[node].rotation = value;
+		});
+		channels.scale.evaluate(time, scale_cursors, [overrides](uint32_t node, glm::vec3 value) {
+			overrides[node].scale = value;
+		});
+	}
+
+	void Animation::blend(
+		std::span<Node::TransformOverride> overrides,
+		std::span<const Node> nodes,
+		float time,
+		float weight,
+		std::span<uint32_t> cursors
+	) const noexcept
+	{
+		const auto [translation_cursors, rotation_cursors, scale_cursors] = split_cursors(channels, cursors);
+
+		// Matrix nodes are blended from identity, consistent with `Node::get_local_transform`
+		const auto base_transform = [nodes](uint32_t node) {
+			const auto* transform = std::get_if<Node::Transform>(&nodes[node].transform);
+			return transform != nullptr ? *transform : Node::Transform();
+		};
+
+		channels.translation.evaluate(time, translation_cursors, [&](uint32_t node, glm::vec3 value) {
+			auto& target = overrides[node].translation;
+			target = glm::mix(target.value_or(base_transform(node).translation), value, weight);
+		});
+		channels.rotation.evaluate(time, rotation_cursors, [&](uint32_t node, glm::quat value) {
+			auto& target = overrides[node].rotation;
+			target = glm::slerp(target.value_or(base_transform(node).rotation), value, weight);
+		});
+		channels.scale.evaluate(time, scale_cursors, [&](uint32_t node, glm::vec3 value) {
+			auto& target = overrides[node].scale;
+			target = glm::mix(target.value_or(base_transform(node).scale), value, weight);
+		});
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,62 @@
+#include "gltf/detail/bake/stream.hpp"
+
+#include <cassert>
+
+namespace gltf::detail::bake
+{
+	void Writer::write_string(const std::string& str) noexcept
+	{
+		write<uint64_t>(str.size());
+		buffer.append_range(util::as_bytes(str));
+	}
+
+	void Writer::write_optional_string(const std::optional<std::string>& str) noexcept
+	{
+		write<uint8_t>(str.has_value() ? 1 : 0);
+		if (str.has_value()) write_string(*str);
+	}
+
+	void Writer::align() noexcept
+	{
+		buffer.resize((buffer.size() + array_alignment - 1) / array_alignment * array_alignment);
+	}
+
+	std::expected<std::span<const std::byte>, util::Error> Reader::take(size_t size) noexcept
+	{
+		assert(reinterpret_cast<uintptr_t>(data.data()) % array_alignment == 0);
+
+		if (size > data.size() - offset) return util::Error("Unexpected end of baked data");
+
+		const auto bytes = data.subspan(offset, size);
+		offset += size;
+		return bytes;
+	}
+
+	std::expected<std::string, util::Error> Reader::read_string() noexcept
+	{
+		const auto size = read<uint64_t>();
+		if (!size) return size.error();
+
+		return take(*size).transform([](std::span<const std::byte> bytes) {
+			return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		});
+	}
+
+	std::expected<std::optional<std::string>, util::Error> Reader::read_optional_string() noexcept
+	{
+		const auto has_value = read<uint8_t>();
+		if (!has_value) return has_value.error();
+		if (*has_value == 0) return std::nullopt;
+
+		return read_string().transform([](std::string str) { return std::optional(std::move(str)); });
+	}
+
+	std::expected<void, util::Error> Reader::align() noexcept
+	{
+		const auto aligned = (offset + array_alignment - 1) / array_alignment * array_alignment;
+		if (aligned > data.size()) return util::Error("Unexpected end of baked data");
+
+		offset = aligned;
+		return {};
+	}
+}
@@ -3,10 +3,14 @@
 #include "gltf/detail/mesh/topology.hpp"
 
 #include "util/find.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <meshoptimizer.h>
 
 namespace gltf::detail::mesh
 {
-	std::expected<std::vector<glm::vec3>, util::Error> get_raw_positions(
+	std::expected<AccessorView<glm::vec3>, util::Error> get_raw_positions(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept
@@ -18,7 +22,7 @@ namespace gltf::detail::mesh
 		if (std::cmp_greater_equal(position_accessor_idx->get(), model.accessors.size()))
 			return util::Error("Primitive POSITION accessor index out of bounds");
 
-		return extract_from_accessor<glm::vec3>(model, model.accessors[*position_accessor_idx]);
+		return view_accessor<glm::vec3>(model, model.accessors[*position_accessor_idx]);
 	}
 
 	std::expected<std::vector<glm::u32vec4>, util::Error> get_raw_joint_indices(
@@ -40,13 +44,13 @@ namespace gltf::detail::mesh
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
 			return extract_from_accessor<glm::u32vec4>(model, accessor);
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-			return extract_from_accessor<glm::u16vec4>(model, accessor)
-				.transform([](const std::vector<glm::u16vec4>& indices) {
+			return view_accessor<glm::u16vec4>(model, accessor)
+				.transform([](AccessorView<glm::u16vec4> indices) {
 					return std::vector<glm::u32vec4>(std::from_range, indices);
 				});
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-			return extract_from_accessor<glm::u8vec4>(model, accessor)
-				.transform([](const std::vector<glm::u8vec4>& indices) {
+			return view_accessor<glm::u8vec4>(model, accessor)
+				.transform([](AccessorView<glm::u8vec4> indices) {
 					return std::vector<glm::u32vec4>(std::from_range, indices);
 				});
 		default:
@@ -54,7 +58,7 @@ namespace gltf::detail::mesh
 		}
 	}
 
-	std::expected<std::vector<glm::vec4>, util::Error> get_raw_joint_weights(
+	std::expected<AccessorView<glm::vec4>, util::Error> get_raw_joint_weights(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept
@@ -66,10 +70,10 @@ namespace gltf::detail::mesh
 		if (std::cmp_greater_equal(joint_weights_accessor_idx->get(), model.accessors.size()))
 			return util::Error("Primitive WEIGHTS_0 accessor index out of bounds");
 
-		return extract_from_accessor<glm::vec4>(model, model.accessors[*joint_weights_accessor_idx]);
+		return view_accessor<glm::vec4>(model, model.accessors[*joint_weights_accessor_idx]);
 	}
 
-	std::expected<std::optional<std::vector<glm::vec3>>, util::Error> get_raw_normals(
+	std::expected<std::optional<AccessorView<glm::vec3>>, util::Error> get_raw_normals(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept
@@ -81,10 +85,11 @@ namespace gltf::detail::mesh
 		if (std::cmp_greater_equal(normal_accessor_idx->get(), model.accessors.size()))
 			return util::Error("Primitive NORMAL accessor index out of bounds");
 
-		return extract_from_accessor<glm::vec3>(model, model.accessors[*normal_accessor_idx]);
+		return view_accessor<glm::vec3>(model, model.accessors[*normal_accessor_idx])
+			.transform([](AccessorView<glm::vec3> view) { return std::optional(view); });
 	}
 
-	std::expected<std::vector<glm::vec2>, util::Error> get_raw_texcoords(
+	std::expected<AccessorView<glm::vec2>, util::Error> get_raw_texcoords(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive,
 		const std::string& texcoord_name
@@ -99,7 +104,7 @@ namespace gltf::detail::mesh
 		if (std::cmp_greater_equal(texcoord_accessor_idx->get(), model.accessors.size()))
 			return util::Error("Primitive " + texcoord_name + " accessor index out of bounds");
 
-		return extract_from_accessor<glm::vec2>(model, model.accessors[*texcoord_accessor_idx]);
+		return view_accessor<glm::vec2>(model, model.accessors[*texcoord_accessor_idx]);
 	}
 
 	static std::vector<glm::vec3> calc_normal(const std::vector<glm::vec3>& position_vertices) noexcept
@@ -155,13 +160,13 @@ namespace gltf::detail::mesh
 		}
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
 		{
-			auto result = extract_from_accessor<uint16_t>(model, model.accessors[primitive.indices]);
+			const auto result = view_accessor<uint16_t>(model, model.accessors[primitive.indices]);
 			if (!result) return result.error().forward("Extract uint16_t index data failed");
 			return std::optional(std::vector<uint32_t>(std::from_range, *result));
 		}
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
 		{
-			auto result = extract_from_accessor<uint8_t>(model, model.accessors[primitive.indices]);
+			const auto result = view_accessor<uint8_t>(model, model.accessors[primitive.indices]);
 			if (!result) return result.error().forward("Extract uint8_t index data failed");
 			return std::optional(std::vector<uint32_t>(std::from_range, *result));
 		}
@@ -189,7 +194,8 @@ namespace gltf::detail::mesh
 		if (!remapped_position_vertices)
 			return remapped_position_vertices.error().forward("Unpack POSITION from indices failed");
 
-		auto position_vertices_result = rearrange_vertices(*remapped_position_vertices, primitive.mode);
+		auto position_vertices_result =
+			rearrange_vertices(std::move(*remapped_position_vertices), primitive.mode);
 		if (!position_vertices_result)
 			return position_vertices_result.error().forward("Rearrange triangle POSITION data failed");
 
@@ -206,14 +212,14 @@ namespace gltf::detail::mesh
 		auto normal_raw_result = get_raw_normals(model, primitive);
 		if (!normal_raw_result) return normal_raw_result.error().forward("Get primitive NORMAL data failed");
 
-		auto normal_raw = std::move(*normal_raw_result);
+		const auto normal_raw = *normal_raw_result;
 		if (!normal_raw.has_value()) return calc_normal(position_vertices);
 
 		auto remapped_normal_vertices = unpack_from_indices(*normal_raw, index);
 		if (!remapped_normal_vertices)
 			return remapped_normal_vertices.error().forward("Unpack NORMAL from indices failed");
 
-		auto normal_vertices = rearrange_vertices(*remapped_normal_vertices, primitive.mode);
+		auto normal_vertices = rearrange_vertices(std::move(*remapped_normal_vertices), primitive.mode);
 
 		if (!normal_vertices) return normal_vertices.error().forward("Rearrange triangle NORMAL data failed");
 		if (normal_vertices->size() != position_vertices.size())
@@ -241,7 +247,8 @@ namespace gltf::detail::mesh
 				std::format("Unpack {} from indices failed", texcoord_name)
 			);
 
-		auto texcoord_vertices_result = rearrange_vertices(*remapped_texcoord_vertices, primitive.mode);
+		auto texcoord_vertices_result =
+			rearrange_vertices(std::move(*remapped_texcoord_vertices), primitive.mode);
 		if (!texcoord_vertices_result)
 			return texcoord_vertices_result.error().forward(
 				std::format("Rearrange triangle {} data failed", texcoord_name)
@@ -265,7 +272,7 @@ namespace gltf::detail::mesh
 			return remapped_joint_indices_vertices.error().forward("Unpack JOINTS_0 from indices failed");
 
 		auto joint_indices_vertices_result =
-			rearrange_vertices(*remapped_joint_indices_vertices, primitive.mode);
+			rearrange_vertices(std::move(*remapped_joint_indices_vertices), primitive.mode);
 		if (!joint_indices_vertices_result)
 			return joint_indices_vertices_result.error().forward("Rearrange triangle JOINTS_0 data failed");
 
@@ -287,15 +294,16 @@ namespace gltf::detail::mesh
 			return remapped_joint_weights_vertices.error().forward("Unpack WEIGHTS_0 from indices failed");
 
 		auto joint_weights_vertices_result =
-			rearrange_vertices(*remapped_joint_weights_vertices, primitive.mode);
+			rearrange_vertices(std::move(*remapped_joint_weights_vertices), primitive.mode);
 		if (!joint_weights_vertices_result)
 			return joint_weights_vertices_result.error().forward("Rearrange triangle WEIGHTS_0 data failed");
 
 		return std::move(*joint_weights_vertices_result);
 	}
 
-	std::expected<std::vector<glm::vec3>, util::Error> compute_tangents(
+	std::expected<std::vector<glm::vec4>, util::Error> compute_tangents(
 		const std::vector<glm::vec3>& position_vertices,
+		const std::vector<glm::vec3>& normal_vertices,
 		const std::vector<glm::vec2>& texcoord0_vertices
 	) noexcept
 	{
@@ -308,32 +316,128 @@ namespace gltf::detail::mesh
 				)
 			);
 
+		if (position_vertices.size() != normal_vertices.size())
+			return util::Error(
+				std::format(
+					"POSITION vertex count ({}) does not match NORMAL vertex count ({})",
+					position_vertices.size(),
+					normal_vertices.size()
+				)
+			);
+
 		if (position_vertices.size() % 3 != 0)
 			return util::Error("Vertex count is not a multiple of 3, cannot compute tangents for triangles");
 
-		if (texcoord0_vertices.size() % 3 != 0)
-			return util::Error("Vertex count is not a multiple of 3, cannot compute tangents for triangles");
+		/* Weld Identical Corners */
+
+		const std::array streams = {
+			meshopt_Stream{position_vertices.data(), sizeof(glm::vec3), sizeof(glm::vec3)},
+			meshopt_Stream{normal_vertices.data(), sizeof(glm::vec3), sizeof(glm::vec3)},
+			meshopt_Stream{texcoord0_vertices.data(), sizeof(glm::vec2), sizeof(glm::vec2)},
+		};
+
+		std::vector<uint32_t> remap(position_vertices.size());
+		const auto vertex_count = meshopt_generateVertexRemapMulti(
+			remap.data(),
+			nullptr,
+			position_vertices.size(),
+			position_vertices.size(),
+			streams.data(),
+			streams.size()
+		);
+
+		std::vector<glm::vec3> positions(vertex_count), normals(vertex_count);
+		std::vector<glm::vec2> texcoords(vertex_count);
+		const auto remap_attribute = [&remap]<typename T>(std::vector<T>& dst, const std::vector<T>& src) {
+			meshopt_remapVertexBuffer(dst.data(), src.data(), src.size(), sizeof(T), remap.data());
+		};
+		remap_attribute(positions, position_vertices);
+		remap_attribute(normals, normal_vertices);
+		remap_attribute(texcoords, texcoord0_vertices);
+
+		// The remap table of an unindexed list is the index list into the welded vertices
+		return compute_smooth_tangents(positions, normals, texcoords, remap);
+	}
 
-		std::vector<glm::vec3> tangents;
-		tangents.reserve(position_vertices.size());
+	// Any unit vector perpendicular to `normal`
+	static glm::vec3 perpendicular_tangent(const glm::vec3& normal) noexcept
+	{
+		const auto axis =
+			std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		return glm::normalize(axis - normal * glm::dot(normal, axis));
+	}
+
+	std::vector<glm::vec4> compute_smooth_tangents(
+		std::span<const glm::vec3> positions,
+		std::span<const glm::vec3> normals,
+		std::span<const glm::vec2> texcoords,
+		std::span<const uint32_t> indices
+	) noexcept
+	{
+		const auto face_count = indices.size() / 3;
 
-		for (const auto tri : std::views::zip(position_vertices, texcoord0_vertices) | std::views::chunk(3))
+		// Accumulated tangent of each vertex, [2 * vertex] for positive UV winding and [2 * vertex + 1] for
+		// mirrored UV winding, so that mirrored triangles never cancel each other out
+		std::vector<glm::vec3> accumulated(positions.size() * 2, glm::vec3(0.0f));
+		std::vector<uint8_t> face_mirrored(face_count, 0);
+
+		for (const auto face : std::views::iota(0zu, face_count))
 		{
-			auto tangent = calc_tangent(
-				std::get<0>(tri[0]),
-				std::get<0>(tri[1]),
-				std::get<0>(tri[2]),
-				std::get<1>(tri[0]),
-				std::get<1>(tri[1]),
-				std::get<1>(tri[2])
-			);
+			const auto tri = indices.subspan(face * 3, 3);
+			const std::array<glm::vec3, 3> pos = {positions[tri[0]], positions[tri[1]], positions[tri[2]]};
+			const std::array<glm::vec2, 3> uv = {texcoords[tri[0]], texcoords[tri[1]], texcoords[tri[2]]};
+
+			// Degenerate UVs or positions, the corners take the tangent of their neighbours
+			const auto face_tangent = calc_tangent(pos[0], pos[1], pos[2], uv[0], uv[1], uv[2]);
+			if (glm::isnan(face_tangent) != glm::bvec3(false)) continue;
+
+			face_mirrored[face] = glm::determinant(glm::mat2(uv[1] - uv[0], uv[2] - uv[0])) < 0.0f ? 1 : 0;
+
+			for (const auto corner : std::views::iota(0zu, 3zu))
+			{
+				const auto normal = glm::normalize(normals[tri[corner]]);
+				const auto projected = face_tangent - normal * glm::dot(normal, face_tangent);
+				const auto projected_length = glm::length(projected);
+				if (!(projected_length > 1e-6f)) continue;
+
+				// Weighted by the corner angle, so that the result doesn't depend on the triangulation
+				const auto edge0 = glm::normalize(pos[(corner + 1) % 3] - pos[corner]);
+				const auto edge1 = glm::normalize(pos[(corner + 2) % 3] - pos[corner]);
+				const auto angle = std::acos(std::clamp(glm::dot(edge0, edge1), -1.0f, 1.0f));
+				if (std::isnan(angle)) continue;
+
+				accumulated[tri[corner] * 2 + face_mirrored[face]] += projected / projected_length * angle;
+			}
+		}
 
-			// Degenerate UVs, fallback to position-based tangent
-			if (glm::isnan(tangent) != glm::bvec3(false)) tangent = std::get<0>(tri[1]) - std::get<0>(tri[0]);
+		std::vector<glm::vec4> tangents;
+		tangents.reserve(indices.size());
 
-			tangents.push_back(tangent);
-			tangents.push_back(tangent);
-			tangents.push_back(tangent);
+		for (const auto corner : std::views::iota(0zu, indices.size()))
+		{
+			const auto vertex = indices[corner];
+			auto mirrored = face_mirrored[corner / 3];
+
+			// A degenerate corner borrowing the other winding's tangent also takes its bitangent sign
+			auto tangent = accumulated[vertex * 2 + mirrored];
+			if (!(glm::length(tangent) > 1e-6f))
+			{
+				mirrored = 1 - mirrored;
+				tangent = accumulated[vertex * 2 + mirrored];
+			}
+
+			if (glm::length(tangent) > 1e-6f)
+				tangent = glm::normalize(tangent);
+			else
+			{
+				mirrored = face_mirrored[corner / 3];
+				tangent = perpendicular_tangent(glm::normalize(normals[vertex]));
+			}
+
+			if (glm::isnan(tangent) != glm::bvec3(false)) tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+
+			// Bitangent sign as in glTF TANGENT.w, bitangent = cross(normal, tangent) * w
+			tangents.emplace_back(tangent, mirrored != 0 ? -1.0f : 1.0f);
 		}
 
 		return tangents;
@@ -1,6 +1,9 @@
 #include "gltf/detail/mesh/raw-primitive-list.hpp"
 #include "gltf/detail/mesh/data.hpp"
 
+#include <algorithm>
+#include <format>
+#include <limits>
 #include <ranges>
 
 namespace gltf::detail::mesh
@@ -61,7 +64,7 @@ namespace gltf::detail::mesh
 
 		/* Get Tangent data */
 
-		auto tangent_result = compute_tangents(position_vertices, texcoord0_vertices);
+		auto tangent_result = compute_tangents(position_vertices, normal_vertices, texcoord0_vertices);
 		if (!tangent_result) return tangent_result.error().forward("Compute primitive TANGENT failed");
 		const auto tangent_vertices = std::move(*tangent_result);
 
@@ -129,7 +132,7 @@ namespace gltf::detail::mesh
 
 		/* Get Tangent data */
 
-		auto tangent_result = compute_tangents(position_vertices, texcoord0_vertices);
+		auto tangent_result = compute_tangents(position_vertices, normal_vertices, texcoord0_vertices);
 		if (!tangent_result) return tangent_result.error().forward("Compute primitive TANGENT failed");
 		const auto tangent_vertices = std::move(*tangent_result);
 
@@ -182,4 +185,210 @@ namespace gltf::detail::mesh
 
 			| std::ranges::to<std::vector>();
 	}
+
+	// Two corners share a vertex above this tangent cosine, same threshold as `Vertex::operator==`
+	static constexpr float tangent_merge_threshold = 0.9999f;
+
+	// Whether two corner tangents are close enough to share a vertex, bitangent signs must match
+	static bool tangent_mergeable(const glm::vec4& a, const glm::vec4& b) noexcept
+	{
+		return a.w == b.w && glm::dot(glm::vec3(a), glm::vec3(b)) >= tangent_merge_threshold;
+	}
+
+	// Indexed triangle list on its original vertex set, with vertices split at tangent seams
+	struct IndexedBase
+	{
+		AccessorView<glm::vec3> positions;
+		AccessorView<glm::vec3> normals;
+		std::vector<glm::vec2> texcoords;
+
+		std::vector<uint32_t> source_vertices;  // Original vertex of each split vertex
+		std::vector<glm::vec4> tangents;        // Tangent and bitangent sign of each split vertex
+		std::vector<uint32_t> indices;          // Triangle list into the split vertices
+	};
+
+	static std::expected<std::optional<IndexedBase>, util::Error> get_indexed_base(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive,
+		bool placeholder_uv
+	) noexcept
+	{
+		if (primitive.mode != TINYGLTF_MODE_TRIANGLES) return std::nullopt;
+
+		/* Get Index, Position & Normal Data */
+
+		auto index_result = get_indices(model, primitive);
+		if (!index_result) return index_result.error().forward("Get index failed");
+		if (!index_result->has_value() || (*index_result)->empty()) return std::nullopt;
+		auto indices = std::move(**index_result);
+
+		auto normal_result = get_raw_normals(model, primitive);
+		if (!normal_result) return normal_result.error().forward("Get primitive NORMAL data failed");
+		if (!normal_result->has_value()) return std::nullopt;
+		const auto normals = **normal_result;
+
+		auto position_result = get_raw_positions(model, primitive);
+		if (!position_result) return position_result.error().forward("Get primitive POSITION data failed");
+		const auto positions = *position_result;
+
+		/* Validate */
+
+		if (normals.size() != positions.size())
+			return util::Error("NORMAL vertex count does not match POSITION vertex count");
+		if (indices.size() % 3 != 0)
+			return util::Error("Triangle primitive index count should be a multiple of 3");
+
+		const auto out_of_bounds = std::ranges::find_if(indices, [&positions](uint32_t index) {
+			return index >= positions.size();
+		});
+		if (out_of_bounds != indices.end())
+			return util::Error(
+				std::format(
+					"Index {} out of bounds at index_buffer[{}] (vertex count {})",
+					*out_of_bounds,
+					out_of_bounds - indices.begin(),
+					positions.size()
+				)
+			);
+
+		/* Get Texcoord0 Data */
+
+		auto texcoords =
+			get_raw_texcoords(model, primitive, "TEXCOORD_0")
+				.transform([](const AccessorView<glm::vec2>& view) { return view.to_vector(); })
+				.value_or(
+					placeholder_uv ? generate_placeholder_uv(positions.size())
+								   : std::vector<glm::vec2>(positions.size(), glm::vec2(0.0f, 0.0f))
+				);
+		if (texcoords.size() != positions.size())
+			return util::Error("TEXCOORD_0 vertex count does not match POSITION vertex count");
+
+		/* Split Tangent Seams */
+
+		// Smooth tangents and their bitangent signs only differ between corners of a vertex across UV mirror
+		// seams
+
+		const auto corner_tangents =
+			compute_smooth_tangents(positions.to_vector(), normals.to_vector(), texcoords, indices);
+
+		// Split vertices of each original vertex are chained through `next_split`
+		constexpr auto no_split = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> first_split(positions.size(), no_split);
+		std::vector<uint32_t> next_split;
+		std::vector<uint32_t> source_vertices;
+		std::vector<glm::vec4> tangents;
+
+		source_vertices.reserve(positions.size());
+		tangents.reserve(positions.size());
+		next_split.reserve(positions.size());
+
+		for (const auto corner : std::views::iota(0zu, indices.size()))
+		{
+			const auto source = indices[corner];
+			const auto& tangent = corner_tangents[corner];
+
+			auto split = first_split[source];
+			while (split != no_split && !tangent_mergeable(tangents[split], tangent))
+				split = next_split[split];
+
+			if (split == no_split)
+			{
+				split = static_cast<uint32_t>(source_vertices.size());
+				source_vertices.push_back(source);
+				tangents.push_back(tangent);
+				next_split.push_back(first_split[source]);
+				first_split[source] = split;
+			}
+
+			indices[corner] = split;
+		}
+
+		return IndexedBase{
+			.positions = positions,
+			.normals = normals,
+			.texcoords = std::move(texcoords),
+			.source_vertices = std::move(source_vertices),
+			.tangents = std::move(tangents),
+			.indices = std::move(indices)
+		};
+	}
+
+	std::expected<std::optional<IndexedVertexList<Vertex>>, util::Error> get_indexed_primitive_list(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive
+	) noexcept
+	{
+		auto base_result = get_indexed_base(model, primitive, true);
+		if (!base_result) return base_result.error().forward("Get indexed primitive data failed");
+		if (!base_result->has_value()) return std::nullopt;
+		auto& base = **base_result;
+
+		auto vertices =
+			std::views::zip_transform(
+				[&base](uint32_t source, const glm::vec4& tangent) {
+					return Vertex{
+						.position = base.positions[source],
+						.normal = glm::normalize(base.normals[source]),
+						.tangent = tangent,
+						.texcoord = base.texcoords[source],
+					};
+				},
+				base.source_vertices,
+				base.tangents
+			)
+			| std::ranges::to<std::vector>();
+
+		return IndexedVertexList<Vertex>{.vertices = std::move(vertices), .indices = std::move(base.indices)};
+	}
+
+	std::expected<std::optional<IndexedVertexList<RiggedVertex>>, util::Error>
+	get_indexed_rigged_primitive_list(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive
+	) noexcept
+	{
+		auto base_result = get_indexed_base(model, primitive, false);
+		if (!base_result) return base_result.error().forward("Get indexed primitive data failed");
+		if (!base_result->has_value()) return std::nullopt;
+		auto& base = **base_result;
+
+		/* Get Joint Data */
+
+		auto joint_indices_result = get_raw_joint_indices(model, primitive);
+		if (!joint_indices_result)
+			return joint_indices_result.error().forward("Get primitive JOINTS_0 data failed");
+		const auto joint_indices = std::move(*joint_indices_result);
+
+		auto joint_weights_result = get_raw_joint_weights(model, primitive);
+		if (!joint_weights_result)
+			return joint_weights_result.error().forward("Get primitive WEIGHTS_0 data failed");
+		const auto joint_weights = *joint_weights_result;
+
+		if (joint_indices.size() != base.positions.size() || joint_weights.size() != base.positions.size())
+			return util::Error("Joint attribute vertex counts do not match POSITION vertex count");
+
+		/* Assemble Primitive */
+
+		auto vertices =
+			std::views::zip_transform(
+				[&base, &joint_indices, &joint_weights](uint32_t source, const glm::vec4& tangent) {
+					return RiggedVertex{
+						.position = base.positions[source],
+						.normal = glm::normalize(base.normals[source]),
+						.tangent = tangent,
+						.texcoord = base.texcoords[source],
+						.joint_indices = joint_indices[source],
+						.joint_weights = joint_weights[source],
+					};
+				},
+				base.source_vertices,
+				base.tangents
+			)
+			| std::ranges::to<std::vector>();
+
+		return IndexedVertexList<RiggedVertex>{
+			.vertices = std::move(vertices),
+			.indices = std::move(base.indices)
+		};
+	}
 }
\ No newline at end of file
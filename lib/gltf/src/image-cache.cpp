@@ -0,0 +1,333 @@
+#include "gltf/image-cache.hpp"
+
+#include "util/as-byte.hpp"
+#include "util/file.hpp"
+#include "util/hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <ranges>
+#include <thread>
+
+namespace gltf
+{
+	namespace
+	{
+		constexpr std::array<char, 8> file_magic = {'B', 'C', 'M', 'I', 'P', 'C', 'H', '\0'};
+		constexpr uint32_t file_version = 1;
+		constexpr size_t data_alignment = 16;
+		constexpr auto file_extension = ".bcmip";
+
+		// Header at the start of each cache file
+		struct FileHeader
+		{
+			std::array<char, 8> magic;
+			uint32_t version;
+			uint32_t level_count;
+			ImageCache::Key key;
+		};
+
+		// Level table entry, follows the header
+		struct LevelHeader
+		{
+			uint32_t width;
+			uint32_t height;
+			uint64_t offset;  // Offset of level data from the start of the file
+			uint64_t size;    // Size of level data in bytes
+		};
+
+		static_assert(std::is_trivially_copyable_v<FileHeader> && std::is_trivially_copyable_v<LevelHeader>);
+
+		constexpr size_t align_up(size_t value) noexcept
+		{
+			return (value + data_alignment - 1) / data_alignment * data_alignment;
+		}
+
+		// Serialize a mipmap chain into the cache file layout
+		std::vector<std::byte> serialize(const ImageCache::Key& key, std::span<const image::BCImage> chain)
+		{
+			const size_t table_end = sizeof(FileHeader) + sizeof(LevelHeader) * chain.size();
+
+			std::vector<LevelHeader> levels;
+			levels.reserve(chain.size());
+
+			size_t offset = align_up(table_end);
+			for (const auto& level : chain)
+			{
+				const auto size = level.pixels.size() * sizeof(image::CompressionBlock);
+				levels.push_back(
+					{.width = level.size.x, .height = level.size.y, .offset = offset, .size = size}
+				);
+				offset = align_up(offset + size);
+			}
+
+			std::vector<std::byte> data(offset);
+
+			const FileHeader header{
+				.magic = file_magic,
+				.version = file_version,
+				.level_count = uint32_t(chain.size()),
+				.key = key
+			};
+			std::memcpy(data.data(), &header, sizeof(FileHeader));
+			std::memcpy(data.data() + sizeof(FileHeader), levels.data(), sizeof(LevelHeader) * levels.size());
+
+			for (const auto& [level, level_header] : std::views::zip(chain, levels))
+				std::ranges::copy(util::as_bytes(level.pixels), data.begin() + level_header.offset);
+
+			return data;
+		}
+
+		// Parse and validate a cache file, returning views of the level data
+		std::optional<std::vector<graphics::ImageData>> parse(
+			std::span<const std::byte> data,
+			const ImageCache::Key& key
+		) noexcept
+		{
+			if (data.size() < sizeof(FileHeader)) return std::nullopt;
+
+			FileHeader header;
+			std::memcpy(&header, data.data(), sizeof(FileHeader));
+
+			if (header.magic != file_magic || header.version != file_version || header.key != key)
+				return std::nullopt;
+			if (header.level_count == 0
+				|| data.size() < sizeof(FileHeader) + sizeof(LevelHeader) * header.level_count)
+				return std::nullopt;
+
+			std::vector<graphics::ImageData> levels;
+			levels.reserve(header.level_count);
+
+			for (const auto idx : std::views::iota(0u, header.level_count))
+			{
+				LevelHeader level;
+				std::memcpy(
+					&level,
+					data.data() + sizeof(FileHeader) + sizeof(LevelHeader) * idx,
+					sizeof(LevelHeader)
+				);
+
+				const auto expected_size =
+					uint64_t(level.width / 4) * uint64_t(level.height / 4) * sizeof(image::CompressionBlock);
+
+				if (level.width % 4 != 0 || level.height % 4 != 0 || level.size != expected_size)
+					return std::nullopt;
+				if (level.offset % data_alignment != 0 || level.offset > data.size()
+					|| level.size > data.size() - level.offset)
+					return std::nullopt;
+
+				levels.push_back(
+					{.size = {level.width, level.height}, .pixels = data.subspan(level.offset, level.size)}
+				);
+			}
+
+			return levels;
+		}
+
+		// Cache file found in a directory scan
+		struct FileInfo
+		{
+			std::filesystem::path path;
+			uint64_t size;
+			std::filesystem::file_time_type time;
+		};
+
+		// List all cache files in a directory, skipping ones that can't be queried
+		std::vector<FileInfo> list_files(const std::filesystem::path& directory) noexcept
+		{
+			std::vector<FileInfo> files;
+
+			std::error_code ec;
+			for (const auto& dir_entry : std::filesystem::directory_iterator(directory, ec))
+			{
+				if (!dir_entry.is_regular_file(ec) || dir_entry.path().extension() != file_extension)
+					continue;
+
+				const auto size = dir_entry.file_size(ec);
+				if (ec) continue;
+				const auto time = dir_entry.last_write_time(ec);
+				if (ec) continue;
+
+				files.push_back({.path = dir_entry.path(), .size = size, .time = time});
+			}
+
+			return files;
+		}
+	}
+
+	ImageCache::Key ImageCache::Key::from_image(
+		const tinygltf::Image& image,
+		Usage usage,
+		uint32_t compress_mode,
+		bool srgb
+	) noexcept
+	{
+		const std::array<int, 5> layout =
+			{image.width, image.height, image.component, image.bits, image.pixel_type};
+
+		const auto content_hash = util::hash_bytes(
+			util::as_bytes(image.image),
+			util::hash_bytes(util::as_bytes(layout))
+		);
+
+		return {
+			.content_hash = content_hash,
+			.encoder_version = image::compress_encoder_version,
+			.usage = usage,
+			.compress_mode = compress_mode,
+			.srgb = srgb ? 1u : 0u
+		};
+	}
+
+	std::expected<std::shared_ptr<ImageCache>, util::Error> ImageCache::create(
+		const std::filesystem::path& directory,
+		uint64_t max_size
+	) noexcept
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(directory, ec);
+		if (ec)
+			return util::Error(
+				std::format("Create cache directory '{}' failed: {}", directory.string(), ec.message())
+			);
+
+		const auto total_size = std::ranges::fold_left(
+			list_files(directory) | std::views::transform(&FileInfo::size),
+			uint64_t(0),
+			std::plus()
+		);
+
+		auto cache = std::shared_ptr<ImageCache>(new ImageCache(directory, max_size, total_size));
+		cache->update_size(0, 0);
+
+		return cache;
+	}
+
+	std::filesystem::path ImageCache::entry_path(const Key& key) const noexcept
+	{
+		return directory / std::format("{:016x}{}", util::hash_bytes(util::as_bytes(key)), file_extension);
+	}
+
+	std::optional<ImageCache::Entry> ImageCache::load(const Key& key) noexcept
+	{
+		const auto path = entry_path(key);
+
+		std::optional<util::MappedFile> file;
+		if (auto open_result = util::MappedFile::open(path); open_result)
+			file.emplace(std::move(*open_result));
+		else
+		{
+			misses++;
+			return std::nullopt;
+		}
+
+		auto levels = parse(file->data(), key);
+		if (!levels)
+		{
+			misses++;
+
+			// Release the mapping first, so that the corrupted file can be removed on every platform
+			const auto file_size = file->data().size();
+			file.reset();
+			std::error_code ec;
+			if (std::filesystem::remove(path, ec)) update_size(0, file_size);
+
+			return std::nullopt;
+		}
+
+		hits++;
+
+		// Refresh modification time, eviction is least-recently-used
+		std::error_code ec;
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+		return Entry{.file = std::move(*file), .levels = std::move(*levels)};
+	}
+
+	std::expected<void, util::Error> ImageCache::store(
+		const Key& key,
+		std::span<const image::BCImage> mipmap_chain
+	) noexcept
+	{
+		if (mipmap_chain.empty()) return util::Error("Empty mipmap chain");
+
+		const auto path = entry_path(key);
+
+		// Write to a temporary file then rename, so that concurrent readers never observe partial files
+		auto temp_path = path;
+		temp_path += std::format(".{}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+		uint64_t entry_size;
+
+		try
+		{
+			const auto data = serialize(key, mipmap_chain);
+			entry_size = data.size();
+
+			if (const auto result = util::write_file(temp_path, data); !result)
+				return result.error().forward("Write cache entry failed");
+		}
+		catch (const std::bad_alloc&)
+		{
+			return util::Error("Allocate cache entry failed");
+		}
+
+		// An existing entry of the same key is replaced
+		std::error_code ec;
+		const auto replaced_size = std::filesystem::file_size(path, ec);
+
+		std::filesystem::rename(temp_path, path, ec);
+		if (ec)
+		{
+			std::filesystem::remove(temp_path, ec);
+			return util::Error(std::format("Rename cache entry '{}' failed", path.string()));
+		}
+
+		update_size(entry_size, replaced_size == std::uintmax_t(-1) ? 0 : replaced_size);
+
+		return {};
+	}
+
+	ImageCache::Stats ImageCache::get_stats() const noexcept
+	{
+		return {.hits = hits.load(), .misses = misses.load(), .evictions = evictions.load()};
+	}
+
+	void ImageCache::update_size(uint64_t added_size, uint64_t removed_size) noexcept
+	{
+		std::scoped_lock lock(size_mutex);
+
+		total_size = total_size + added_size - std::min(removed_size, total_size + added_size);
+		if (total_size > max_size) evict();
+	}
+
+	void ImageCache::evict() noexcept
+	{
+		// Rescan rather than trusting the tracked size, which drifts if other processes share the directory
+		auto files = list_files(directory);
+		total_size = std::ranges::fold_left(
+			files | std::views::transform(&FileInfo::size),
+			uint64_t(0),
+			std::plus()
+		);
+
+		const auto target_size = uint64_t(double(max_size) * evict_target_ratio);
+		if (total_size <= max_size) return;
+
+		std::ranges::sort(files, std::less{}, &FileInfo::time);
+
+		std::error_code ec;
+		for (const auto& file : files)
+		{
+			if (total_size <= target_size) break;
+
+			if (std::filesystem::remove(file.path, ec))
+			{
+				total_size -= file.size;
+				evictions++;
+			}
+		}
+	}
+}
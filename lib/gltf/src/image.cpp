@@ -1,213 +1,201 @@
 #include "gltf/image.hpp"
+#include "gltf/image-cache.hpp"
 
 #include "graphics/util/quick-create.hpp"
 #include "image/algo/mipmap.hpp"
 #include "image/compress.hpp"
+#include "util/as-byte.hpp"
 
 #include "gltf/detail/image/check.hpp"
 #include "gltf/detail/image/extract.hpp"
 
+#include <ranges>
+
 namespace gltf
 {
 	using namespace detail::image;
 
-	static auto create_texture_from_mipmap_fn(
-		SDL_GPUDevice* device,
+	// Wrap a mipmap chain into texture data, taking ownership of the pixels
+	template <typename T>
+	static TextureData make_texture_data(
 		SDL_GPUTextureFormat format,
-		const std::string& name
+		std::vector<image::ImageContainer<T>> mipmap_chain
 	) noexcept
 	{
-		return [device, format, name](const auto& mipmap) -> std::expected<gpu::Texture, util::Error> {
-			return graphics::create_texture_from_mipmap(
-				device,
-				gpu::Texture::Format{
-					.type = SDL_GPU_TEXTURETYPE_2D,
-					.format = format,
-					.usage = {.sampler = true}
-				},
-				mipmap,
-				name
-			);
-		};
+		auto storage = std::make_shared<std::vector<image::ImageContainer<T>>>(std::move(mipmap_chain));
+
+		auto levels =
+			*storage
+			| std::views::transform([](const image::ImageContainer<T>& level) {
+				  return graphics::ImageData{.size = level.size, .pixels = util::as_bytes(level.pixels)};
+			  })
+			| std::ranges::to<std::vector>();
+
+		return {.format = format, .levels = std::move(levels), .storage = std::move(storage)};
 	}
 
+	// Wrap a single image into texture data without mipmaps, taking ownership of the pixels
 	template <typename T>
-	static std::function<std::expected<gpu::Texture, util::Error>(const image::ImageContainer<T>&)>
-	create_texture_from_image_fn(
-		SDL_GPUDevice* device,
-		SDL_GPUTextureFormat format,
-		const std::string& name
-	) noexcept
+	static TextureData make_texture_data(SDL_GPUTextureFormat format, image::ImageContainer<T> image) noexcept
 	{
-		return [device, format, name](const image::ImageContainer<T>& image) {
-			return graphics::create_texture_from_image(
-				device,
-				gpu::Texture::Format{
-					.type = SDL_GPU_TEXTURETYPE_2D,
-					.format = format,
-					.usage = {.sampler = true}
-				},
-				image,
-				name
-			);
-		};
+		std::vector<image::ImageContainer<T>> mipmap_chain;
+		mipmap_chain.push_back(std::move(image));
+		return make_texture_data(format, std::move(mipmap_chain));
 	}
 
-	static std::expected<gpu::Texture, util::Error> create_color_uncompressed(
-		SDL_GPUDevice* device,
+	static auto make_texture_data_fn(SDL_GPUTextureFormat format) noexcept
+	{
+		return [format](auto image_or_chain) { return make_texture_data(format, std::move(image_or_chain)); };
+	}
+
+	static std::expected<TextureData, util::Error> encode_color_uncompressed(
 		const tinygltf::Image& image,
-		bool srgb,
-		const std::string& name
+		bool srgb
 	) noexcept
 	{
 		return extract_u8_rgba(image)
 			.transform([](const auto& uncompressed_image) {
 				return image::generate_mipmap(uncompressed_image);
 			})
-			.and_then(create_texture_from_mipmap_fn(
-				device,
-				srgb ? SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
-				name
+			.transform(make_texture_data_fn(
+				srgb ? SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM
 			))
 			.transform_error(util::Error::forward_fn());
 	}
 
-	static std::expected<gpu::Texture, util::Error> create_color_bc3(
-		SDL_GPUDevice* device,
+	using CompressFunc = std::expected<image::BCImage, util::Error> (*)(
+		const image::Image<image::Precision::U8, image::Format::RGBA>&
+	) noexcept;
+
+	// Compress an RGBA8 image into a BCn mipmap chain, non power-of-two images are not mipmapped
+	static std::expected<std::vector<image::BCImage>, util::Error> compress_bc_chain(
+		const image::Image<image::Precision::U8, image::Format::RGBA>& uncompressed_image,
+		CompressFunc compress_func
+	) noexcept
+	{
+		if (!image_power_of_2(uncompressed_image.size))
+			return compress_func(uncompressed_image).transform([](image::BCImage level) {
+				std::vector<image::BCImage> chain;
+				chain.push_back(std::move(level));
+				return chain;
+			});
+
+		return image::CompressMipmap(*compress_func)(image::generate_mipmap(uncompressed_image, {4, 4}));
+	}
+
+	// Get cache key of an image, or nullopt if caching is disabled
+	static std::optional<ImageCache::Key> get_cache_key(
+		const CompressOptions& options,
 		const tinygltf::Image& image,
-		bool srgb,
-		const std::string& name
+		ImageCache::Usage usage,
+		uint32_t compress_mode,
+		bool srgb
 	) noexcept
 	{
-		const auto image_size = glm::u32vec2(uint32_t(image.width), uint32_t(image.height));
-		const auto format =
-			srgb ? SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM;
+		if (options.cache == nullptr) return std::nullopt;
+		return ImageCache::Key::from_image(image, usage, compress_mode, srgb);
+	}
 
-		if (!image_size_multiple_of_block(image_size))
+	///
+	/// @brief Encode a BCn texture, reusing the compressed mipmap chain from the cache when available
+	///
+	/// @param cache Image cache, or `nullptr` if disabled
+	/// @param cache_key Cache key, or nullopt if caching is disabled
+	/// @param compress Function producing the compressed mipmap chain on cache miss
+	///
+	template <typename F>
+		requires(std::is_invocable_r_v<std::expected<std::vector<image::BCImage>, util::Error>, F>)
+	static std::expected<TextureData, util::Error> encode_bc_cached(
+		SDL_GPUTextureFormat format,
+		ImageCache* cache,
+		const std::optional<ImageCache::Key>& cache_key,
+		F&& compress
+	) noexcept
+	{
+		if (cache != nullptr && cache_key.has_value())
 		{
-			return create_color_uncompressed(device, image, srgb, name)
-				.transform_error(util::Error::forward_fn());
+			if (auto entry = cache->load(*cache_key); entry.has_value())
+			{
+				// Levels point into the mapped cache file, which is kept alive by the storage
+				auto storage = std::make_shared<ImageCache::Entry>(std::move(*entry));
+				return TextureData{.format = format, .levels = storage->levels, .storage = storage};
+			}
 		}
 
-		if (!image_power_of_2(image_size))
-		{
-			return extract_u8_rgba(image)
-				.and_then(image::compress_to_bc3)
-				.and_then(create_texture_from_image_fn<image::CompressionBlock>(device, format, name))
-				.transform_error(util::Error::forward_fn());
-		}
+		auto mipmap_chain = std::invoke(std::forward<F>(compress));
+		if (!mipmap_chain) return mipmap_chain.error().forward("Compress mipmap chain failed");
 
-		return extract_u8_rgba(image)
-			.transform([](const auto& uncompressed_image) {
-				return image::generate_mipmap(uncompressed_image, {4, 4});
-			})
-			.and_then(image::CompressMipmap(image::compress_to_bc3))
-			.and_then(create_texture_from_mipmap_fn(device, format, name))
-			.transform_error(util::Error::forward_fn());
+		// A failed store only costs a recompression on next launch
+		if (cache != nullptr && cache_key.has_value()) std::ignore = cache->store(*cache_key, *mipmap_chain);
+
+		return make_texture_data(format, std::move(*mipmap_chain));
 	}
 
-	static std::expected<gpu::Texture, util::Error> create_color_bc7(
-		SDL_GPUDevice* device,
+	static std::expected<TextureData, util::Error> encode_color_bc(
 		const tinygltf::Image& image,
+		ColorCompressMode compress_mode,
 		bool srgb,
-		const std::string& name
+		const CompressOptions& options
 	) noexcept
 	{
 		const auto image_size = glm::u32vec2(uint32_t(image.width), uint32_t(image.height));
-		const auto format =
-			srgb ? SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM;
 
 		if (!image_size_multiple_of_block(image_size))  // No compress, no mipmaps
-		{
-			return create_color_uncompressed(device, image, srgb, name)
-				.transform_error(util::Error::forward_fn());
-		}
+			return encode_color_uncompressed(image, srgb).transform_error(util::Error::forward_fn());
+
+		CompressFunc compress_func;
+		SDL_GPUTextureFormat format;
 
-		if (!image_power_of_2(image_size))
+		switch (compress_mode)
 		{
-			return extract_u8_rgba(image)
-				.and_then(image::compress_to_bc7)
-				.and_then(create_texture_from_image_fn<image::CompressionBlock>(device, format, name))
-				.transform_error(util::Error::forward_fn());
+		case ColorCompressMode::RGBA8_BC3:
+			compress_func = options.parallel ? &image::compress_to_bc3_parallel : &image::compress_to_bc3;
+			format = srgb ? SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM;
+			break;
+		case ColorCompressMode::RGBA8_BC7:
+			compress_func = options.parallel ? &image::compress_to_bc7_parallel : &image::compress_to_bc7;
+			format = srgb ? SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM_SRGB : SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM;
+			break;
+		default:
+			std::unreachable();
 		}
 
-		return extract_u8_rgba(image)
-			.transform([](const auto& uncompressed_image) {
-				return image::generate_mipmap(uncompressed_image, {4, 4});
-			})
-			.and_then(image::CompressMipmap(image::compress_to_bc7))
-			.and_then(create_texture_from_mipmap_fn(device, format, name))
-			.transform_error(util::Error::forward_fn());
+		const auto cache_key =
+			get_cache_key(options, image, ImageCache::Usage::Color, uint32_t(compress_mode), srgb);
+
+		return encode_bc_cached(format, options.cache, cache_key, [&] {
+			return extract_u8_rgba(image).and_then([compress_func](const auto& uncompressed_image) {
+				return compress_bc_chain(uncompressed_image, compress_func);
+			});
+		});
 	}
 
-	static std::expected<gpu::Texture, util::Error> create_normal_8bit(
-		SDL_GPUDevice* device,
+	static std::expected<TextureData, util::Error> encode_normal_8bit(
 		const tinygltf::Image& image,
+		NormalCompressMode compress_mode,
 		bool compress,
-		const std::string& name
+		const CompressOptions& options
 	) noexcept
 	{
 		const auto image_size = glm::u32vec2(uint32_t(image.width), uint32_t(image.height));
 
-		if (!image_size_multiple_of_block(image_size))
+		// Compress, with mipmaps if power-of-two
+		if (compress && image_size_multiple_of_block(image_size))
 		{
-			return extract_u8_rgba(image)
-				.transform([](const auto& img) {
-					return img.map([](const glm::u8vec4& pixel) -> glm::u8vec2 {
-						return {pixel.r, pixel.g};
-					});
-				})
-				.and_then(
-					create_texture_from_image_fn<glm::u8vec2>(device, SDL_GPU_TEXTUREFORMAT_R8G8_UNORM, name)
-				)
-				.transform_error(util::Error::forward_fn());
-		}
+			const auto compress_func =
+				options.parallel ? &image::compress_to_bc5_parallel : &image::compress_to_bc5;
+			const auto cache_key =
+				get_cache_key(options, image, ImageCache::Usage::Normal, uint32_t(compress_mode), false);
 
-		// Non Power-of-two textures are not compressed and mipmapped
-		if (!image_power_of_2(image_size))
-		{
-			if (compress)  // Compress, no mipmaps
-			{
-				return extract_u8_rgba(image)
-					.and_then(image::compress_to_bc5)
-					.and_then(
-						create_texture_from_image_fn<image::CompressionBlock>(
-							device,
-							SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM,
-							name
-						)
-					)
-					.transform_error(util::Error::forward_fn());
-			}
-			else  // No compress, no mipmaps
-			{
-				return extract_u8_rgba(image)
-					.transform([](const auto& img) {
-						return img.map([](const glm::u8vec4& pixel) -> glm::u8vec2 {
-							return {pixel.r, pixel.g};
-						});
-					})
-					.and_then(
-						create_texture_from_image_fn<glm::u8vec2>(
-							device,
-							SDL_GPU_TEXTUREFORMAT_R8G8_UNORM,
-							name
-						)
-					)
-					.transform_error(util::Error::forward_fn());
-			}
+			return encode_bc_cached(SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM, options.cache, cache_key, [&] {
+				return extract_u8_rgba(image).and_then([compress_func](const auto& img) {
+					return compress_bc_chain(img, compress_func);
+				});
+			});
 		}
 
-		// Power-of-two textures can be compressed
-		if (compress)
-		{
-			return extract_u8_rgba(image)
-				.transform([](const auto& img) { return image::generate_mipmap(img, {4, 4}); })
-				.and_then(image::CompressMipmap(image::compress_to_bc5))
-				.and_then(create_texture_from_mipmap_fn(device, SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM, name))
-				.transform_error(util::Error::forward_fn());
-		}
-		else
+		// Non Power-of-two textures are not mipmapped
+		if (!image_size_multiple_of_block(image_size) || !image_power_of_2(image_size))
 		{
 			return extract_u8_rgba(image)
 				.transform([](const auto& img) {
@@ -215,132 +203,138 @@ namespace gltf
 						return {pixel.r, pixel.g};
 					});
 				})
-				.transform([](const auto& img) { return image::generate_mipmap(img); })
-				.and_then(create_texture_from_mipmap_fn(device, SDL_GPU_TEXTUREFORMAT_R8G8_UNORM, name))
+				.transform(make_texture_data_fn(SDL_GPU_TEXTUREFORMAT_R8G8_UNORM))
 				.transform_error(util::Error::forward_fn());
 		}
+
+		return extract_u8_rgba(image)
+			.transform([](const auto& img) {
+				return img.map([](const glm::u8vec4& pixel) -> glm::u8vec2 {
+					return {pixel.r, pixel.g};
+				});
+			})
+			.transform([](const auto& img) { return image::generate_mipmap(img); })
+			.transform(make_texture_data_fn(SDL_GPU_TEXTUREFORMAT_R8G8_UNORM))
+			.transform_error(util::Error::forward_fn());
 	}
 
-	static std::expected<gpu::Texture, util::Error> create_normal_16bit(
-		SDL_GPUDevice* device,
+	static std::expected<TextureData, util::Error> encode_normal_16bit(
 		const tinygltf::Image& image,
+		NormalCompressMode compress_mode,
 		bool compress,
-		const std::string& name
+		const CompressOptions& options
 	) noexcept
 	{
 		const auto image_size = glm::u32vec2(uint32_t(image.width), uint32_t(image.height));
 
-		if (!image_size_multiple_of_block(image_size))
+		// Compress to 8-bit BC5, with mipmaps if power-of-two
+		if (compress && image_size_multiple_of_block(image_size))
 		{
-			return extract_u16_rgba(image)
-				.transform([](const auto& image) {
-					return image.map([](const glm::u16vec4& pixel) -> glm::u16vec2 {
-						return {pixel.r, pixel.g};
-					});
-				})
-				.and_then(
-					create_texture_from_image_fn<glm::u16vec2>(
-						device,
-						SDL_GPU_TEXTUREFORMAT_R16G16_UNORM,
-						name
-					)
-				)
-				.transform_error(util::Error::forward_fn());
-		}
+			const auto compress_func =
+				options.parallel ? &image::compress_to_bc5_parallel : &image::compress_to_bc5;
+			const auto cache_key =
+				get_cache_key(options, image, ImageCache::Usage::Normal, uint32_t(compress_mode), false);
 
-		// Non Power-of-two textures
-		if (!image_power_of_2(image_size))
-		{
-			if (compress)  // Compress, no mipmaps
-			{
-				return extract_u16_rgba(image)
-					.transform([&](const auto& img) {
-						return img.map([](const glm::u16vec4& pixel) {
-							return glm::u8vec4(pixel / uint16_t(256));
-						});
-					})
-					.and_then(image::compress_to_bc5)
-					.and_then(
-						create_texture_from_image_fn<image::CompressionBlock>(
-							device,
-							SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM,
-							name
-						)
-					)
-					.transform_error(util::Error::forward_fn());
-			}
-			else  // No compress, no mipmaps
-			{
+			return encode_bc_cached(SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM, options.cache, cache_key, [&] {
 				return extract_u16_rgba(image)
-					.transform([](const auto& image) {
-						return image.map([](const glm::u16vec4& pixel) -> glm::u16vec2 {
-							return {pixel.r, pixel.g};
+					.transform([](const auto& img) {
+						return img.map([](const glm::u16vec4& pixel) -> glm::u8vec4 {
+							return pixel / uint16_t(256);
 						});
 					})
-					.and_then(
-						create_texture_from_image_fn<glm::u16vec2>(
-							device,
-							SDL_GPU_TEXTUREFORMAT_R16G16_UNORM,
-							name
-						)
-					)
-					.transform_error(util::Error::forward_fn());
-			}
+					.and_then([compress_func](const auto& img) {
+						return compress_bc_chain(img, compress_func);
+					});
+			});
 		}
 
-		// Power-of-two textures can be compressed
-		if (compress)
+		// Non Power-of-two textures are not mipmapped
+		if (!image_size_multiple_of_block(image_size) || !image_power_of_2(image_size))
 		{
 			return extract_u16_rgba(image)
-				.transform([&](const auto& img) {
-					return img.map([](const glm::u16vec4& pixel) -> glm::u8vec4 {
-						return pixel / uint16_t(256);
+				.transform([](const auto& image) {
+					return image.map([](const glm::u16vec4& pixel) -> glm::u16vec2 {
+						return {pixel.r, pixel.g};
 					});
 				})
-				.transform([&](const auto& img) { return image::generate_mipmap(img, {4, 4}); })
-				.and_then(image::CompressMipmap(image::compress_to_bc5))
-				.and_then(create_texture_from_mipmap_fn(device, SDL_GPU_TEXTUREFORMAT_BC5_RG_UNORM, name))
+				.transform(make_texture_data_fn(SDL_GPU_TEXTUREFORMAT_R16G16_UNORM))
 				.transform_error(util::Error::forward_fn());
 		}
-		else
+
+		return extract_u16_rgba(image)
+			.transform([](const auto& img) {
+				return image::generate_mipmap(img.map([](const glm::u16vec4& pixel) -> glm::u16vec2 {
+					return {pixel.r, pixel.g};
+				}));
+			})
+			.transform(make_texture_data_fn(SDL_GPU_TEXTUREFORMAT_R16G16_UNORM))
+			.transform_error(util::Error::forward_fn());
+	}
+
+	void TextureData::bake(detail::bake::Writer& writer) const noexcept
+	{
+		writer.write<uint32_t>(format);
+		writer.write<uint32_t>(uint32_t(levels.size()));
+
+		for (const auto& level : levels)
 		{
-			return extract_u16_rgba(image)
-				.transform([](const auto& img) {
-					return image::generate_mipmap(img.map([](const glm::u16vec4& pixel) -> glm::u16vec2 {
-						return {pixel.r, pixel.g};
-					}));
-				})
-				.and_then(create_texture_from_mipmap_fn(device, SDL_GPU_TEXTUREFORMAT_R16G16_UNORM, name))
-				.transform_error(util::Error::forward_fn());
+			writer.write<glm::u32vec2>(level.size);
+			writer.write_array(level.pixels);
 		}
 	}
 
-	std::expected<gpu::Texture, util::Error> create_color_texture_from_image(
-		SDL_GPUDevice* device,
+	std::expected<TextureData, util::Error> TextureData::from_baked(detail::bake::Reader& reader) noexcept
+	{
+		const auto format = reader.read<uint32_t>();
+		if (!format) return format.error().forward("Read texture format failed");
+
+		const auto level_count = reader.read<uint32_t>();
+		if (!level_count) return level_count.error().forward("Read mipmap level count failed");
+		if (*level_count == 0) return util::Error("Baked texture has no mipmap levels");
+
+		TextureData data{.format = SDL_GPUTextureFormat(*format), .levels = {}, .storage = nullptr};
+		data.levels.reserve(*level_count);
+
+		for (const auto idx : std::views::iota(0u, *level_count))
+		{
+			const auto size = reader.read<glm::u32vec2>();
+			if (!size) return size.error().forward(std::format("Read size of level {} failed", idx));
+
+			const auto pixels = reader.read_array<std::byte>();
+			if (!pixels) return pixels.error().forward(std::format("Read pixels of level {} failed", idx));
+
+			if (pixels->size() != SDL_CalculateGPUTextureFormatSize(data.format, size->x, size->y, 1))
+				return util::Error(std::format("Pixel data size mismatch at level {}", idx));
+
+			data.levels.push_back({.size = *size, .pixels = *pixels});
+		}
+
+		return data;
+	}
+
+	std::expected<TextureData, util::Error> encode_color_texture(
 		const tinygltf::Image& image,
 		ColorCompressMode compress_mode,
 		bool srgb,
-		const std::string& name
+		const CompressOptions& options
 	) noexcept
 	{
 		switch (compress_mode)
 		{
 		case ColorCompressMode::RGBA8_raw:
-			return create_color_uncompressed(device, image, srgb, name);
+			return encode_color_uncompressed(image, srgb);
 		case ColorCompressMode::RGBA8_BC3:
-			return create_color_bc3(device, image, srgb, name);
 		case ColorCompressMode::RGBA8_BC7:
-			return create_color_bc7(device, image, srgb, name);
+			return encode_color_bc(image, compress_mode, srgb, options);
 		}
 
 		std::unreachable();
 	}
 
-	std::expected<gpu::Texture, util::Error> create_normal_texture_from_image(
-		SDL_GPUDevice* device,
+	std::expected<TextureData, util::Error> encode_normal_texture(
 		const tinygltf::Image& image,
 		NormalCompressMode compress_mode,
-		const std::string& name
+		const CompressOptions& options
 	) noexcept
 	{
 		const bool compress_when_8bit =
@@ -349,9 +343,9 @@ namespace gltf
 		const bool compress_when_16bit = (compress_mode == NormalCompressMode::RGn_BC5);
 
 		if (image.bits == 8 && image.pixel_type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-			return create_normal_8bit(device, image, compress_when_8bit, name);
+			return encode_normal_8bit(image, compress_mode, compress_when_8bit, options);
 		else if (image.bits == 16 && image.pixel_type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-			return create_normal_16bit(device, image, compress_when_16bit, name);
+			return encode_normal_16bit(image, compress_mode, compress_when_16bit, options);
 		else
 			return util::Error(
 				std::format(
@@ -362,6 +356,49 @@ namespace gltf
 			);
 	}
 
+	std::expected<gpu::Texture, util::Error> upload_texture(
+		SDL_GPUDevice* device,
+		const TextureData& data,
+		const std::string& name
+	) noexcept
+	{
+		return graphics::create_texture_from_mipmap_data(
+			device,
+			{.type = SDL_GPU_TEXTURETYPE_2D, .format = data.format, .usage = {.sampler = true}},
+			data.levels,
+			name
+		);
+	}
+
+	std::expected<gpu::Texture, util::Error> create_color_texture_from_image(
+		SDL_GPUDevice* device,
+		const tinygltf::Image& image,
+		ColorCompressMode compress_mode,
+		bool srgb,
+		const CompressOptions& options,
+		const std::string& name
+	) noexcept
+	{
+		return encode_color_texture(image, compress_mode, srgb, options)
+			.and_then([device, &name](const TextureData& data) {
+				return upload_texture(device, data, name);
+			});
+	}
+
+	std::expected<gpu::Texture, util::Error> create_normal_texture_from_image(
+		SDL_GPUDevice* device,
+		const tinygltf::Image& image,
+		NormalCompressMode compress_mode,
+		const CompressOptions& options,
+		const std::string& name
+	) noexcept
+	{
+		return encode_normal_texture(image, compress_mode, options)
+			.and_then([device, &name](const TextureData& data) {
+				return upload_texture(device, data, name);
+			});
+	}
+
 	std::expected<gpu::Texture, util::Error> create_placeholder_image(
 		SDL_GPUDevice* device,
 		glm::vec4 color,
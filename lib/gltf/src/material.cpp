@@ -1,6 +1,8 @@
 #include "gltf/material.hpp"
 #include "gltf/image.hpp"
 
+#include <algorithm>
+#include <array>
 #include <format>
 #include <ranges>
 #include <thread_pool/thread_pool.h>
@@ -226,52 +228,77 @@ namespace gltf
 		return {};
 	}
 
-	std::expected<MaterialList::ImageEntry, util::Error> MaterialList::load_image_thread(
-		SDL_GPUDevice* device,
+	std::expected<MaterialList::EncodedImage, util::Error> MaterialList::encode_image_thread(
 		const tinygltf::Image& image,
 		const ImageConfig& image_config,
 		ImageRefCount refcount
 	) noexcept
 	{
-		ImageEntry entry;
+		EncodedImage encoded;
+
+		const CompressOptions compress_options{
+			.parallel = image_config.parallel_compress,
+			.cache = image_config.cache.get()
+		};
 
 		if (refcount.color_refcount > 0)
 		{
-			auto color_texture = gltf::create_color_texture_from_image(
-				device,
-				image,
-				image_config.color_mode,
-				true,
-				std::format("GLTF Image '{}'", image.name)
-			);
-			if (!color_texture) return color_texture.error().forward("Load color image failed");
+			auto color_texture =
+				gltf::encode_color_texture(image, image_config.color_mode, true, compress_options);
+			if (!color_texture) return color_texture.error().forward("Encode color image failed");
 
-			entry.color_texture = std::move(*color_texture);
+			encoded.color_texture = std::move(*color_texture);
 		}
 
 		if (refcount.linear_refcount > 0)
 		{
-			auto linear_texture = gltf::create_color_texture_from_image(
-				device,
-				image,
-				image_config.color_mode,
-				false,
-				std::format("GLTF Image '{}'", image.name)
-			);
-			if (!linear_texture) return linear_texture.error().forward("Load linear image failed");
+			auto linear_texture =
+				gltf::encode_color_texture(image, image_config.color_mode, false, compress_options);
+			if (!linear_texture) return linear_texture.error().forward("Encode linear image failed");
 
-			entry.linear_texture = std::move(*linear_texture);
+			encoded.linear_texture = std::move(*linear_texture);
 		}
 
 		if (refcount.normal_refcount > 0)
 		{
-			auto normal_texture = gltf::create_normal_texture_from_image(
-				device,
-				image,
-				image_config.normal_mode,
-				std::format("GLTF Image '{}'", image.name)
-			);
-			if (!normal_texture) return normal_texture.error().forward("Load normal image failed");
+			auto normal_texture =
+				gltf::encode_normal_texture(image, image_config.normal_mode, compress_options);
+			if (!normal_texture) return normal_texture.error().forward("Encode normal image failed");
+
+			encoded.normal_texture = std::move(*normal_texture);
+		}
+
+		return encoded;
+	}
+
+	std::expected<MaterialList::ImageEntry, util::Error> MaterialList::upload_image(
+		SDL_GPUDevice* device,
+		const EncodedImage& encoded,
+		const std::string& name
+	) noexcept
+	{
+		ImageEntry entry;
+
+		if (encoded.color_texture.has_value())
+		{
+			auto color_texture = gltf::upload_texture(device, *encoded.color_texture, name);
+			if (!color_texture) return color_texture.error().forward("Upload color image failed");
+
+			entry.color_texture = std::move(*color_texture);
+		}
+
+		if (encoded.linear_texture.has_value())
+		{
+			auto linear_texture = gltf::upload_texture(device, *encoded.linear_texture, name);
+			if (!linear_texture) return linear_texture.error().forward("Upload linear image failed");
+
+			entry.linear_texture = std::move(*linear_texture);
+		}
+
+		if (encoded.normal_texture.has_value())
+		{
+			auto normal_texture = gltf::upload_texture(device, *encoded.normal_texture, name);
+			if (!normal_texture) return normal_texture.error().forward("Upload normal image failed");
 
 			entry.normal_texture = std::move(*normal_texture);
 		}
@@ -279,62 +306,109 @@ namespace gltf
 		return entry;
 	}
 
-	std::expected<void, util::Error> MaterialList::load_images(
+	std::expected<MaterialList::ImageEntry, util::Error> MaterialList::load_image_thread(
 		SDL_GPUDevice* device,
-		const tinygltf::Model& model,
+		const tinygltf::Image& image,
 		const ImageConfig& image_config,
-		const Load_progress_callback& progress_callback
+		ImageRefCount refcount
+	) noexcept
+	{
+		return encode_image_thread(image, image_config, refcount)
+			.and_then([device, &image](const EncodedImage& encoded) {
+				return upload_image(device, encoded, std::format("GLTF Image '{}'", image.name));
+			});
+	}
+
+	// Thread count of the per-image pool, `hardware_concurrency` is 0 if unknown
+	static uint32_t image_thread_count() noexcept
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Block-level compression only while the per-image pool has idle threads, otherwise every image worker
+	// would also wait on the block pool and the cores get oversubscribed
+	static MaterialList::ImageConfig per_image_config(
+		const tinygltf::Model& model,
+		const MaterialList::ImageConfig& image_config
+	) noexcept
+	{
+		auto config = image_config;
+		config.parallel_compress &= model.images.size() < image_thread_count();
+		return config;
+	}
+
+	template <typename F, typename R>
+	std::expected<std::vector<R>, util::Error> MaterialList::for_each_image_parallel(
+		const tinygltf::Model& model,
+		const Load_progress_callback& progress_callback,
+		F task
 	) noexcept
 	{
 		if (progress_callback) progress_callback(0, model.images.size());
 
 		const auto refcount_list = compute_image_refcounts(model);
 
-		auto progress_mutex = std::make_shared<std::mutex>();
-		auto progress_count = std::make_shared<std::atomic<size_t>>(0);
+		std::mutex progress_mutex;
+		size_t progress_count = 0;
 
-		dp::thread_pool thread_pool(std::thread::hardware_concurrency());
+		dp::thread_pool thread_pool(image_thread_count());
 
 		auto result_futures =
 			std::views::zip(model.images, refcount_list)
 			| std::views::transform([&, total = refcount_list.size()](const auto& input) {
 				  const auto& [image, refcount] = input;
 
-				  return thread_pool.enqueue(
-					  [device,
-					   image_config,
-					   refcount,
-					   progress_mutex,
-					   progress_count,
-					   progress_callback,
-					   total,
-					   image]() {
-						  auto result = load_image_thread(device, image, image_config, refcount);
-
-						  // Update progress
-						  {
-							  std::scoped_lock lock(*progress_mutex);
-
-							  (*progress_count)++;
-							  if (progress_callback) progress_callback((*progress_count).load(), total);
-						  }
-
-						  return result;
+				  return thread_pool.enqueue([&, refcount, total, image_ptr = &image]() {
+					  auto result = task(*image_ptr, refcount);
+
+					  // Update progress
+					  {
+						  std::scoped_lock lock(progress_mutex);
+
+						  progress_count++;
+						  if (progress_callback) progress_callback(progress_count, total);
 					  }
-				  );
+
+					  return result;
+				  });
 			  })
 			| std::ranges::to<std::vector>();
 
 		thread_pool.wait_for_tasks();
 
-		for (auto& future : result_futures)
+		std::vector<R> results;
+		results.reserve(result_futures.size());
+
+		for (auto [idx, future] : result_futures | std::views::enumerate)
 		{
 			auto result = future.get();
-			if (!result) return result.error().forward("Load image failed");
+			if (!result) return result.error().forward(std::format("Process image {} failed", idx));
 
-			images.emplace_back(std::move(*result));
+			results.emplace_back(std::move(*result));
 		}
 
+		return results;
+	}
+
+	std::expected<void, util::Error> MaterialList::load_images(
+		SDL_GPUDevice* device,
+		const tinygltf::Model& model,
+		const ImageConfig& image_config,
+		const Load_progress_callback& progress_callback
+	) noexcept
+	{
+		const auto config = per_image_config(model, image_config);
+
+		auto result = for_each_image_parallel(
+			model,
+			progress_callback,
+			[device, &config](const tinygltf::Image& image, ImageRefCount refcount) {
+				return load_image_thread(device, image, config, refcount);
+			}
+		);
+		if (!result) return result.error().forward("Load image failed");
+
+		images = std::move(*result);
 		return {};
 	}
 
@@ -448,6 +522,217 @@ namespace gltf
 		return material_list;
 	}
 
+	std::expected<void, util::Error> MaterialList::bake(
+		detail::bake::Writer& writer,
+		const tinygltf::Model& model,
+		const ImageConfig& image_config,
+		const Load_progress_callback& progress_callback
+	) noexcept
+	{
+		if (progress_callback) progress_callback(std::nullopt, 0);
+
+		MaterialList material_list;
+
+		auto result = material_list.load_textures(model);
+		if (!result) return result.error().forward("Load textures failed");
+
+		result = material_list.load_materials(model);
+		if (!result) return result.error().forward("Load materials failed");
+
+		const auto config = per_image_config(model, image_config);
+
+		auto encoded_images = for_each_image_parallel(
+			model,
+			progress_callback,
+			[&config](const tinygltf::Image& image, ImageRefCount refcount) {
+				return encode_image_thread(image, config, refcount);
+			}
+		);
+		if (!encoded_images) return encoded_images.error().forward("Encode images failed");
+
+		/* Samplers */
+
+		writer.write<uint64_t>(model.samplers.size());
+		for (const auto& sampler : model.samplers)
+			writer.write(
+				std::to_array<int32_t>({sampler.minFilter, sampler.magFilter, sampler.wrapS, sampler.wrapT})
+			);
+
+		/* Textures */
+
+		writer.write<uint64_t>(material_list.textures.size());
+		for (const auto& texture : material_list.textures)
+		{
+			writer.write<uint32_t>(texture.image_index);
+			writer.write_optional(texture.sampler_index);
+		}
+
+		/* Materials */
+
+		writer.write<uint64_t>(material_list.materials.size());
+		for (const auto& material : material_list.materials)
+		{
+			writer.write_optional(material.base_color);
+			writer.write_optional(material.metallic_roughness);
+			writer.write_optional(material.normal);
+			writer.write_optional(material.occlusion);
+			writer.write_optional(material.emissive);
+			writer.write(material.params);
+		}
+
+		/* Images */
+
+		writer.write<uint64_t>(encoded_images->size());
+		for (const auto& [image, encoded] : std::views::zip(model.images, *encoded_images))
+		{
+			writer.write_string(image.name);
+
+			for (const auto* const texture :
+				 {&encoded.color_texture, &encoded.linear_texture, &encoded.normal_texture})
+			{
+				writer.write<uint8_t>(texture->has_value() ? 1 : 0);
+				if (texture->has_value()) (*texture)->bake(writer);
+			}
+		}
+
+		return {};
+	}
+
+	std::expected<MaterialList, util::Error> MaterialList::from_baked(
+		SDL_GPUDevice* device,
+		detail::bake::Reader& reader,
+		const SamplerConfig& sampler_config,
+		const Load_progress_callback& progress_callback
+	) noexcept
+	{
+		if (progress_callback) progress_callback(std::nullopt, 0);
+
+		MaterialList material_list;
+
+		auto result = material_list.create_default_textures(device);
+		if (!result) return result.error().forward("Create default textures failed");
+
+		result = material_list.create_default_sampler(device);
+		if (!result) return result.error().forward("Create default sampler failed");
+
+		/* Samplers */
+
+		const auto sampler_count = reader.read<uint64_t>();
+		if (!sampler_count) return sampler_count.error().forward("Read sampler count failed");
+
+		for (const auto idx : std::views::iota(0zu, *sampler_count))
+		{
+			const auto params = reader.read<std::array<int32_t, 4>>();
+			if (!params) return params.error().forward(std::format("Read sampler {} failed", idx));
+
+			tinygltf::Sampler tinygltf_sampler;
+			tinygltf_sampler.minFilter = (*params)[0];
+			tinygltf_sampler.magFilter = (*params)[1];
+			tinygltf_sampler.wrapS = (*params)[2];
+			tinygltf_sampler.wrapT = (*params)[3];
+
+			auto sampler = gltf::create_sampler(device, tinygltf_sampler, sampler_config);
+			if (!sampler) return sampler.error().forward(std::format("Create sampler {} failed", idx));
+
+			material_list.samplers.emplace_back(std::move(*sampler));
+		}
+
+		/* Textures */
+
+		const auto texture_count = reader.read<uint64_t>();
+		if (!texture_count) return texture_count.error().forward("Read texture count failed");
+
+		for (const auto idx : std::views::iota(0zu, *texture_count))
+		{
+			const auto image_index = reader.read<uint32_t>();
+			if (!image_index) return image_index.error().forward(std::format("Read texture {} failed", idx));
+
+			const auto sampler_index = reader.read_optional<uint32_t>();
+			if (!sampler_index)
+				return sampler_index.error().forward(std::format("Read texture {} failed", idx));
+
+			if (sampler_index->has_value() && **sampler_index >= *sampler_count)
+				return util::Error(std::format("Texture {} sampler index out of bounds", idx));
+
+			material_list.textures.push_back({.image_index = *image_index, .sampler_index = *sampler_index});
+		}
+
+		/* Materials */
+
+		const auto material_count = reader.read<uint64_t>();
+		if (!material_count) return material_count.error().forward("Read material count failed");
+
+		for (const auto idx : std::views::iota(0zu, *material_count))
+		{
+			MaterialIndexed material;
+
+			for (auto* const slot :
+				 {&material.base_color,
+				  &material.metallic_roughness,
+				  &material.normal,
+				  &material.occlusion,
+				  &material.emissive})
+			{
+				const auto texture_index = reader.read_optional<uint32_t>();
+				if (!texture_index)
+					return texture_index.error().forward(std::format("Read material {} failed", idx));
+
+				if (texture_index->has_value() && **texture_index >= *texture_count)
+					return util::Error(std::format("Material {} texture index out of bounds", idx));
+
+				*slot = *texture_index;
+			}
+
+			const auto params = reader.read<MaterialParams>();
+			if (!params) return params.error().forward(std::format("Read material {} failed", idx));
+			material.params = *params;
+
+			material_list.materials.push_back(material);
+		}
+
+		/* Images */
+
+		const auto image_count = reader.read<uint64_t>();
+		if (!image_count) return image_count.error().forward("Read image count failed");
+
+		if (std::ranges::any_of(material_list.textures, [count = *image_count](const Texture& texture) {
+				return texture.image_index >= count;
+			}))
+			return util::Error("Texture image index out of bounds");
+
+		if (progress_callback) progress_callback(0, *image_count);
+
+		for (const auto idx : std::views::iota(0zu, *image_count))
+		{
+			const auto name = reader.read_string();
+			if (!name) return name.error().forward(std::format("Read image {} failed", idx));
+
+			EncodedImage encoded;
+
+			for (auto* const slot :
+				 {&encoded.color_texture, &encoded.linear_texture, &encoded.normal_texture})
+			{
+				const auto has_value = reader.read<uint8_t>();
+				if (!has_value) return has_value.error().forward(std::format("Read image {} failed", idx));
+				if (*has_value == 0) continue;
+
+				auto texture = TextureData::from_baked(reader);
+				if (!texture) return texture.error().forward(std::format("Read image {} failed", idx));
+
+				*slot = std::move(*texture);
+			}
+
+			auto entry = upload_image(device, encoded, std::format("GLTF Image '{}'", *name));
+			if (!entry) return entry.error().forward(std::format("Upload image {} failed", idx));
+
+			material_list.images.emplace_back(std::move(*entry));
+
+			if (progress_callback) progress_callback(idx + 1, *image_count);
+		}
+
+		return material_list;
+	}
+
 	std::optional<MaterialGPU> MaterialList::gen_binding_info(
 		std::optional<uint32_t> material_index
 	) const noexcept
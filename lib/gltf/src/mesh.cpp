@@ -5,7 +5,11 @@
 #include "graphics/util/quick-create.hpp"
 #include "util/as-byte.hpp"
 #include <algorithm>
+#include <format>
+#include <glm/gtc/packing.hpp>
+#include <meshoptimizer.h>
 #include <ranges>
+#include <string_view>
 
 namespace gltf
 {
@@ -18,7 +22,8 @@ namespace gltf
 		const bool position_equal = position == other.position;
 		const bool normal_equal = glm::dot(normal, other.normal) >= vertex_eq_thres;
 		const bool texcoord_equal = texcoord == other.texcoord;
-		const bool tangent_equal = glm::dot(tangent, other.tangent) >= vertex_eq_thres;
+		const bool tangent_equal = tangent.w == other.tangent.w
+			&& glm::dot(glm::vec3(tangent), glm::vec3(other.tangent)) >= vertex_eq_thres;
 
 		return position_equal && normal_equal && texcoord_equal && tangent_equal;
 	}
@@ -28,7 +33,8 @@ namespace gltf
 		const bool position_equal = position == other.position;
 		const bool normal_equal = glm::dot(normal, other.normal) >= vertex_eq_thres;
 		const bool texcoord_equal = texcoord == other.texcoord;
-		const bool tangent_equal = glm::dot(tangent, other.tangent) >= vertex_eq_thres;
+		const bool tangent_equal = tangent.w == other.tangent.w
+			&& glm::dot(glm::vec3(tangent), glm::vec3(other.tangent)) >= vertex_eq_thres;
 		const bool joint_indices_equal = joint_indices == other.joint_indices;
 		const bool joint_weights_equal =
 			glm::distance(joint_weights, other.joint_weights) <= 1 - vertex_eq_thres;
@@ -78,10 +84,281 @@ namespace gltf
 		};
 	}
 
-	std::expected<Primitive, util::Error> Primitive::from_tinygltf(
+	// Component-wise sign, zero counted as positive
+	static glm::vec2 sign_not_zero(const glm::vec2& value) noexcept
+	{
+		return {value.x >= 0.0f ? 1.0f : -1.0f, value.y >= 0.0f ? 1.0f : -1.0f};
+	}
+
+	// Octahedral encoding of a direction into [-1, 1]^2, decodable by `octToNormal` in `oct.glsl`
+	static glm::vec2 encode_octahedral(const glm::vec3& direction) noexcept
+	{
+		const float l1_norm = glm::abs(direction.x) + glm::abs(direction.y) + glm::abs(direction.z);
+		if (l1_norm <= 0.0f) return glm::vec2(0.0f);
+
+		const auto projected = direction / l1_norm;
+		if (projected.z >= 0.0f) return glm::vec2(projected);
+
+		// Fold the lower hemisphere onto the outer triangles
+		return (1.0f - glm::abs(glm::vec2(projected.y, projected.x))) * sign_not_zero(glm::vec2(projected));
+	}
+
+	static glm::vec3 decode_octahedral(const glm::vec2& encoded) noexcept
+	{
+		glm::vec3 direction(encoded, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y));
+		if (direction.z < 0.0f)
+		{
+			const auto unfolded =
+				(1.0f - glm::abs(glm::vec2(direction.y, direction.x))) * sign_not_zero(glm::vec2(direction));
+			direction.x = unfolded.x;
+			direction.y = unfolded.y;
+		}
+
+		return glm::normalize(direction);
+	}
+
+	static glm::u16vec4 quantize_position(
+		const glm::vec3& position,
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) noexcept
+	{
+		const auto extent = position_max - position_min;
+		const auto relative =
+			(position - position_min) / glm::max(extent, glm::vec3(std::numeric_limits<float>::min()));
+
+		return {
+			meshopt_quantizeUnorm(relative.x, 16),
+			meshopt_quantizeUnorm(relative.y, 16),
+			meshopt_quantizeUnorm(relative.z, 16),
+			0
+		};
+	}
+
+	static glm::vec3 dequantize_position(
+		const glm::u16vec4& quantized,
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) noexcept
+	{
+		return position_min + glm::vec3(quantized) / 65535.0f * (position_max - position_min);
+	}
+
+	static glm::u16vec2 quantize_texcoord(const glm::vec2& texcoord) noexcept
+	{
+		return {meshopt_quantizeHalf(texcoord.x), meshopt_quantizeHalf(texcoord.y)};
+	}
+
+	static glm::vec2 dequantize_texcoord(const glm::u16vec2& quantized) noexcept
+	{
+		return {glm::unpackHalf1x16(quantized.x), glm::unpackHalf1x16(quantized.y)};
+	}
+
+	QuantizedVertex QuantizedVertex::from_vertex(
+		const Vertex& vertex,
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) noexcept
+	{
+		const auto normal = encode_octahedral(vertex.normal);
+		const auto tangent = encode_octahedral(glm::vec3(vertex.tangent));
+
+		// Bitangent sign in the spare position component, unorm 0 for -1 and 1 for +1
+		auto position = quantize_position(vertex.position, position_min, position_max);
+		position.w = vertex.tangent.w < 0.0f ? 0 : 65535;
+
+		return QuantizedVertex{
+			.position = position,
+			.normal_tangent = {
+				meshopt_quantizeSnorm(normal.x, 16),
+				meshopt_quantizeSnorm(normal.y, 16),
+				meshopt_quantizeSnorm(tangent.x, 16),
+				meshopt_quantizeSnorm(tangent.y, 16)
+			},
+			.texcoord = quantize_texcoord(vertex.texcoord),
+		};
+	}
+
+	Vertex QuantizedVertex::to_vertex(
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) const noexcept
+	{
+		// Snorm decoding as done by the vertex fetch, -32768 clamps to -1
+		const auto normal_tangent_decoded = glm::max(glm::vec4(normal_tangent) / 32767.0f, glm::vec4(-1.0f));
+
+		return Vertex{
+			.position = dequantize_position(position, position_min, position_max),
+			.normal = decode_octahedral(glm::vec2(normal_tangent_decoded)),
+			.tangent = glm::vec4(
+				decode_octahedral(glm::vec2(normal_tangent_decoded.z, normal_tangent_decoded.w)),
+				position.w != 0 ? 1.0f : -1.0f
+			),
+			.texcoord = dequantize_texcoord(texcoord),
+		};
+	}
+
+	QuantizedShadowVertex QuantizedShadowVertex::from_shadow_vertex(
+		const ShadowVertex& vertex,
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) noexcept
+	{
+		return QuantizedShadowVertex{
+			.position = quantize_position(vertex.position, position_min, position_max),
+			.texcoord = quantize_texcoord(vertex.texcoord),
+		};
+	}
+
+	ShadowVertex QuantizedShadowVertex::to_shadow_vertex(
+		const glm::vec3& position_min,
+		const glm::vec3& position_max
+	) const noexcept
+	{
+		return ShadowVertex{
+			.position = dequantize_position(position, position_min, position_max),
+			.texcoord = dequantize_texcoord(texcoord),
+		};
+	}
+
+	float StreamStatistics::acmr() const noexcept
+	{
+		return triangle_count == 0 ? 0.0f : float(transformed_count) / float(triangle_count);
+	}
+
+	float StreamStatistics::atvr() const noexcept
+	{
+		return vertex_count == 0 ? 0.0f : float(transformed_count) / float(vertex_count);
+	}
+
+	StreamStatistics& StreamStatistics::operator+=(const StreamStatistics& other) noexcept
+	{
+		vertex_count += other.vertex_count;
+		triangle_count += other.triangle_count;
+		transformed_count += other.transformed_count;
+		return *this;
+	}
+
+	MeshStatistics& MeshStatistics::operator+=(const MeshStatistics& other) noexcept
+	{
+		primitive_count += other.primitive_count;
+		source += other.source;
+		optimized += other.optimized;
+		shadow_optimized += other.shadow_optimized;
+		return *this;
+	}
+
+	std::string MeshStatistics::to_string() const noexcept
+	{
+		const auto format_stream = [this](std::string_view name, const StreamStatistics& stream) {
+			return std::format(
+				"  {:<7} {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+				name,
+				source.vertex_count,
+				stream.vertex_count,
+				source.acmr(),
+				stream.acmr(),
+				source.atvr(),
+				stream.atvr()
+			);
+		};
+
+		return std::format(
+			"Mesh optimization: {} primitives, {} triangles\n{}\n{}",
+			primitive_count,
+			source.triangle_count,
+			format_stream("Main:", optimized),
+			format_stream("Shadow:", shadow_optimized)
+		);
+	}
+
+	// Optimized full and shadow vertex lists of a primitive
+	template <typename V, typename S>
+	struct OptimizedPrimitiveLists
+	{
+		std::vector<V> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<S> shadow_vertices;
+		std::vector<uint32_t> shadow_indices;
+		StreamStatistics source_statistics;  // Vertex stream before optimization
+	};
+
+	// If the shadow pass ignores all attributes but position, i.e. the material is opaque
+	static bool shadow_position_only(
 		const tinygltf::Model& model,
 		const tinygltf::Primitive& primitive
 	) noexcept
+	{
+		if (primitive.material == -1) return true;
+		if (primitive.material < 0 || std::cmp_greater_equal(primitive.material, model.materials.size()))
+			return false;
+		return model.materials[primitive.material].alphaMode == "OPAQUE";
+	}
+
+	// Optimize an indexed vertex list. Full vertices are already unique, shadow vertices are welded again as
+	// tangent seams no longer split them, or by position alone if `weld_shadow_positions` is set.
+	template <typename V, typename S>
+	static OptimizedPrimitiveLists<V, S> optimize_indexed_list(
+		IndexedVertexList<V> list,
+		S (*to_shadow_vertex)(const V&),
+		bool weld_shadow_positions
+	) noexcept
+	{
+		const auto source_statistics = analyze_vertex_cache(list.indices, list.vertices.size());
+
+		optimize_index_order(list.vertices, list.indices);
+
+		auto [shadow_vertices, shadow_indices] = optimize_primitive(
+			list.vertices | std::views::transform(to_shadow_vertex) | std::ranges::to<std::vector>(),
+			list.indices
+		);
+		if (weld_shadow_positions) weld_positions(shadow_vertices, shadow_indices);
+
+		return {
+			.vertices = std::move(list.vertices),
+			.indices = std::move(list.indices),
+			.shadow_vertices = std::move(shadow_vertices),
+			.shadow_indices = std::move(shadow_indices),
+			.source_statistics = source_statistics
+		};
+	}
+
+	// Optimize an unindexed triangle list, welding duplicates in both full and shadow vertex lists. Shadow
+	// vertices are welded by position alone if `weld_shadow_positions` is set.
+	template <typename V, typename S>
+	static OptimizedPrimitiveLists<V, S> optimize_triangle_list(
+		const std::vector<V>& vertices,
+		S (*to_shadow_vertex)(const V&),
+		bool weld_shadow_positions
+	) noexcept
+	{
+		auto [optimized_vertices, optimized_indices] = optimize_primitive(vertices);
+		auto [shadow_vertices, shadow_indices] = optimize_primitive(
+			vertices | std::views::transform(to_shadow_vertex) | std::ranges::to<std::vector>()
+		);
+		if (weld_shadow_positions) weld_positions(shadow_vertices, shadow_indices);
+
+		// Every corner is a vertex transformed once
+		const StreamStatistics source_statistics{
+			.vertex_count = vertices.size(),
+			.triangle_count = vertices.size() / 3,
+			.transformed_count = vertices.size()
+		};
+
+		return {
+			.vertices = std::move(optimized_vertices),
+			.indices = std::move(optimized_indices),
+			.shadow_vertices = std::move(shadow_vertices),
+			.shadow_indices = std::move(shadow_indices),
+			.source_statistics = source_statistics
+		};
+	}
+
+	std::expected<Primitive, util::Error> Primitive::from_tinygltf(
+		const tinygltf::Model& model,
+		const tinygltf::Primitive& primitive,
+		const LodConfig& lod_config
+	) noexcept
 	{
 		if (primitive.attributes.contains("JOINTS_0") || primitive.attributes.contains("WEIGHTS_0"))
 			return util::Error(
@@ -90,16 +367,57 @@ namespace gltf
 
 		/* Acquire & Process Vertex List */
 
-		auto vertex_list_result = get_primitive_list(model, primitive);
-		if (!vertex_list_result)
-			return vertex_list_result.error().forward("Get primitive vertex list failed");
+		auto indexed_list_result = get_indexed_primitive_list(model, primitive);
+		if (!indexed_list_result)
+			return indexed_list_result.error().forward("Get indexed primitive vertex list failed");
 
-		auto [optimized_vertices, optimized_indices] = optimize_primitive(*vertex_list_result);
-		auto [optimized_shadow_vertices, optimized_shadow_indices] = optimize_primitive(
-			*vertex_list_result
-			| std::views::transform(&ShadowVertex::from_vertex)
-			| std::ranges::to<std::vector>()
-		);
+		OptimizedPrimitiveLists<Vertex, ShadowVertex> lists;
+		const bool weld_shadow_positions = shadow_position_only(model, primitive);
+
+		if (indexed_list_result->has_value())
+			lists = optimize_indexed_list(
+				std::move(**indexed_list_result),
+				&ShadowVertex::from_vertex,
+				weld_shadow_positions
+			);
+		else
+		{
+			auto vertex_list_result = get_primitive_list(model, primitive);
+			if (!vertex_list_result)
+				return vertex_list_result.error().forward("Get primitive vertex list failed");
+
+			lists = optimize_triangle_list(
+				*vertex_list_result,
+				&ShadowVertex::from_vertex,
+				weld_shadow_positions
+			);
+		}
+
+		auto& [optimized_vertices,
+			   optimized_indices,
+			   optimized_shadow_vertices,
+			   optimized_shadow_indices,
+			   source_statistics] = lists;
+
+		auto meshlets = build_meshlets(optimized_vertices, optimized_indices);
+		auto lods = generate_lods(optimized_vertices, optimized_indices, lod_config);
+		auto shadow_lods = generate_lods(optimized_shadow_vertices, optimized_shadow_indices, lod_config);
+
+		optimize_vertex_fetch(optimized_vertices, optimized_indices);
+		optimize_vertex_fetch(optimized_shadow_vertices, optimized_shadow_indices);
+
+		const MeshStatistics statistics{
+			.primitive_count = 1,
+			.source = source_statistics,
+			.optimized = analyze_vertex_cache(
+				std::span(optimized_indices).first(lods.front().index_count),
+				optimized_vertices.size()
+			),
+			.shadow_optimized = analyze_vertex_cache(
+				std::span(optimized_shadow_indices).first(shadow_lods.front().index_count),
+				optimized_shadow_vertices.size()
+			)
+		};
 
 		/* Calculate Min/Max */
 
@@ -131,31 +449,76 @@ namespace gltf
 		return Primitive{
 			.vertices = std::move(optimized_vertices),
 			.indices = std::move(optimized_indices),
+			.lods = std::move(lods),
+			.meshlets = std::move(meshlets),
 			.shadow_vertices = std::move(optimized_shadow_vertices),
 			.shadow_indices = std::move(optimized_shadow_indices),
+			.shadow_lods = std::move(shadow_lods),
 			.material = primitive.material == -1 ? std::nullopt : std::optional<uint32_t>(primitive.material),
 			.position_min = position_min,
 			.position_max = position_max,
+			.statistics = statistics
 		};
 	}
 
 	std::expected<RiggedPrimitive, util::Error> RiggedPrimitive::from_tinygltf(
 		const tinygltf::Model& model,
-		const tinygltf::Primitive& primitive
+		const tinygltf::Primitive& primitive,
+		const LodConfig& lod_config
 	) noexcept
 	{
 		/* Acquire & Process Vertex List */
 
-		auto vertex_list_result = get_rigged_primitive_list(model, primitive);
-		if (!vertex_list_result)
-			return vertex_list_result.error().forward("Get rigged primitive vertex list failed");
+		auto indexed_list_result = get_indexed_rigged_primitive_list(model, primitive);
+		if (!indexed_list_result)
+			return indexed_list_result.error().forward("Get indexed rigged primitive vertex list failed");
 
-		auto [optimized_vertices, optimized_indices] = optimize_primitive(*vertex_list_result);
-		auto [optimized_shadow_vertices, optimized_shadow_indices] = optimize_primitive(
-			*vertex_list_result
-			| std::views::transform(&RiggedShadowVertex::from_rigged_vertex)
-			| std::ranges::to<std::vector>()
-		);
+		OptimizedPrimitiveLists<RiggedVertex, RiggedShadowVertex> lists;
+
+		// Vertices sharing a position may differ in joints, shadow vertices are never welded by position
+		if (indexed_list_result->has_value())
+			lists = optimize_indexed_list(
+				std::move(**indexed_list_result),
+				&RiggedShadowVertex::from_rigged_vertex,
+				false
+			);
+		else
+		{
+			auto vertex_list_result = get_rigged_primitive_list(model, primitive);
+			if (!vertex_list_result)
+				return vertex_list_result.error().forward("Get rigged primitive vertex list failed");
+
+			lists = optimize_triangle_list(
+				*vertex_list_result,
+				&RiggedShadowVertex::from_rigged_vertex,
+				false
+			);
+		}
+
+		auto& [optimized_vertices,
+			   optimized_indices,
+			   optimized_shadow_vertices,
+			   optimized_shadow_indices,
+			   source_statistics] = lists;
+
+		auto lods = generate_lods(optimized_vertices, optimized_indices, lod_config);
+		auto shadow_lods = generate_lods(optimized_shadow_vertices, optimized_shadow_indices, lod_config);
+
+		optimize_vertex_fetch(optimized_vertices, optimized_indices);
+		optimize_vertex_fetch(optimized_shadow_vertices, optimized_shadow_indices);
+
+		const MeshStatistics statistics{
+			.primitive_count = 1,
+			.source = source_statistics,
+			.optimized = analyze_vertex_cache(
+				std::span(optimized_indices).first(lods.front().index_count),
+				optimized_vertices.size()
+			),
+			.shadow_optimized = analyze_vertex_cache(
+				std::span(optimized_shadow_indices).first(shadow_lods.front().index_count),
+				optimized_shadow_vertices.size()
+			)
+		};
 
 		/* Calculate Min/Max */
 
@@ -187,45 +550,108 @@ namespace gltf
 		return RiggedPrimitive{
 			.vertices = std::move(optimized_vertices),
 			.indices = std::move(optimized_indices),
+			.lods = std::move(lods),
 			.shadow_vertices = std::move(optimized_shadow_vertices),
 			.shadow_indices = std::move(optimized_shadow_indices),
+			.shadow_lods = std::move(shadow_lods),
 			.material = primitive.material == -1 ? std::nullopt : std::optional<uint32_t>(primitive.material),
 			.position_min = position_min,
-			.position_max = position_max
+			.position_max = position_max,
+			.statistics = statistics
 		};
 	}
 
-	std::expected<PrimitiveGPU, util::Error> PrimitiveGPU::from_primitive(
+	// View a type-erased vertex array as `T`, the size is validated by the producer of the view
+	template <typename T>
+	static std::span<const T> view_as(std::span<const std::byte> bytes) noexcept
+	{
+		return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+	}
+
+	// Upload an index buffer, 16-bit wide when every index fits
+	static std::expected<std::pair<gpu::Buffer, SDL_GPUIndexElementSize>, util::Error> create_index_buffer(
+		SDL_GPUDevice* device,
+		std::span<const uint32_t> indices,
+		const std::string& name
+	) noexcept
+	{
+		if (const auto narrowed = narrow_indices(indices); narrowed.has_value())
+			return graphics::create_buffer_from_data(device, {.index = true}, util::as_bytes(*narrowed), name)
+				.transform([](gpu::Buffer buffer) {
+					return std::pair(std::move(buffer), SDL_GPU_INDEXELEMENTSIZE_16BIT);
+				});
+
+		return graphics::create_buffer_from_data(device, {.index = true}, std::as_bytes(indices), name)
+			.transform([](gpu::Buffer buffer) {
+				return std::pair(std::move(buffer), SDL_GPU_INDEXELEMENTSIZE_32BIT);
+			});
+	}
+
+	std::expected<PrimitiveGPU, util::Error> PrimitiveGPU::from_view(
 		SDL_GPUDevice* device,
-		const Primitive& primitive
+		const PrimitiveView& view,
+		const MeshConfig& config
 	) noexcept
 	{
+		auto vertex_format = VertexFormat::Standard;
+		if (view.rigged)
+			vertex_format = VertexFormat::Rigged;
+		else if (config.quantize_vertices)
+			vertex_format = VertexFormat::Quantized;
+
+		std::vector<QuantizedVertex> quantized_vertices;
+		std::vector<QuantizedShadowVertex> quantized_shadow_vertices;
+		auto vertex_data = view.vertices;
+		auto shadow_vertex_data = view.shadow_vertices;
+
+		if (vertex_format == VertexFormat::Quantized)
+		{
+			quantized_vertices =
+				view_as<Vertex>(view.vertices)
+				| std::views::transform([&view](const Vertex& vertex) {
+					  return QuantizedVertex::from_vertex(vertex, view.position_min, view.position_max);
+				  })
+				| std::ranges::to<std::vector>();
+
+			quantized_shadow_vertices =
+				view_as<ShadowVertex>(view.shadow_vertices)
+				| std::views::transform([&view](const ShadowVertex& vertex) {
+					  return QuantizedShadowVertex::from_shadow_vertex(
+						  vertex,
+						  view.position_min,
+						  view.position_max
+					  );
+				  })
+				| std::ranges::to<std::vector>();
+
+			vertex_data = util::as_bytes(quantized_vertices);
+			shadow_vertex_data = util::as_bytes(quantized_shadow_vertices);
+		}
+
 		auto vertex_buffer = graphics::create_buffer_from_data(
 			device,
 			{.vertex = true},
-			util::as_bytes(primitive.vertices),
-			"GLTF Vertex Buffer"
+			vertex_data,
+			view.rigged ? "GLTF Rigged Vertex Buffer" : "GLTF Vertex Buffer"
 		);
 
-		auto index_buffer = graphics::create_buffer_from_data(
+		auto index_buffer = create_index_buffer(
 			device,
-			{.index = true},
-			util::as_bytes(primitive.indices),
-			"GLTF Index Buffer"
+			view.indices,
+			view.rigged ? "GLTF Rigged Index Buffer" : "GLTF Index Buffer"
 		);
 
 		auto shadow_vertex_buffer = graphics::create_buffer_from_data(
 			device,
 			{.vertex = true},
-			util::as_bytes(primitive.shadow_vertices),
-			"GLTF Shadow Vertex Buffer"
+			shadow_vertex_data,
+			view.rigged ? "GLTF Rigged Shadow Vertex Buffer" : "GLTF Shadow Vertex Buffer"
 		);
 
-		auto shadow_index_buffer = graphics::create_buffer_from_data(
+		auto shadow_index_buffer = create_index_buffer(
 			device,
-			{.index = true},
-			util::as_bytes(primitive.shadow_indices),
-			"GLTF Shadow Index Buffer"
+			view.shadow_indices,
+			view.rigged ? "GLTF Rigged Shadow Index Buffer" : "GLTF Shadow Index Buffer"
 		);
 
 		if (!vertex_buffer) return vertex_buffer.error().forward("Create vertex buffer failed");
@@ -236,18 +662,53 @@ namespace gltf
 			return shadow_index_buffer.error().forward("Create position index buffer failed");
 
 		return PrimitiveGPU{
-			.index_count = static_cast<uint32_t>(primitive.indices.size()),
+			.lods = std::vector(std::from_range, view.lods),
+			.shadow_lods = std::vector(std::from_range, view.shadow_lods),
+			.meshlets = std::vector(std::from_range, view.meshlets),
 
 			.vertex_buffer = std::move(*vertex_buffer),
-			.index_buffer = std::move(*index_buffer),
+			.index_buffer = std::move(index_buffer->first),
 			.shadow_vertex_buffer = std::move(*shadow_vertex_buffer),
-			.shadow_index_buffer = std::move(*shadow_index_buffer),
+			.shadow_index_buffer = std::move(shadow_index_buffer->first),
+			.index_element_size = index_buffer->second,
+			.shadow_index_element_size = shadow_index_buffer->second,
+
+			.material = view.material,
+			.position_min = view.position_min,
+			.position_max = view.position_max,
+			.vertex_format = vertex_format
+		};
+	}
 
+	// Get a type-erased view of a CPU-side primitive
+	template <typename T>
+	static PrimitiveView view_of(const T& primitive) noexcept
+	{
+		PrimitiveView view{
+			.vertices = util::as_bytes(primitive.vertices),
+			.indices = primitive.indices,
+			.lods = primitive.lods,
+			.shadow_vertices = util::as_bytes(primitive.shadow_vertices),
+			.shadow_indices = primitive.shadow_indices,
+			.shadow_lods = primitive.shadow_lods,
 			.material = primitive.material,
 			.position_min = primitive.position_min,
 			.position_max = primitive.position_max,
-			.rigged = false
+			.rigged = std::same_as<T, RiggedPrimitive>
 		};
+
+		if constexpr (std::same_as<T, Primitive>) view.meshlets = primitive.meshlets;
+
+		return view;
+	}
+
+	std::expected<PrimitiveGPU, util::Error> PrimitiveGPU::from_primitive(
+		SDL_GPUDevice* device,
+		const Primitive& primitive,
+		const MeshConfig& config
+	) noexcept
+	{
+		return from_view(device, view_of(primitive), config);
 	}
 
 	std::expected<PrimitiveGPU, util::Error> PrimitiveGPU::from_rigged_primitive(
@@ -255,59 +716,13 @@ namespace gltf
 		const RiggedPrimitive& primitive
 	) noexcept
 	{
-		auto vertex_buffer = graphics::create_buffer_from_data(
-			device,
-			{.vertex = true},
-			util::as_bytes(primitive.vertices),
-			"GLTF Rigged Vertex Buffer"
-		);
-
-		auto index_buffer = graphics::create_buffer_from_data(
-			device,
-			{.index = true},
-			util::as_bytes(primitive.indices),
-			"GLTF Rigged Index Buffer"
-		);
-
-		auto shadow_vertex_buffer = graphics::create_buffer_from_data(
-			device,
-			{.vertex = true},
-			util::as_bytes(primitive.shadow_vertices),
-			"GLTF Rigged Shadow Vertex Buffer"
-		);
-
-		auto shadow_index_buffer = graphics::create_buffer_from_data(
-			device,
-			{.index = true},
-			util::as_bytes(primitive.shadow_indices),
-			"GLTF Rigged Shadow Index Buffer"
-		);
-
-		if (!vertex_buffer) return vertex_buffer.error().forward("Create vertex buffer failed");
-		if (!index_buffer) return index_buffer.error().forward("Create index buffer failed");
-		if (!shadow_vertex_buffer)
-			return shadow_vertex_buffer.error().forward("Create position vertex buffer failed");
-		if (!shadow_index_buffer)
-			return shadow_index_buffer.error().forward("Create position index buffer failed");
-
-		return PrimitiveGPU{
-			.index_count = static_cast<uint32_t>(primitive.indices.size()),
-
-			.vertex_buffer = std::move(*vertex_buffer),
-			.index_buffer = std::move(*index_buffer),
-			.shadow_vertex_buffer = std::move(*shadow_vertex_buffer),
-			.shadow_index_buffer = std::move(*shadow_index_buffer),
-
-			.material = primitive.material,
-			.position_min = primitive.position_min,
-			.position_max = primitive.position_max,
-			.rigged = true
-		};
+		return from_view(device, view_of(primitive));
 	}
 
 	std::expected<Mesh, util::Error> Mesh::from_tinygltf(
 		const tinygltf::Model& model,
-		const tinygltf::Mesh& mesh
+		const tinygltf::Mesh& mesh,
+		const LodConfig& lod_config
 	) noexcept
 	{
 		std::vector<Primitive> primitives;
@@ -319,7 +734,7 @@ namespace gltf
 		{
 			if (primitive.attributes.contains("JOINTS_0") || primitive.attributes.contains("WEIGHTS_0"))
 			{
-				auto rigged_primitive_result = RiggedPrimitive::from_tinygltf(model, primitive);
+				auto rigged_primitive_result = RiggedPrimitive::from_tinygltf(model, primitive, lod_config);
 				if (!rigged_primitive_result)
 					return rigged_primitive_result.error().forward("Create Rigged_Primitive failed");
 
@@ -327,7 +742,7 @@ namespace gltf
 			}
 			else
 			{
-				auto primitive_result = Primitive::from_tinygltf(model, primitive);
+				auto primitive_result = Primitive::from_tinygltf(model, primitive, lod_config);
 				if (!primitive_result) return primitive_result.error().forward("Create Primitive failed");
 
 				primitives.emplace_back(std::move(*primitive_result));
@@ -337,14 +752,18 @@ namespace gltf
 		return Mesh{.primitives = std::move(primitives), .rigged_primitives = std::move(rigged_primitives)};
 	}
 
-	std::expected<MeshGPU, util::Error> MeshGPU::from_mesh(SDL_GPUDevice* device, const Mesh& mesh) noexcept
+	std::expected<MeshGPU, util::Error> MeshGPU::from_mesh(
+		SDL_GPUDevice* device,
+		const Mesh& mesh,
+		const MeshConfig& config
+	) noexcept
 	{
 		std::vector<PrimitiveGPU> primitives;
 		primitives.reserve(mesh.primitives.size() + mesh.rigged_primitives.size());
 
 		for (const auto& primitive : mesh.primitives)
 		{
-			auto primitive_result = PrimitiveGPU::from_primitive(device, primitive);
+			auto primitive_result = PrimitiveGPU::from_primitive(device, primitive, config);
 			if (!primitive_result) return primitive_result.error().forward("Create Primitive_gpu failed");
 
 			primitives.emplace_back(std::move(*primitive_result));
@@ -361,4 +780,169 @@ namespace gltf
 
 		return MeshGPU{.primitives = std::move(primitives)};
 	}
+
+	// Serialize a primitive view, see `MeshGPU::from_baked` for the reverse
+	static void bake_primitive(detail::bake::Writer& writer, const PrimitiveView& view) noexcept
+	{
+		writer.write<uint8_t>(view.rigged ? 1 : 0);
+		writer.write_array(view.vertices);
+		writer.write_array(view.indices);
+		writer.write_array(view.lods);
+		writer.write_array(view.meshlets);
+		writer.write_array(view.shadow_vertices);
+		writer.write_array(view.shadow_indices);
+		writer.write_array(view.shadow_lods);
+		writer.write_optional(view.material);
+		writer.write(view.position_min);
+		writer.write(view.position_max);
+	}
+
+	void Mesh::bake(detail::bake::Writer& writer) const noexcept
+	{
+		writer.write<uint64_t>(primitives.size() + rigged_primitives.size());
+
+		for (const auto& primitive : primitives) bake_primitive(writer, view_of(primitive));
+		for (const auto& rigged_primitive : rigged_primitives)
+			bake_primitive(writer, view_of(rigged_primitive));
+	}
+
+	MeshStatistics Mesh::get_statistics() const noexcept
+	{
+		MeshStatistics statistics;
+		for (const auto& primitive : primitives) statistics += primitive.statistics;
+		for (const auto& rigged_primitive : rigged_primitives) statistics += rigged_primitive.statistics;
+		return statistics;
+	}
+
+	// Whether a non-empty level of detail chain stays within an index buffer of `index_count`
+	static bool lods_in_range(std::span<const PrimitiveLod> lods, size_t index_count) noexcept
+	{
+		if (lods.empty()) return false;
+
+		return std::ranges::all_of(lods, [index_count](const PrimitiveLod& lod) {
+			return lod.index_count % 3 == 0 && size_t(lod.first_index) + lod.index_count <= index_count;
+		});
+	}
+
+	// Whether meshlets stay within the full detail level
+	static bool meshlets_in_range(std::span<const Meshlet> meshlets, const PrimitiveLod& full_detail) noexcept
+	{
+		const auto end = size_t(full_detail.first_index) + full_detail.index_count;
+		return std::ranges::all_of(meshlets, [&full_detail, end](const Meshlet& meshlet) {
+			return meshlet.first_index >= full_detail.first_index
+				&& size_t(meshlet.first_index) + meshlet.index_count <= end;
+		});
+	}
+
+	// Read a primitive view written by `bake_primitive`, validating buffer sizes
+	static std::expected<PrimitiveView, util::Error> read_baked_primitive(
+		detail::bake::Reader& reader
+	) noexcept
+	{
+		const auto rigged = reader.read<uint8_t>();
+		if (!rigged) return rigged.error();
+
+		const auto vertices = reader.read_array<std::byte>();
+		if (!vertices) return vertices.error().forward("Read vertices failed");
+
+		const auto indices = reader.read_array<uint32_t>();
+		if (!indices) return indices.error().forward("Read indices failed");
+
+		const auto lods = reader.read_array<PrimitiveLod>();
+		if (!lods) return lods.error().forward("Read levels of detail failed");
+
+		const auto meshlets = reader.read_array<Meshlet>();
+		if (!meshlets) return meshlets.error().forward("Read meshlets failed");
+
+		const auto shadow_vertices = reader.read_array<std::byte>();
+		if (!shadow_vertices) return shadow_vertices.error().forward("Read shadow vertices failed");
+
+		const auto shadow_indices = reader.read_array<uint32_t>();
+		if (!shadow_indices) return shadow_indices.error().forward("Read shadow indices failed");
+
+		const auto shadow_lods = reader.read_array<PrimitiveLod>();
+		if (!shadow_lods) return shadow_lods.error().forward("Read shadow levels of detail failed");
+
+		const auto material = reader.read_optional<uint32_t>();
+		if (!material) return material.error().forward("Read material failed");
+
+		const auto position_min = reader.read<glm::vec3>();
+		if (!position_min) return position_min.error().forward("Read bounds failed");
+
+		const auto position_max = reader.read<glm::vec3>();
+		if (!position_max) return position_max.error().forward("Read bounds failed");
+
+		const size_t vertex_size = *rigged != 0 ? sizeof(RiggedVertex) : sizeof(Vertex);
+		const size_t shadow_vertex_size = *rigged != 0 ? sizeof(RiggedShadowVertex) : sizeof(ShadowVertex);
+
+		if (vertices->size() % vertex_size != 0 || shadow_vertices->size() % shadow_vertex_size != 0)
+			return util::Error("Baked vertex buffer size is not a multiple of vertex size");
+		if (indices->size() % 3 != 0 || shadow_indices->size() % 3 != 0)
+			return util::Error("Baked index count is not a multiple of 3");
+		if (!lods_in_range(*lods, indices->size()) || !lods_in_range(*shadow_lods, shadow_indices->size()))
+			return util::Error("Baked levels of detail exceed the index buffer");
+		if (!meshlets_in_range(*meshlets, lods->front()))
+			return util::Error("Baked meshlets exceed the full detail level");
+
+		return PrimitiveView{
+			.vertices = *vertices,
+			.indices = *indices,
+			.lods = *lods,
+			.meshlets = *meshlets,
+			.shadow_vertices = *shadow_vertices,
+			.shadow_indices = *shadow_indices,
+			.shadow_lods = *shadow_lods,
+			.material = *material,
+			.position_min = *position_min,
+			.position_max = *position_max,
+			.rigged = *rigged != 0
+		};
+	}
+
+	// Keep the first `max_level_count` levels of detail of a view, and only the indices they use
+	static void truncate_lods(PrimitiveView& view, uint32_t max_level_count) noexcept
+	{
+		const auto truncate = [max_level_count](
+								  std::span<const PrimitiveLod>& lods,
+								  std::span<const uint32_t>& indices
+							  ) {
+			lods = lods.first(std::clamp<size_t>(max_level_count, 1, lods.size()));
+
+			const auto used_index_count = std::ranges::max(
+				lods | std::views::transform([](const PrimitiveLod& lod) {
+					return size_t(lod.first_index) + lod.index_count;
+				})
+			);
+			indices = indices.first(used_index_count);
+		};
+
+		truncate(view.lods, view.indices);
+		truncate(view.shadow_lods, view.shadow_indices);
+	}
+
+	std::expected<MeshGPU, util::Error> MeshGPU::from_baked(
+		SDL_GPUDevice* device,
+		detail::bake::Reader& reader,
+		const MeshConfig& config
+	) noexcept
+	{
+		const auto primitive_count = reader.read<uint64_t>();
+		if (!primitive_count) return primitive_count.error().forward("Read primitive count failed");
+
+		std::vector<PrimitiveGPU> primitives;
+
+		for (const auto idx : std::views::iota(0zu, *primitive_count))
+		{
+			auto view = read_baked_primitive(reader);
+			if (!view) return view.error().forward(std::format("Read primitive {} failed", idx));
+			truncate_lods(*view, config.lod.max_level_count);
+
+			auto primitive_result = PrimitiveGPU::from_view(device, *view, config);
+			if (!primitive_result) return primitive_result.error().forward("Create Primitive_gpu failed");
+
+			primitives.emplace_back(std::move(*primitive_result));
+		}
+
+		return MeshGPU{.primitives = std::move(primitives)};
+	}
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "gltf/meshlet.hpp"
+#include "graphics/culling.hpp"
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+
+namespace gltf
+{
+	void cull_meshlets(
+		std::span<const Meshlet> meshlets,
+		const glm::mat4& world_matrix,
+		std::span<const glm::vec4> frustum_planes,
+		const glm::vec3& eye_position,
+		bool cull_backfacing,
+		std::pmr::vector<std::pair<uint32_t, uint32_t>>& ranges
+	) noexcept
+	{
+		// Plane `p` in world space is `transpose(M) * p` in local space, eye is transformed back with `M^-1`
+		std::array<glm::vec4, 6> local_planes;
+		const auto plane_count = std::min(frustum_planes.size(), local_planes.size());
+		const auto world_matrix_t = glm::transpose(world_matrix);
+		for (const auto idx : std::views::iota(0zu, plane_count))
+			local_planes[idx] = world_matrix_t * frustum_planes[idx];
+
+		const auto local_eye = glm::vec3(glm::inverse(world_matrix) * glm::vec4(eye_position, 1.0f));
+
+		// Back-face test is exact in local space for any affine transform, unless it flips the winding
+		const bool test_cone = cull_backfacing && glm::determinant(glm::mat3(world_matrix)) > 0.0f;
+
+		const auto planes = std::span(local_planes).first(plane_count);
+		const auto first_range = ranges.size();
+
+		for (const auto& meshlet : meshlets)
+		{
+			if (!graphics::sphere_in_frustum(meshlet.center, meshlet.radius, planes)) continue;
+
+			if (test_cone
+				&& graphics::cone_backfacing(
+					meshlet.cone_apex,
+					meshlet.cone_axis,
+					meshlet.cone_cutoff,
+					local_eye
+				))
+				continue;
+
+			// Merge with the previous range of this primitive if contiguous
+			auto* const previous = ranges.size() > first_range ? &ranges.back() : nullptr;
+			if (previous != nullptr && previous->first + previous->second == meshlet.first_index)
+				previous->second += meshlet.index_count;
+			else
+				ranges.emplace_back(meshlet.first_index, meshlet.index_count);
+		}
+	}
+}
\ No newline at end of file
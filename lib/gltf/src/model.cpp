@@ -1,9 +1,15 @@
 #include "gltf/model.hpp"
 #include "gltf/skin.hpp"
 #include "graphics/culling.hpp"
+#include "util/file.hpp"
+#include "util/mapped-file.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <queue>
 #include <ranges>
 #include <set>
@@ -83,62 +89,410 @@ namespace gltf
 
 		std::set<uint32_t> visited_nodes;
 
+		// Breadth-first, so nodes of the same depth are contiguous
 		while (!process_queue.empty())
 		{
-			const auto node_index = process_queue.front();
-			process_queue.pop();
+			node_level_offsets.push_back(node_topo_order.size());
 
-			node_topo_order.push_back(node_index);
+			for (auto level_size = process_queue.size(); level_size > 0; level_size--)
+			{
+				const auto node_index = process_queue.front();
+				process_queue.pop();
 
-			if (visited_nodes.contains(node_index)) return util::Error("Cycle detected in node graph");
-			visited_nodes.insert(node_index);
+				node_topo_order.push_back(node_index);
 
-			process_queue.push_range(nodes[node_index].children);
+				if (visited_nodes.contains(node_index)) return util::Error("Cycle detected in node graph");
+				visited_nodes.insert(node_index);
+
+				process_queue.push_range(nodes[node_index].children);
+			}
+		}
+
+		node_level_offsets.push_back(node_topo_order.size());
+
+		return {};
+	}
+
+	void Model::init_transform_state() noexcept
+	{
+		auto& state = transform_state;
+
+		state.node_overrides.assign(nodes.size(), {});
+		state.node_world_matrices.assign(nodes.size(), glm::mat4(1.0f));
+		state.skin_bounds.assign(skin_list.skin_offsets.size(), {});
+		state.node_dirty.assign(nodes.size(), true);
+		state.local_trs.resize(node_topo_order.size());
+		state.local_matrices.assign(node_topo_order.size(), glm::mat4(1.0f));
+		state.matrix_local.assign(node_topo_order.size(), false);
+		state.node_drawcall_ranges.assign(nodes.size(), {0, 0});
+		state.animation_cursors =
+			animations
+			| std::views::transform([](const Animation& animation) {
+				  return std::vector<uint32_t>(animation.channel_count(), 0);
+			  })
+			| std::ranges::to<std::vector>();
+
+		for (const auto node_index : node_topo_order)
+		{
+			const auto& node = nodes[node_index];
+			if (!renderable_nodes[node_index] || !node.mesh.has_value()) continue;
+
+			const auto offset = static_cast<uint32_t>(state.drawcalls.size());
+
+			for (const auto& primitive : meshes[*node.mesh].primitives)
+			{
+				const auto [gen_data, local_min, local_max] = primitive.gen_drawdata();
+
+				// Transforms and bounds are filled in by the first `update_drawcalls()`
+				state.drawcalls.emplace_back(
+					PrimitiveDrawcall{
+						.world_position_min = local_min,
+						.world_position_max = local_max,
+						.material_index = primitive.material,
+						.transform_or_joint_matrix_offset = node.skin.has_value()
+							? std::variant<glm::mat4, uint32_t>(skin_list[*node.skin].offset)
+							: std::variant<glm::mat4, uint32_t>(glm::mat4(1.0f)),
+						.primitive = gen_data,
+					}
+				);
+			}
+
+			state.drawcall_nodes.push_back(node_index);
+			const auto count = static_cast<uint32_t>(state.drawcalls.size()) - offset;
+			state.node_drawcall_ranges[node_index] = {offset, count};
+			if (node.skin.has_value()) state.skinned_drawcall_count += count;
+		}
+	}
+
+	std::pair<glm::vec3, glm::vec3> Model::SkinBoundTable::lookup(
+		size_t skinned_drawcall_count,
+		size_t skinned_drawcall,
+		float time
+	) const noexcept
+	{
+		const float position = bucket_duration > 0.0f ? (time - start_time) / bucket_duration : 0.0f;
+		const float clamped = position > 0.0f ? std::min(position, float(bucket_count - 1)) : 0.0f;
+		return bounds[static_cast<size_t>(clamped) * skinned_drawcall_count + skinned_drawcall];
+	}
+
+	void Model::precompute_skin_bounds(float sample_rate) noexcept
+	{
+		assert(sample_rate > 0.0f);
+
+		animation_skin_bounds.clear();
+
+		const auto& state = transform_state;
+		const auto skinned_drawcall_count = state.skinned_drawcall_count;
+		if (skinned_drawcall_count == 0) return;
+
+		using Bounds = std::pair<glm::vec3, glm::vec3>;
+		const Bounds empty_bounds = {
+			glm::vec3(std::numeric_limits<float>::max()),
+			glm::vec3(std::numeric_limits<float>::lowest())
+		};
+		const auto merge = [](const Bounds& a, const Bounds& b) -> Bounds {
+			return {glm::min(a.first, b.first), glm::max(a.second, b.second)};
+		};
+
+		// Bounds of all rigged drawcalls at one sample or bucket
+		const auto slice = [skinned_drawcall_count](std::vector<Bounds>& list, size_t index) {
+			return std::span(list).subspan(index * skinned_drawcall_count, skinned_drawcall_count);
+		};
+
+		std::vector<Node::TransformOverride> overrides(nodes.size());
+		std::vector<glm::mat4> world_matrices(nodes.size(), glm::mat4(1.0f));
+		std::vector<glm::mat4> joint_matrices(skin_list.joints.size());
+
+		// Compute model-space bounds of every rigged drawcall, posed by `animation` at `time`. The skinned
+		// position is a convex blend of the vertex transformed by its joints, so the union of the primitive
+		// box transformed by each joint of the skin contains it.
+		const auto sample_bounds = [&](const Animation& animation,
+									   float time,
+									   std::span<uint32_t> cursors,
+									   std::span<Bounds> sample) {
+			std::ranges::fill(overrides, Node::TransformOverride());
+			animation.apply(overrides, time, cursors);
+
+			for (const auto node_index : node_topo_order)
+			{
+				const auto local_matrix = nodes[node_index].get_local_transform(overrides[node_index]);
+				const auto parent_index = node_parents[node_index];
+				world_matrices[node_index] =
+					parent_index.has_value() ? world_matrices[*parent_index] * local_matrix : local_matrix;
+			}
+
+			for (const auto [joint_matrix, inverse_bind_matrix, joint_index] :
+				 std::views::zip(joint_matrices, skin_list.inverse_bind_matrices, skin_list.joints))
+				joint_matrix = world_matrices[joint_index] * inverse_bind_matrix;
+
+			auto sample_it = sample.begin();
+			for (const auto node_index : state.drawcall_nodes)
+			{
+				const auto& node = nodes[node_index];
+				if (!node.skin.has_value()) continue;
+
+				const auto [offset, length] = skin_list.skin_offsets[*node.skin];
+				const auto skin_joint_matrices = std::span(joint_matrices).subspan(offset, length);
+
+				for (const auto& primitive : meshes[node.mesh.value()].primitives)
+				{
+					auto bounds = empty_bounds;
+					for (const auto& joint_matrix : skin_joint_matrices)
+						bounds = merge(
+							bounds,
+							graphics::local_bound_to_world(
+								primitive.position_min,
+								primitive.position_max,
+								joint_matrix
+							)
+						);
+					*sample_it++ = bounds;
+				}
+			}
+		};
+
+		animation_skin_bounds.reserve(animations.size());
+
+		for (const auto& animation : animations)
+		{
+			auto [start_time, end_time] = animation.time_range();
+			if (start_time > end_time) start_time = end_time = 0.0f;  // No channels
+
+			const auto bucket_count =
+				std::max(static_cast<uint32_t>(std::ceil((end_time - start_time) * sample_rate)), 1u);
+			const auto bucket_duration = (end_time - start_time) / bucket_count;
+
+			// Samples at both ends of every bucket. Time advances monotonically, so cursors make each
+			// sample cheap.
+			std::vector<Bounds> samples((bucket_count + 1) * size_t(skinned_drawcall_count));
+			std::vector<uint32_t> cursors(animation.channel_count(), 0);
+			for (const auto sample_index : std::views::iota(0u, bucket_count + 1))
+				sample_bounds(
+					animation,
+					start_time + sample_index * bucket_duration,
+					cursors,
+					slice(samples, sample_index)
+				);
+
+			// Each bucket covers its own samples and those of both neighbouring buckets, so poses slightly
+			// outside the sampled ones still fall in the bounds
+			SkinBoundTable table{
+				.start_time = start_time,
+				.bucket_duration = bucket_duration,
+				.bucket_count = bucket_count,
+				.bounds = std::vector<Bounds>(bucket_count * size_t(skinned_drawcall_count), empty_bounds)
+			};
+
+			for (const auto bucket : std::views::iota(0u, bucket_count))
+			{
+				const auto first_sample = bucket > 0 ? bucket - 1 : 0u;
+				const auto last_sample = std::min(bucket + 2, bucket_count);
+				const auto bucket_bounds = slice(table.bounds, bucket);
+
+				for (const auto sample_index : std::views::iota(first_sample, last_sample + 1))
+				{
+					const auto sample = slice(samples, sample_index);
+					for (auto&& [bounds, sampled] : std::views::zip(bucket_bounds, sample))
+						bounds = merge(bounds, sampled);
+				}
+			}
+
+			animation_skin_bounds.push_back(std::move(table));
 		}
+	}
+
+	std::expected<void, util::Error> Model::postprocess() noexcept
+	{
+		compute_node_parents();
+
+		auto topo_order_result = compute_topo_order();
+		if (!topo_order_result)
+			return topo_order_result.error().forward("Compute node topological order failed");
+
+		compute_renderable_nodes();
+		init_transform_state();
+		precompute_skin_bounds(default_skin_bound_sample_rate);
+
+		auto material_bind_cache_result = material_list.gen_material_cache();
+		if (!material_bind_cache_result) return util::Error("Generate material bind cache failed");
+		material_bind_cache = std::move(*material_bind_cache_result);
 
 		return {};
 	}
 
 	namespace detail
 	{
-		static std::expected<std::vector<MeshGPU>, util::Error> load_meshes(
-			SDL_GPUDevice* device,
+		static std::expected<std::vector<Node>, util::Error> load_nodes(
+			const tinygltf::Model& tinygltf_model
+		) noexcept
+		{
+			std::vector<Node> nodes;
+			nodes.reserve(tinygltf_model.nodes.size());
+
+			for (const auto& tinygltf_node : tinygltf_model.nodes)
+			{
+				auto node_result = Node::from_tinygltf(tinygltf_model, tinygltf_node);
+				if (!node_result) return node_result.error().forward("Create node from tinygltf failed");
+
+				nodes.emplace_back(std::move(*node_result));
+			}
+
+			return nodes;
+		}
+
+		static std::expected<std::vector<Light>, util::Error> load_lights(
+			const tinygltf::Model& tinygltf_model
+		) noexcept
+		{
+			std::vector<Light> lights;
+
+			for (const auto& [idx, tinygltf_light] : tinygltf_model.lights | std::views::enumerate)
+			{
+				auto light_result = parse_light(tinygltf_light);
+				if (!light_result)
+					return light_result.error().forward(std::format("Parse light failed at index {}", idx));
+				lights.emplace_back(*light_result);
+			}
+
+			return lights;
+		}
+
+		using ParsedPrimitive = std::variant<Primitive, RiggedPrimitive>;
+
+		// Parse a primitive, rigged if it carries skinning attributes
+		static std::expected<ParsedPrimitive, util::Error> parse_primitive(
+			const tinygltf::Model& tinygltf_model,
+			const tinygltf::Primitive& tinygltf_primitive,
+			const LodConfig& lod_config
+		) noexcept
+		{
+			if (tinygltf_primitive.attributes.contains("JOINTS_0")
+				|| tinygltf_primitive.attributes.contains("WEIGHTS_0"))
+			{
+				auto rigged_result =
+					RiggedPrimitive::from_tinygltf(tinygltf_model, tinygltf_primitive, lod_config);
+				if (!rigged_result)
+					return rigged_result.error().forward("Create Rigged_Primitive failed");
+
+				return std::move(*rigged_result);
+			}
+
+			auto primitive_result = Primitive::from_tinygltf(tinygltf_model, tinygltf_primitive, lod_config);
+			if (!primitive_result) return primitive_result.error().forward("Create Primitive failed");
+
+			return std::move(*primitive_result);
+		}
+
+		// Parse all meshes on the CPU side. Each primitive is a separate task, so that meshes with many
+		// primitives don't serialize the loading.
+		static std::expected<std::vector<Mesh>, util::Error> parse_meshes(
 			const tinygltf::Model& tinygltf_model,
+			const LodConfig& lod_config,
 			const std::optional<std::reference_wrapper<std::atomic<Model::LoadProgress>>>& progress
 		) noexcept
 		{
+			const auto primitive_count = std::ranges::fold_left(
+				tinygltf_model.meshes | std::views::transform([](const tinygltf::Mesh& mesh) {
+					return mesh.primitives.size();
+				}),
+				0zu,
+				std::plus()
+			);
+
 			std::mutex progress_mutex;
 			uint32_t progress_count = 0;
 			dp::thread_pool thread_pool(std::thread::hardware_concurrency());
 
-			const auto task =
-				[device, &progress, &progress_count, &progress_mutex, &tinygltf_model](
-					const tinygltf::Mesh& tinygltf_mesh
-				) -> std::expected<MeshGPU, util::Error> {
-				auto mesh_cpu = Mesh::from_tinygltf(tinygltf_model, tinygltf_mesh);
-				if (!mesh_cpu) return mesh_cpu.error().forward("Create mesh from tinygltf failed");
-
-				auto mesh_gpu = MeshGPU::from_mesh(device, *mesh_cpu);
-				if (!mesh_gpu) return mesh_gpu.error().forward("Create mesh GPU resources failed");
+			const auto enqueue_primitive = [&](const tinygltf::Primitive& tinygltf_primitive) {
+				return thread_pool.enqueue([&, primitive_ptr = &tinygltf_primitive] {
+					auto primitive = parse_primitive(tinygltf_model, *primitive_ptr, lod_config);
 
-				{
 					std::scoped_lock lock(progress_mutex);
 					progress_count++;
 
 					if (progress.has_value())
 						progress->get() = {
 							.stage = Model::LoadStage::Mesh,
-							.progress = float(progress_count) / tinygltf_model.meshes.size()
+							.progress = float(progress_count) / primitive_count
 						};
-				}
 
-				return mesh_gpu;
+					return primitive;
+				});
 			};
 
-			std::vector<std::future<std::expected<MeshGPU, util::Error>>> mesh_futures =
+			// Futures of each mesh's primitives
+			auto primitive_futures =
 				tinygltf_model.meshes
-				| std::views::transform([&](const auto& tinygltf_mesh) {
-					  return thread_pool.enqueue(std::bind(task, tinygltf_mesh));
+				| std::views::transform([&](const tinygltf::Mesh& tinygltf_mesh) {
+					  return tinygltf_mesh.primitives
+						  | std::views::transform(enqueue_primitive)
+						  | std::ranges::to<std::vector>();
+				  })
+				| std::ranges::to<std::vector>();
+
+			thread_pool.wait_for_tasks();
+
+			std::vector<Mesh> meshes;
+			meshes.reserve(primitive_futures.size());
+
+			for (auto [mesh_idx, futures] : primitive_futures | std::views::enumerate)
+			{
+				Mesh mesh;
+
+				for (auto [primitive_idx, future] : futures | std::views::enumerate)
+				{
+					auto result = future.get();
+					if (!result)
+						return result.error()
+							.forward(std::format("Parse primitive failed at index {}", primitive_idx))
+							.forward(std::format("Parse mesh failed at index {}", mesh_idx));
+
+					if (auto* rigged_primitive = std::get_if<RiggedPrimitive>(&*result))
+						mesh.rigged_primitives.emplace_back(std::move(*rigged_primitive));
+					else
+						mesh.primitives.emplace_back(std::get<Primitive>(std::move(*result)));
+				}
+
+				meshes.emplace_back(std::move(mesh));
+			}
+
+			return meshes;
+		}
+
+		// Sum optimization statistics of all meshes
+		static MeshStatistics sum_statistics(std::span<const Mesh> meshes) noexcept
+		{
+			MeshStatistics statistics;
+			for (const auto& mesh : meshes) statistics += mesh.get_statistics();
+			return statistics;
+		}
+
+		// Parse and upload all meshes, outputs their optimization statistics to `statistics`
+		static std::expected<std::vector<MeshGPU>, util::Error> load_meshes(
+			SDL_GPUDevice* device,
+			const tinygltf::Model& tinygltf_model,
+			const MeshConfig& mesh_config,
+			const std::optional<std::reference_wrapper<std::atomic<Model::LoadProgress>>>& progress,
+			MeshStatistics& statistics
+		) noexcept
+		{
+			auto parse_result = parse_meshes(tinygltf_model, mesh_config.lod, progress);
+			if (!parse_result) return parse_result.error();
+			auto& meshes_cpu = *parse_result;
+
+			statistics = sum_statistics(meshes_cpu);
+
+			dp::thread_pool thread_pool(std::thread::hardware_concurrency());
+
+			// CPU data of each mesh is released as soon as it is uploaded
+			auto mesh_futures =
+				meshes_cpu
+				| std::views::transform([&](Mesh& mesh_cpu) {
+					  return thread_pool.enqueue([device, &mesh_config, mesh_ptr = &mesh_cpu] {
+						  auto mesh_gpu = MeshGPU::from_mesh(device, *mesh_ptr, mesh_config);
+						  *mesh_ptr = {};
+						  return mesh_gpu;
+					  });
 				  })
 				| std::ranges::to<std::vector>();
 
@@ -148,7 +502,10 @@ namespace gltf
 			for (auto [idx, future] : mesh_futures | std::views::enumerate)
 			{
 				auto result = future.get();
-				if (!result) return result.error().forward(std::format("Load mesh failed at index {}", idx));
+				if (!result)
+					return result.error()
+						.forward("Create mesh GPU resources failed")
+						.forward(std::format("Load mesh failed at index {}", idx));
 				meshes.emplace_back(std::move(*result));
 			}
 
@@ -180,6 +537,7 @@ namespace gltf
 		const tinygltf::Model& tinygltf_model,
 		const SamplerConfig& sampler_config,
 		const MaterialList::ImageConfig& image_config,
+		const MeshConfig& mesh_config,
 		const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress
 	) noexcept
 	{
@@ -190,31 +548,19 @@ namespace gltf
 		auto root_nodes_result = parse_root_nodes(tinygltf_model);
 		if (!root_nodes_result) return root_nodes_result.error().forward("Parse root nodes failed");
 
-		std::vector<Node> nodes;
-		nodes.reserve(tinygltf_model.nodes.size());
-
-		for (const auto& tinygltf_node : tinygltf_model.nodes)
-		{
-			auto node_result = Node::from_tinygltf(tinygltf_model, tinygltf_node);
-			if (!node_result) return node_result.error().forward("Create node from tinygltf failed");
-
-			nodes.emplace_back(std::move(*node_result));
-		}
+		auto nodes_result = detail::load_nodes(tinygltf_model);
+		if (!nodes_result) return nodes_result.error().forward("Load nodes failed");
 
-		std::vector<Light> lights;
-		for (const auto& [idx, tinygltf_light] : tinygltf_model.lights | std::views::enumerate)
-		{
-			auto light_result = parse_light(tinygltf_light);
-			if (!light_result)
-				return light_result.error().forward(std::format("Parse light failed at index {}", idx));
-			lights.emplace_back(*light_result);
-		}
+		auto lights_result = detail::load_lights(tinygltf_model);
+		if (!lights_result) return lights_result.error().forward("Load lights failed");
 
 		/* Load Meshes */
 
 		if (progress) progress->get() = {.stage = LoadStage::Mesh, .progress = 0};
 
-		auto mesh_result = detail::load_meshes(device, tinygltf_model, progress);
+		MeshStatistics mesh_statistics;
+		auto mesh_result =
+			detail::load_meshes(device, tinygltf_model, mesh_config, progress, mesh_statistics);
 		if (!mesh_result) return mesh_result.error().forward("Load meshes failed");
 
 		/* Load Materials */
@@ -256,24 +602,377 @@ namespace gltf
 		Model model(
 			std::move(*material_list_result),
 			std::move(*mesh_result),
-			std::move(nodes),
+			std::move(*nodes_result),
 			std::move(*animation_result),
 			std::move(*root_nodes_result),
 			std::move(*skin_collection_result),
-			std::move(lights)
+			std::move(*lights_result)
 		);
 
-		model.compute_node_parents();
+		if (auto result = model.postprocess(); !result) return result.error();
+		model.mesh_statistics = mesh_statistics;
 
-		auto topo_order_result = model.compute_topo_order();
-		if (!topo_order_result)
-			return topo_order_result.error().forward("Compute node topological order failed");
+		return model;
+	}
 
-		model.compute_renderable_nodes();
+	/* Baked Scene */
 
-		auto material_bind_cache_result = model.material_list.gen_material_cache();
-		if (!material_bind_cache_result) return util::Error("Generate material bind cache failed");
-		model.material_bind_cache = std::move(*material_bind_cache_result);
+	static constexpr std::array<char, 8> baked_magic = {'C', 'G', 'S', 'C', 'E', 'N', 'E', '\0'};
+	static constexpr uint32_t baked_version = 4;
+
+	// Header at the start of a baked scene, followed by sections in the order written by `Model::bake`
+	struct BakedHeader
+	{
+		std::array<char, 8> magic;
+		uint32_t version;
+	};
+
+	static void bake_node(detail::bake::Writer& writer, const Node& node) noexcept
+	{
+		writer.write_optional_string(node.name);
+		writer.write_array(node.children);
+		writer.write_optional(node.mesh);
+		writer.write_optional(node.skin);
+		writer.write_optional(node.light);
+
+		writer.write<uint8_t>(uint8_t(node.transform.index()));
+		std::visit([&writer](const auto& transform) { writer.write(transform); }, node.transform);
+	}
+
+	// Read a node written by `bake_node`, validating indices against the given counts
+	static std::expected<Node, util::Error> read_baked_node(
+		detail::bake::Reader& reader,
+		size_t node_count,
+		size_t mesh_count,
+		size_t skin_count,
+		size_t light_count
+	) noexcept
+	{
+		Node node;
+
+		auto name = reader.read_optional_string();
+		if (!name) return name.error().forward("Read node name failed");
+		node.name = std::move(*name);
+
+		const auto children = reader.read_array<uint32_t>();
+		if (!children) return children.error().forward("Read node children failed");
+		if (std::ranges::any_of(*children, [node_count](uint32_t child) { return child >= node_count; }))
+			return util::Error("Node has invalid child index");
+		node.children = std::vector(std::from_range, *children);
+
+		for (const auto [slot, count] :
+			 std::to_array<std::pair<std::optional<uint32_t>*, size_t>>(
+				 {{&node.mesh, mesh_count}, {&node.skin, skin_count}, {&node.light, light_count}}
+			 ))
+		{
+			const auto index = reader.read_optional<uint32_t>();
+			if (!index) return index.error().forward("Read node reference failed");
+			if (index->has_value() && **index >= count) return util::Error("Node has invalid reference");
+
+			*slot = *index;
+		}
+
+		const auto transform_type = reader.read<uint8_t>();
+		if (!transform_type) return transform_type.error().forward("Read node transform failed");
+
+		switch (*transform_type)
+		{
+		case 0:
+		{
+			const auto transform = reader.read<Node::Transform>();
+			if (!transform) return transform.error().forward("Read node transform failed");
+			node.transform = *transform;
+			break;
+		}
+		case 1:
+		{
+			const auto matrix = reader.read<glm::mat4>();
+			if (!matrix) return matrix.error().forward("Read node matrix failed");
+			node.transform = *matrix;
+			break;
+		}
+		default:
+			return util::Error("Unknown node transform type");
+		}
+
+		return node;
+	}
+
+	static void bake_skin_list(detail::bake::Writer& writer, const SkinList& skin_list) noexcept
+	{
+		writer.write_array(skin_list.inverse_bind_matrices);
+		writer.write_array(skin_list.joints);
+		writer.write_array(skin_list.skin_offsets | std::views::keys | std::ranges::to<std::vector>());
+		writer.write_array(skin_list.skin_offsets | std::views::values | std::ranges::to<std::vector>());
+	}
+
+	// Read a skin list written by `bake_skin_list`, validating ranges. Joints are validated by the caller
+	// once nodes are loaded.
+	static std::expected<SkinList, util::Error> read_baked_skin_list(detail::bake::Reader& reader) noexcept
+	{
+		const auto inverse_bind_matrices = reader.read_array<glm::mat4>();
+		if (!inverse_bind_matrices)
+			return inverse_bind_matrices.error().forward("Read inverse bind matrices failed");
+
+		const auto joints = reader.read_array<uint32_t>();
+		if (!joints) return joints.error().forward("Read joints failed");
+
+		const auto offsets = reader.read_array<uint32_t>();
+		if (!offsets) return offsets.error().forward("Read skin offsets failed");
+
+		const auto lengths = reader.read_array<uint32_t>();
+		if (!lengths) return lengths.error().forward("Read skin lengths failed");
+
+		if (inverse_bind_matrices->size() != joints->size() || offsets->size() != lengths->size())
+			return util::Error("Skin array sizes mismatch");
+		if (std::ranges::any_of(std::views::zip(*offsets, *lengths), [&joints](const auto& range) {
+				const auto [offset, length] = range;
+				return uint64_t(offset) + length > joints->size();
+			}))
+			return util::Error("Skin range out of bounds");
+
+		auto skin_offsets =
+			std::views::zip_transform(
+				[](uint32_t offset, uint32_t length) { return std::make_pair(offset, length); },
+				*offsets,
+				*lengths
+			)
+			| std::ranges::to<std::vector>();
+
+		return SkinList{
+			.inverse_bind_matrices = std::vector(std::from_range, *inverse_bind_matrices),
+			.joints = std::vector(std::from_range, *joints),
+			.skin_offsets = std::move(skin_offsets)
+		};
+	}
+
+	std::expected<MeshStatistics, util::Error> Model::bake(
+		const tinygltf::Model& tinygltf_model,
+		const MaterialList::ImageConfig& image_config,
+		const LodConfig& lod_config,
+		const std::filesystem::path& output_path,
+		const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress
+	) noexcept
+	{
+		detail::bake::Writer writer;
+		writer.write(BakedHeader{.magic = baked_magic, .version = baked_version});
+
+		/* Nodes & Lights */
+
+		if (progress) progress->get() = {.stage = LoadStage::Node, .progress = -1};
+
+		auto root_nodes_result = parse_root_nodes(tinygltf_model);
+		if (!root_nodes_result) return root_nodes_result.error().forward("Parse root nodes failed");
+
+		auto nodes_result = detail::load_nodes(tinygltf_model);
+		if (!nodes_result) return nodes_result.error().forward("Load nodes failed");
+
+		auto lights_result = detail::load_lights(tinygltf_model);
+		if (!lights_result) return lights_result.error().forward("Load lights failed");
+
+		/* Materials */
+
+		if (progress) progress->get() = {.stage = LoadStage::Material, .progress = 0};
+
+		auto material_result = MaterialList::bake(
+			writer,
+			tinygltf_model,
+			image_config,
+			[&progress](std::optional<uint32_t> current, uint32_t total) {
+				if (!progress) return;
+				progress->get() = {
+					.stage = LoadStage::Material,
+					.progress = current.value_or(0) / float(total == 0 ? 1 : total)
+				};
+			}
+		);
+		if (!material_result) return material_result.error().forward("Bake materials failed");
+
+		/* Meshes */
+
+		if (progress) progress->get() = {.stage = LoadStage::Mesh, .progress = 0};
+
+		auto mesh_result = detail::parse_meshes(tinygltf_model, lod_config, progress);
+		if (!mesh_result) return mesh_result.error().forward("Parse meshes failed");
+
+		writer.write<uint64_t>(mesh_result->size());
+		for (const auto& mesh : *mesh_result) mesh.bake(writer);
+
+		const auto mesh_statistics = detail::sum_statistics(*mesh_result);
+
+		/* Skins */
+
+		if (progress) progress->get() = {.stage = LoadStage::Skin, .progress = -1};
+
+		auto skin_list_result = SkinList::from_tinygltf(tinygltf_model);
+		if (!skin_list_result) return skin_list_result.error().forward("Load skins failed");
+
+		bake_skin_list(writer, *skin_list_result);
+
+		/* Lights & Nodes */
+
+		writer.write_array(*lights_result);
+
+		writer.write<uint64_t>(nodes_result->size());
+		for (const auto& node : *nodes_result) bake_node(writer, node);
+		writer.write_array(*root_nodes_result);
+
+		/* Animations */
+
+		if (progress) progress->get() = {.stage = LoadStage::Animation, .progress = -1};
+
+		auto animation_result = detail::load_animations(tinygltf_model);
+		if (!animation_result) return animation_result.error().forward("Load animations failed");
+
+		writer.write<uint64_t>(animation_result->size());
+		for (const auto& animation : *animation_result) animation.bake(writer);
+
+		/* Write */
+
+		if (progress) progress->get() = {.stage = LoadStage::Postprocess, .progress = -1};
+
+		if (auto result = util::write_file(output_path, writer.data()); !result)
+			return result.error().forward("Write baked scene failed");
+
+		return mesh_statistics;
+	}
+
+	std::expected<Model, util::Error> Model::from_baked(
+		SDL_GPUDevice* device,
+		const std::filesystem::path& path,
+		const SamplerConfig& sampler_config,
+		const MeshConfig& mesh_config,
+		const std::optional<std::reference_wrapper<std::atomic<LoadProgress>>>& progress
+	) noexcept
+	{
+		auto file = util::MappedFile::open(path);
+		if (!file) return file.error().forward("Map baked scene failed");
+
+		detail::bake::Reader reader(file->data());
+
+		const auto header = reader.read<BakedHeader>();
+		if (!header) return header.error().forward("Read baked scene header failed");
+		if (header->magic != baked_magic) return util::Error("Not a baked scene file");
+		if (header->version != baked_version)
+			return util::Error(
+				std::format("Baked scene version {} mismatch, expected {}", header->version, baked_version)
+			);
+
+		/* Materials */
+
+		if (progress) progress->get() = {.stage = LoadStage::Material, .progress = 0};
+
+		auto material_list_result = MaterialList::from_baked(
+			device,
+			reader,
+			sampler_config,
+			[&progress](std::optional<uint32_t> current, uint32_t total) {
+				if (!progress) return;
+				progress->get() = {
+					.stage = LoadStage::Material,
+					.progress = current.value_or(0) / float(total == 0 ? 1 : total)
+				};
+			}
+		);
+		if (!material_list_result) return material_list_result.error().forward("Load materials failed");
+
+		/* Meshes */
+
+		if (progress) progress->get() = {.stage = LoadStage::Mesh, .progress = 0};
+
+		const auto mesh_count = reader.read<uint64_t>();
+		if (!mesh_count) return mesh_count.error().forward("Read mesh count failed");
+
+		std::vector<MeshGPU> meshes;
+		for (const auto idx : std::views::iota(0zu, *mesh_count))
+		{
+			auto mesh_result = MeshGPU::from_baked(device, reader, mesh_config);
+			if (!mesh_result)
+				return mesh_result.error().forward(std::format("Load mesh failed at index {}", idx));
+			meshes.emplace_back(std::move(*mesh_result));
+
+			if (progress)
+				progress->get() = {.stage = LoadStage::Mesh, .progress = float(idx + 1) / float(*mesh_count)};
+		}
+
+		/* Skins, Lights & Nodes */
+
+		if (progress) progress->get() = {.stage = LoadStage::Node, .progress = -1};
+
+		auto skin_list_result = read_baked_skin_list(reader);
+		if (!skin_list_result) return skin_list_result.error().forward("Load skins failed");
+
+		const auto lights = reader.read_array<Light>();
+		if (!lights) return lights.error().forward("Load lights failed");
+
+		if (std::ranges::any_of(*lights, [](const Light& light) {
+				return light.type != Light::Type::Spot
+					&& light.type != Light::Type::Point
+					&& light.type != Light::Type::Directional;
+			}))
+			return util::Error("Unknown light type in baked data");
+
+		const auto node_count = reader.read<uint64_t>();
+		if (!node_count) return node_count.error().forward("Read node count failed");
+
+		std::vector<Node> nodes;
+		for (const auto idx : std::views::iota(0zu, *node_count))
+		{
+			auto node_result = read_baked_node(
+				reader,
+				*node_count,
+				meshes.size(),
+				skin_list_result->skin_offsets.size(),
+				lights->size()
+			);
+			if (!node_result)
+				return node_result.error().forward(std::format("Load node failed at index {}", idx));
+			nodes.emplace_back(std::move(*node_result));
+		}
+
+		if (std::ranges::any_of(skin_list_result->joints, [&nodes](uint32_t joint) {
+				return joint >= nodes.size();
+			}))
+			return util::Error("Skin joint node index out of bounds");
+
+		const auto root_nodes = reader.read_array<uint32_t>();
+		if (!root_nodes) return root_nodes.error().forward("Load root nodes failed");
+		if (std::ranges::any_of(*root_nodes, [&nodes](uint32_t index) { return index >= nodes.size(); }))
+			return util::Error("Scene node index out of bounds");
+
+		/* Animations */
+
+		if (progress) progress->get() = {.stage = LoadStage::Animation, .progress = -1};
+
+		const auto animation_count = reader.read<uint64_t>();
+		if (!animation_count) return animation_count.error().forward("Read animation count failed");
+
+		std::vector<Animation> animations;
+		for (const auto idx : std::views::iota(0zu, *animation_count))
+		{
+			auto animation_result = Animation::from_baked(reader, nodes.size());
+			if (!animation_result)
+				return animation_result.error().forward(
+					std::format("Load animation failed at index {}", idx)
+				);
+			animations.emplace_back(std::move(*animation_result));
+		}
+
+		/* Post Process */
+
+		if (progress) progress->get() = {.stage = LoadStage::Postprocess, .progress = -1};
+
+		Model model(
+			std::move(*material_list_result),
+			std::move(meshes),
+			std::move(nodes),
+			std::move(animations),
+			std::vector(std::from_range, *root_nodes),
+			std::move(*skin_list_result),
+			std::vector(std::from_range, *lights)
+		);
+
+		if (auto result = model.postprocess(); !result) return result.error();
 
 		return model;
 	}
@@ -293,206 +992,357 @@ namespace gltf
 		animations(std::move(animations)),
 		root_nodes(std::move(root_nodes)),
 		skin_list(std::move(skin_collection)),
-		lights(std::move(lights)),
-		primitive_count(
-			std::ranges::fold_left(
-				meshes | std::views::transform([](const MeshGPU& mesh) { return mesh.primitives.size(); }),
-				0zu,
-				std::plus()
-			)
-		)
+		lights(std::move(lights))
 	{
-		for (auto [idx, animation] : this->animations | std::views::enumerate)
-			if (animation.name.has_value()) animation_name_map[*animation.name] = idx;
+		// Indexed by the optional `name` of each element
+		const auto name_entries = [](const auto& elements) {
+			std::vector<std::pair<std::string_view, uint32_t>> entries;
+			for (const auto [idx, element] : elements | std::views::enumerate)
+				if (element.name.has_value()) entries.emplace_back(*element.name, static_cast<uint32_t>(idx));
+			return entries;
+		};
+
+		node_names = util::NameIndex(name_entries(this->nodes));
+		animation_names = util::NameIndex(name_entries(this->animations));
 	}
 
-	std::vector<Node::TransformOverride> Model::compute_node_overrides(
-		std::span<const AnimationKey> animation
-	) const noexcept
+	void Model::update_node_overrides(std::span<const AnimationKey> animation) noexcept
 	{
-		std::vector<Node::TransformOverride> node_overrides(nodes.size());
+		auto& state = transform_state;
+
+		// Reuse the scratch buffer, as the overrides are rebuilt every frame
+		auto& node_overrides = state.next_overrides;
+		node_overrides.assign(nodes.size(), {});
+
+		// Cursors persist across frames, so keyframe lookup steps forward with the playback time. Keys are
+		// evaluated in order, each one replacing or blending over the ones before.
+		size_t applied_keys = 0;
+		const auto apply_animation = [&](uint32_t animation_index, const AnimationKey& key) {
+			if (animation_index >= animations.size() || key.weight <= 0.0f) return;
+
+			const auto& animation = animations[animation_index];
+			const auto cursors = std::span(state.animation_cursors[animation_index]);
+
+			if (key.weight >= 1.0f)
+			{
+				animation.apply(node_overrides, key.time, cursors);
+				state.sole_animation = std::make_pair(animation_index, key.time);
+			}
+			else
+			{
+				animation.blend(node_overrides, nodes, key.time, key.weight, cursors);
+				state.sole_animation.reset();
+			}
+
+			applied_keys++;
+		};
 
 		for (const auto& key : animation)
 		{
 			if (std::holds_alternative<uint32_t>(key.animation))
-			{
-				const auto animation_index = std::get<uint32_t>(key.animation);
-				if (animation_index >= animations.size()) continue;
-				animations[animation_index].apply(node_overrides, key.time);
-			}
+				apply_animation(std::get<uint32_t>(key.animation), key);
 			else
 			{
-				const auto& animation_name = std::get<std::string>(key.animation);
-				const auto it = animation_name_map.find(animation_name);
-				if (it == animation_name_map.end()) continue;
+				// The last of animations sharing a name takes precedence
+				const auto found = animation_names.find(std::get<std::string>(key.animation));
+				if (found.empty()) continue;
 
-				const auto animation_index = it->second;
-				if (animation_index >= animations.size()) continue;
-				animations[animation_index].apply(node_overrides, key.time);
+				apply_animation(found.back(), key);
 			}
 		}
 
-		return node_overrides;
+		if (applied_keys != 1) state.sole_animation.reset();
+
+		for (const auto [idx, node_override] : node_overrides | std::views::enumerate)
+			state.node_dirty[idx] = !state.initialized || node_override != state.node_overrides[idx];
+
+		std::swap(state.node_overrides, state.next_overrides);
 	}
 
-	std::vector<glm::mat4> Model::compute_node_world_matrices(
-		const glm::mat4& model_transform,
-		std::span<const Node::TransformOverride> node_overrides
-	) const noexcept
+	void Model::update_node_world_matrices(const glm::mat4& model_transform) noexcept
 	{
-		std::vector<glm::mat4> node_world_matrices(nodes.size(), glm::mat4(1.0f));
+		constexpr size_t batch_size = 8;
+		auto& state = transform_state;
 
-		for (const auto node_index : node_topo_order)
+		// Store local transforms of nodes whose overrides changed
+		for (const auto [position, node_index] : node_topo_order | std::views::enumerate)
 		{
+			if (!state.node_dirty[node_index]) continue;
+
 			const auto& node = nodes[node_index];
+			const auto& node_override = state.node_overrides[node_index];
 
-			const auto parent_matrix =
-				node_parents[node_index]
-					.transform([&node_world_matrices](uint32_t parent_index) {
-						return std::cref(node_world_matrices[parent_index]);
-					})
-					.value_or(std::ref(model_transform));
+			// Matrix nodes keep their matrix unless overridden, see `Node::get_local_transform`
+			const bool is_matrix = std::holds_alternative<glm::mat4>(node.transform);
+			state.matrix_local[position] = is_matrix && !node_override.has_override();
 
-			node_world_matrices[node_index] =
-				parent_matrix.get() * node.get_local_transform(node_overrides[node_index]);
+			const auto transform = (is_matrix ? Node::Transform() : std::get<Node::Transform>(node.transform))
+									   .override_with(node_override);
+			state.local_trs.set(position, transform.translation, transform.rotation, transform.scale);
 		}
 
-		return node_world_matrices;
+		// A new root transform moves every node
+		const bool root_moved = state.initialized && model_transform != state.model_transform;
+
+		for (const auto [level_begin, level_end] : node_level_offsets | std::views::pairwise)
+		{
+			// Compose local matrices of this level in batches, skipping batches without changes. Flags of
+			// this level are not propagated yet, so only overridden nodes count as changed.
+			for (auto batch_begin = level_begin; batch_begin < level_end; batch_begin += batch_size)
+			{
+				const auto batch_count = std::min<size_t>(batch_size, level_end - batch_begin);
+				const auto batch_nodes = std::span(node_topo_order).subspan(batch_begin, batch_count);
+				const auto node_dirty = [&state](uint32_t idx) { return bool(state.node_dirty[idx]); };
+
+				if (std::ranges::none_of(batch_nodes, node_dirty)) continue;
+
+				state.local_trs.compose(
+					batch_begin,
+					std::span(state.local_matrices).subspan(batch_begin, batch_count)
+				);
+			}
+
+			// Propagate flags from parents, which are on the previous level, then update world matrices
+			for (const auto position : std::views::iota(level_begin, level_end))
+			{
+				const auto node_index = node_topo_order[position];
+				const auto parent_index = node_parents[node_index];
+
+				if (parent_index.has_value() ? state.node_dirty[*parent_index] : root_moved)
+					state.node_dirty[node_index] = true;
+				if (!state.node_dirty[node_index]) continue;
+
+				const auto& parent_matrix =
+					parent_index.has_value() ? state.node_world_matrices[*parent_index] : model_transform;
+				const auto& local_matrix = state.matrix_local[position]
+					? std::get<glm::mat4>(nodes[node_index].transform)
+					: state.local_matrices[position];
+
+				state.node_world_matrices[node_index] = parent_matrix * local_matrix;
+			}
+		}
+
+		state.model_transform = model_transform;
+		state.initialized = true;
 	}
 
-	std::vector<PrimitiveDrawcall> Model::compute_drawcalls(
-		const std::vector<glm::mat4>& node_world_matrices,
-		std::span<const std::pair<uint32_t, float>> emission_overrides,
-		std::span<const uint32_t> hidden_nodes
-	) const noexcept
+	const Model::SkinBoundTable* Model::find_skin_bound_table() const noexcept
 	{
-		std::vector<PrimitiveDrawcall> drawdata_list;
-		drawdata_list.reserve(primitive_count);
+		const auto& sole_animation = transform_state.sole_animation;
+		if (!sole_animation.has_value() || sole_animation->first >= animation_skin_bounds.size())
+			return nullptr;
 
-		auto renderable_nodes = this->renderable_nodes;
-		for (const auto hidden_node_index : hidden_nodes) renderable_nodes[hidden_node_index] = false;
+		return &animation_skin_bounds[sole_animation->first];
+	}
 
-		std::vector<float> emission_override_values(nodes.size(), 1.0f);
-		for (const auto& [material_index, emission_value] : emission_overrides)
-			emission_override_values[material_index] = emission_value;
+	void Model::update_drawcalls(const SkinBoundTable* skin_bound_table) noexcept
+	{
+		auto& state = transform_state;
+
+		// Moved drawcalls update their boxes in the culling hierarchy, once it's built
+		const bool bvh_built = state.drawcall_bvh.size() == state.drawcalls.size();
+		const auto update_bvh = [&state, bvh_built](
+									uint32_t offset,
+									std::span<const PrimitiveDrawcall> drawcalls
+								) {
+			if (!bvh_built) return;
+			for (const auto [idx, drawcall] : drawcalls | std::views::enumerate)
+				state.drawcall_bvh.set_box(
+					offset + static_cast<uint32_t>(idx),
+					drawcall.world_position_min,
+					drawcall.world_position_max
+				);
+		};
 
-		for (const auto node_index : node_topo_order)
+		// Index of the first drawcall of the current node among rigged drawcalls
+		uint32_t skinned_drawcall = 0;
+
+		for (const auto node_index : state.drawcall_nodes)
 		{
 			const auto& node = nodes[node_index];
-			const glm::mat4& world_matrix = node_world_matrices[node_index];
-
-			if (!renderable_nodes[node_index] || !node.mesh.has_value()) continue;
-
 			const auto& mesh = meshes[node.mesh.value()];
+			const auto [offset, count] = state.node_drawcall_ranges[node_index];
+			const auto drawcalls = std::span(state.drawcalls).subspan(offset, count);
 
-			if (node.skin.has_value())  // Rigged
+			if (node.skin.has_value())  // Rigged, bounds follow the joints
 			{
-				const auto [_, joints, skin_offset] = skin_list[node.skin.value()];
-
-				const auto node_positions =
-					joints
-					| std::views::transform([&node_world_matrices](uint32_t joint_index) {
-						  const auto& matrix = node_world_matrices[joint_index];
-						  const auto& col = matrix[3];
-						  return glm::vec3(col.x, col.y, col.z) / col.w;
-					  })
-					| std::ranges::to<std::vector>();
-
-				const auto world_min = std::ranges::fold_left(
-					node_positions,
-					glm::vec3(std::numeric_limits<float>::max()),
-					[](const glm::vec3& a, const glm::vec3& b) { return glm::min(a, b); }
-				);
+				const auto first_skinned_drawcall = skinned_drawcall;
+				skinned_drawcall += count;
 
-				const auto world_max = std::ranges::fold_left(
-					node_positions,
-					glm::vec3(std::numeric_limits<float>::lowest()),
-					[](const glm::vec3& a, const glm::vec3& b) { return glm::max(a, b); }
-				);
+				const auto joints = skin_list[node.skin.value()].joints;
+				const auto joint_dirty = [&state](uint32_t joint) { return bool(state.node_dirty[joint]); };
+				if (std::ranges::none_of(joints, joint_dirty)) continue;
 
-				for (const auto& primitive : mesh.primitives)
+				if (skin_bound_table != nullptr)
 				{
-					const auto [gen_data, local_min, local_max] = primitive.gen_drawdata();
-					const float sphere_diameter = glm::distance(local_min, local_max);
-
-					drawdata_list.emplace_back(
-						PrimitiveDrawcall{
-							.world_position_min = world_min - glm::vec3(sphere_diameter),
-							.world_position_max = world_max + glm::vec3(sphere_diameter),
-							.material_index = primitive.material,
-							.transform_or_joint_matrix_offset = skin_offset,
-							.primitive = gen_data,
-						}
-					);
+					const float time = state.sole_animation->second;
+
+					for (const auto [idx, drawcall] : drawcalls | std::views::enumerate)
+					{
+						const auto [local_min, local_max] = skin_bound_table->lookup(
+							state.skinned_drawcall_count,
+							first_skinned_drawcall + idx,
+							time
+						);
+						const auto [world_min, world_max] =
+							graphics::local_bound_to_world(local_min, local_max, state.model_transform);
+						drawcall.world_position_min = world_min;
+						drawcall.world_position_max = world_max;
+					}
+				}
+				else
+				{
+					// Computed along with the joint matrices, see `generate_drawdata`
+					const auto [world_min, world_max] = state.skin_bounds[node.skin.value()];
+
+					for (const auto& [drawcall, primitive] : std::views::zip(drawcalls, mesh.primitives))
+					{
+						const float sphere_diameter =
+							glm::distance(primitive.position_min, primitive.position_max);
+						drawcall.world_position_min = world_min - glm::vec3(sphere_diameter);
+						drawcall.world_position_max = world_max + glm::vec3(sphere_diameter);
+					}
 				}
 			}
 			else  // Not Rigged
 			{
+				if (!state.node_dirty[node_index]) continue;
+
+				const glm::mat4& world_matrix = state.node_world_matrices[node_index];
 
-				for (const auto& primitive : mesh.primitives)
+				for (const auto& [drawcall, primitive] : std::views::zip(drawcalls, mesh.primitives))
 				{
-					const auto [gen_data, local_min, local_max] = primitive.gen_drawdata();
-					const auto [world_min, world_max] =
-						graphics::local_bound_to_world(local_min, local_max, world_matrix);
-
-					drawdata_list.emplace_back(
-						PrimitiveDrawcall{
-							.world_position_min = world_min,
-							.world_position_max = world_max,
-							.material_index = primitive.material,
-							.transform_or_joint_matrix_offset = world_matrix,
-							.primitive = gen_data,
-							.emissive_multiplier = emission_override_values[node_index],
-						}
+					const auto [world_min, world_max] = graphics::local_bound_to_world(
+						primitive.position_min,
+						primitive.position_max,
+						world_matrix
 					);
+
+					drawcall.world_position_min = world_min;
+					drawcall.world_position_max = world_max;
+					drawcall.transform_or_joint_matrix_offset = world_matrix;
 				}
 			}
+
+			update_bvh(offset, drawcalls);
+		}
+
+		// Build on the first frame, when all bounds are known, and only refit afterwards
+		if (bvh_built)
+		{
+			state.drawcall_bvh.refit();
+			return;
+		}
+
+		graphics::BoxArray bounds;
+		bounds.reserve(state.drawcalls.size());
+		for (const auto& drawcall : state.drawcalls)
+			bounds.push_back(drawcall.world_position_min, drawcall.world_position_max);
+
+		state.drawcall_bvh = graphics::Bvh::build(bounds);
+	}
+
+	std::pair<std::pmr::vector<PrimitiveDrawcall>, std::pmr::vector<uint32_t>> Model::collect_drawcalls(
+		std::span<const std::pair<uint32_t, float>> emission_overrides,
+		std::span<const uint32_t> hidden_nodes,
+		std::pmr::memory_resource* resource
+	) const noexcept
+	{
+		const auto& state = transform_state;
+
+		// Common case: nothing hidden or overridden, reuse the cached list as a whole
+		if (hidden_nodes.empty() && emission_overrides.empty())
+			return {
+				std::pmr::vector<PrimitiveDrawcall>(std::from_range, state.drawcalls, resource),
+				std::pmr::vector<uint32_t>(
+					std::from_range,
+					std::views::iota(0u, static_cast<uint32_t>(state.drawcalls.size())),
+					resource
+				)
+			};
+
+		std::pmr::vector<bool> renderable_nodes(std::from_range, this->renderable_nodes, resource);
+		for (const auto hidden_node_index : hidden_nodes) renderable_nodes[hidden_node_index] = false;
+
+		std::pmr::vector<float> emission_override_values(nodes.size(), 1.0f, resource);
+		for (const auto& [material_index, emission_value] : emission_overrides)
+			emission_override_values[material_index] = emission_value;
+
+		std::pmr::vector<PrimitiveDrawcall> drawdata_list(resource);
+		drawdata_list.reserve(state.drawcalls.size());
+		std::pmr::vector<uint32_t>
+			drawcall_indices(state.drawcalls.size(), Drawdata::hidden_drawcall, resource);
+
+		for (const auto node_index : state.drawcall_nodes)
+		{
+			if (!renderable_nodes[node_index]) continue;
+
+			const auto [offset, count] = state.node_drawcall_ranges[node_index];
+			const auto first = drawdata_list.size();
+			drawdata_list.append_range(std::span(state.drawcalls).subspan(offset, count));
+			std::ranges::copy(
+				std::views::iota(static_cast<uint32_t>(first), static_cast<uint32_t>(first + count)),
+				drawcall_indices.begin() + offset
+			);
+
+			if (nodes[node_index].skin.has_value()) continue;
+			for (auto& drawcall : std::span(drawdata_list).subspan(first))
+				drawcall.emissive_multiplier = emission_override_values[node_index];
 		}
 
-		return drawdata_list;
+		return {std::move(drawdata_list), std::move(drawcall_indices)};
 	}
 
 	Drawdata Model::generate_drawdata(
 		const glm::mat4& model_transform,
 		std::span<const AnimationKey> animation,
 		std::span<const std::pair<uint32_t, float>> emission_overrides,
-		std::span<const uint32_t> hidden_nodes
-	) const noexcept
+		std::span<const uint32_t> hidden_nodes,
+		std::pmr::memory_resource* resource
+	) noexcept
 	{
-		const auto node_overrides = compute_node_overrides(animation);
-		auto node_world_matrices = compute_node_world_matrices(model_transform, node_overrides);
-		auto primitive_list = compute_drawcalls(node_world_matrices, emission_overrides, hidden_nodes);
-		auto joint_matrices = skin_list.compute_joint_matrices(node_world_matrices);
+		update_node_overrides(animation);
+		update_node_world_matrices(model_transform);
+
+		const auto& world_matrices = transform_state.node_world_matrices;
+
+		// Rigged drawcalls use precomputed bounds if available, otherwise joint bounds from the same pass
+		const auto* const skin_bound_table = find_skin_bound_table();
+		auto joint_matrices = skin_list.compute_joint_matrices(
+			world_matrices,
+			skin_bound_table != nullptr ? std::span<JointBounds>() : std::span(transform_state.skin_bounds),
+			resource
+		);
+
+		update_drawcalls(skin_bound_table);
+
+		auto [primitive_list, drawcall_indices] =
+			collect_drawcalls(emission_overrides, hidden_nodes, resource);
 
 		return {
 			.primitive_drawcalls = std::move(primitive_list),
-			.node_matrices = std::move(node_world_matrices),
+			.primitive_bvh = &transform_state.drawcall_bvh,
+			.bvh_drawcall_indices = std::move(drawcall_indices),
+			.node_matrices = std::pmr::vector<glm::mat4>(std::from_range, world_matrices, resource),
 			.deferred_skin_resource = joint_matrices.empty()
 				? nullptr
-				: std::make_shared<DeferredSkinningResource>(std::move(joint_matrices)),
+				: std::allocate_shared<DeferredSkinningResource>(
+					  std::pmr::polymorphic_allocator<DeferredSkinningResource>(resource),
+					  std::move(joint_matrices)
+				  ),
 			.material_cache = material_bind_cache->ref()
 		};
 	}
 
-	std::optional<uint32_t> Model::find_node_by_name(const std::string& name) const noexcept
+	std::optional<uint32_t> Model::find_node_by_name(std::string_view name) const noexcept
 	{
-		const auto found =
-			nodes
-			| std::views::enumerate
-			| std::views::filter([&](const auto& pair) {
-				  const auto& [idx, node] = pair;
-				  return node.name.has_value() && *node.name == name;
-			  })
-			| std::ranges::to<std::vector>();
-
+		const auto found = node_names.find(name);
 		if (found.size() != 1) return std::nullopt;
 
-		return std::get<0>(found[0]);
+		return found.front();
 	}
 
-	std::optional<std::pair<uint32_t, Light>> Model::find_light_by_name(
-		const std::string& name
-	) const noexcept
+	std::optional<std::pair<uint32_t, Light>> Model::find_light_by_name(std::string_view name) const noexcept
 	{
 		return find_node_by_name(name).and_then(
 			[this](uint32_t node_index) -> std::optional<std::pair<uint32_t, Light>> {
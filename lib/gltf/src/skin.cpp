@@ -4,6 +4,13 @@
 
 #include <SDL3/SDL_gpu.h>
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <glm/gtc/type_ptr.hpp>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace gltf
 {
@@ -12,9 +19,10 @@ namespace gltf
 	/// @note Validation is already performed. No more assertions needed
 	/// @param model Tinygltf model
 	/// @param skin Tinygltf skin
-	/// @return (`Inverse bind matrices`, `Joint indices`) on success, or error on failure
+	/// @return (`Inverse bind matrices`, `Joint indices`) on success, or error on failure. The matrices are a
+	/// view into the model buffers, truncated to the joint count
 	///
-	static std::expected<std::pair<std::vector<glm::mat4>, std::vector<uint32_t>>, util::Error> parse_skin(
+	static std::expected<std::pair<AccessorView<glm::mat4>, std::vector<uint32_t>>, util::Error> parse_skin(
 		const tinygltf::Model& model,
 		const tinygltf::Skin& skin
 	) noexcept
@@ -25,7 +33,7 @@ namespace gltf
 			return util::Error("Skin inverse bind matrices accessor index out of bounds");
 
 		const auto& inv_bind_matrices_accessor = model.accessors[inv_bind_matrices_idx];
-		auto inv_bind_matrices_result = extract_from_accessor<glm::mat4>(model, inv_bind_matrices_accessor);
+		const auto inv_bind_matrices_result = view_accessor<glm::mat4>(model, inv_bind_matrices_accessor);
 		if (!inv_bind_matrices_result)
 			return inv_bind_matrices_result.error().forward(
 				"Extract inverse bind matrices from accessor failed"
@@ -42,10 +50,8 @@ namespace gltf
 			return util::Error("Skin inverse bind matrices count doesn't match joint count");
 
 		// Truncate inverse bind matrices to joint count
-		inv_bind_matrices_result->resize(skin.joints.size());
-
 		return std::make_pair(
-			std::move(*inv_bind_matrices_result),
+			inv_bind_matrices_result->first(skin.joints.size()),
 			skin.joints | std::views::transform([](int joint_index) {
 				return static_cast<uint32_t>(joint_index);
 			}) | std::ranges::to<std::vector>()
@@ -71,17 +77,120 @@ namespace gltf
 		return skin_collection;
 	}
 
-	std::vector<glm::mat4> SkinList::compute_joint_matrices(
-		const std::vector<glm::mat4>& node_world_matrices
-	) const noexcept
+#ifdef __AVX2__
+
+	// Compute joint matrices of one skin, returning the bounds of its joints if `ComputeBounds`
+	template <bool ComputeBounds>
+	static JointBounds compute_skin(
+		std::span<const glm::mat4> node_world_matrices,
+		std::span<const glm::mat4> inverse_bind_matrices,
+		std::span<const uint32_t> joints,
+		std::span<glm::mat4> joint_matrices
+	) noexcept
 	{
-		std::vector<glm::mat4> joint_matrices;
-		joint_matrices.reserve(joints.size());
+		__m128 position_min = _mm_set1_ps(std::numeric_limits<float>::max());
+		__m128 position_max = _mm_set1_ps(std::numeric_limits<float>::lowest());
 
-		for (const auto [inverse_bind_matrix, joint_index] : std::views::zip(inverse_bind_matrices, joints))
+		for (const auto [joint_matrix, inverse_bind_matrix, joint_index] :
+			 std::views::zip(joint_matrices, inverse_bind_matrices, joints))
+		{
+			const float* const a = glm::value_ptr(node_world_matrices[joint_index]);
+			const float* const b = glm::value_ptr(inverse_bind_matrix);
+			float* const out = glm::value_ptr(joint_matrix);
+
+			// Columns of the world matrix, duplicated into both lanes
+			const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0));
+			const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+			const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+			const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+			// Two result columns at a time, each lane scaling the world columns by one inverse bind column
+			for (const size_t half : {0zu, 8zu})
+			{
+				const __m256 b_cols = _mm256_loadu_ps(b + half);
+				const __m256 m0 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b_cols, b_cols, 0x00));
+				const __m256 m1 = _mm256_mul_ps(a1, _mm256_shuffle_ps(b_cols, b_cols, 0x55));
+				const __m256 m2 = _mm256_mul_ps(a2, _mm256_shuffle_ps(b_cols, b_cols, 0xAA));
+				const __m256 m3 = _mm256_mul_ps(a3, _mm256_shuffle_ps(b_cols, b_cols, 0xFF));
+				_mm256_storeu_ps(out + half, _mm256_add_ps(_mm256_add_ps(m0, m1), _mm256_add_ps(m2, m3)));
+			}
+
+			if constexpr (ComputeBounds)
+			{
+				// Joint position is the translation column of the world matrix
+				const __m128 translation = _mm_loadu_ps(a + 12);
+				const __m128 position =
+					_mm_div_ps(translation, _mm_shuffle_ps(translation, translation, 0xFF));
+				position_min = _mm_min_ps(position_min, position);
+				position_max = _mm_max_ps(position_max, position);
+			}
+		}
+
+		if constexpr (!ComputeBounds) return {};
+
+		alignas(16) std::array<float, 4> min_values, max_values;
+		_mm_store_ps(min_values.data(), position_min);
+		_mm_store_ps(max_values.data(), position_max);
+
+		return {
+			.position_min = glm::vec3(min_values[0], min_values[1], min_values[2]),
+			.position_max = glm::vec3(max_values[0], max_values[1], max_values[2])
+		};
+	}
+
+#else
+
+	// Compute joint matrices of one skin, returning the bounds of its joints if `ComputeBounds`
+	template <bool ComputeBounds>
+	static JointBounds compute_skin(
+		std::span<const glm::mat4> node_world_matrices,
+		std::span<const glm::mat4> inverse_bind_matrices,
+		std::span<const uint32_t> joints,
+		std::span<glm::mat4> joint_matrices
+	) noexcept
+	{
+		JointBounds bounds;
+
+		for (const auto [joint_matrix, inverse_bind_matrix, joint_index] :
+			 std::views::zip(joint_matrices, inverse_bind_matrices, joints))
 		{
 			const glm::mat4& node_world_matrix = node_world_matrices[joint_index];
-			joint_matrices.emplace_back(node_world_matrix * inverse_bind_matrix);
+			joint_matrix = node_world_matrix * inverse_bind_matrix;
+			if constexpr (!ComputeBounds) continue;
+
+			const auto& col = node_world_matrix[3];
+			const auto position = glm::vec3(col.x, col.y, col.z) / col.w;
+			bounds.position_min = glm::min(bounds.position_min, position);
+			bounds.position_max = glm::max(bounds.position_max, position);
+		}
+
+		return bounds;
+	}
+
+#endif
+
+	std::pmr::vector<glm::mat4> SkinList::compute_joint_matrices(
+		std::span<const glm::mat4> node_world_matrices,
+		std::span<JointBounds> skin_bounds,
+		std::pmr::memory_resource* resource
+	) const noexcept
+	{
+		assert(skin_bounds.empty() || skin_bounds.size() == skin_offsets.size());
+
+		std::pmr::vector<glm::mat4> joint_matrices(joints.size(), resource);
+
+		for (const auto [skin_index, offset_length] : skin_offsets | std::views::enumerate)
+		{
+			const auto [offset, length] = offset_length;
+			const auto inverse_bind_span = std::span(inverse_bind_matrices).subspan(offset, length);
+			const auto joint_span = std::span(joints).subspan(offset, length);
+			const auto output_span = std::span(joint_matrices).subspan(offset, length);
+
+			if (skin_bounds.empty())
+				compute_skin<false>(node_world_matrices, inverse_bind_span, joint_span, output_span);
+			else
+				skin_bounds[skin_index] =
+					compute_skin<true>(node_world_matrices, inverse_bind_span, joint_span, output_span);
 		}
 
 		return joint_matrices;
@@ -0,0 +1,82 @@
+///
+/// @file bvh.hpp
+/// @brief Provides a bounding volume hierarchy over AABBs, for hierarchical frustum culling
+///
+
+#pragma once
+
+#include "graphics/culling.hpp"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace graphics
+{
+	///
+	/// @brief Bounding volume hierarchy over primitive AABBs
+	/// @details Built once with median splits, then kept up to date by refitting: boxes of moving primitives
+	/// are replaced with `set_box`, and `refit` only recomputes the nodes above them. Queries accept or
+	/// reject whole subtrees, so their cost follows the visible geometry rather than the primitive count.
+	///
+	class Bvh
+	{
+		struct Node
+		{
+			glm::vec3 min, max;
+			uint32_t first;        // First leaf slot of the subtree
+			uint32_t count;        // Primitive count of the subtree
+			uint32_t right_child;  // 0 for leaves, the left child directly follows its parent
+		};
+
+		std::vector<Node> nodes;              // Nodes in depth-first order
+		std::vector<uint32_t> node_parents;   // Parent of each node, the root is its own parent
+		std::vector<bool> node_dirty;         // If the node bound needs a refit
+		std::vector<uint32_t> leaf_order;     // Primitive index of each leaf slot
+		std::vector<uint32_t> primitive_slot;  // Leaf slot of each primitive
+		std::vector<uint32_t> primitive_leaf;  // Leaf node of each primitive
+		BoxArray boxes;                       // Primitive boxes by leaf slot, padded for 8-wide tests
+		bool dirty = false;
+
+		uint32_t build_node(
+			std::span<uint32_t> order,
+			uint32_t first,
+			const BoxArray& primitive_boxes,
+			std::span<const glm::vec3> centroids
+		) noexcept;
+
+		void refit_node(uint32_t node_index) noexcept;
+
+	  public:
+
+		// Maximum number of primitives in a leaf, tested at once
+		static constexpr uint32_t leaf_size = 8;
+
+		///
+		/// @brief Build a hierarchy
+		///
+		/// @param primitive_boxes Primitive boxes, indexed by primitive
+		/// @return Built hierarchy
+		///
+		static Bvh build(const BoxArray& primitive_boxes) noexcept;
+
+		// Number of primitives
+		size_t size() const noexcept { return leaf_order.size(); }
+
+		// Replace the box of a primitive, takes effect after `refit()`
+		void set_box(uint32_t primitive, const glm::vec3& box_min, const glm::vec3& box_max) noexcept;
+
+		// Recompute the bounds of nodes above primitives changed by `set_box`
+		void refit() noexcept;
+
+		///
+		/// @brief Find primitives inside a frustum, same result as `box_in_frustum` on every primitive
+		///
+		/// @param planes Frustum planes, computed by `compute_frustum_planes()`. At most 32 planes.
+		/// @param visible Output, indices of visible primitives are appended in no particular order
+		///
+		void query(std::span<const glm::vec4> planes, std::pmr::vector<uint32_t>& visible) const noexcept;
+	};
+}
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
+#include <memory_resource>
 #include <span>
 #include <utility>
+#include <vector>
 
 namespace graphics
 {
@@ -44,4 +47,107 @@ namespace graphics
 		const glm::vec3& box_max,
 		std::span<const glm::vec4> planes
 	) noexcept;
+
+	///
+	/// @brief Tell if a sphere is inside the frustum defined by the planes
+	/// @note Planes don't need to be normalized, e.g. world planes transformed into a local space with
+	/// `glm::transpose(world_matrix) * plane`. The test is then exact for the ellipsoid the sphere maps to.
+	///
+	/// @param center Sphere center
+	/// @param radius Sphere radius
+	/// @param planes Frustum planes in the same space as the sphere. Can be a subset of planes.
+	/// @return True if the sphere is inside the frustum, false otherwise
+	///
+	bool sphere_in_frustum(const glm::vec3& center, float radius, std::span<const glm::vec4> planes) noexcept;
+
+	///
+	/// @brief Tell if all triangles bounded by a normal cone face away from the eye
+	/// @details The cone follows `meshopt_computeMeshletBounds`, a cutoff of 1 never culls
+	///
+	/// @param apex Cone apex
+	/// @param axis Normalized cone axis
+	/// @param cutoff Cosine of the cone half angle
+	/// @param eye Eye position in the same space as the cone
+	/// @return True if the triangles are back-facing, false otherwise
+	///
+	bool cone_backfacing(
+		const glm::vec3& apex,
+		const glm::vec3& axis,
+		float cutoff,
+		const glm::vec3& eye
+	) noexcept;
+
+	///
+	/// @brief Structure-of-arrays storage of AABBs, for batched culling
+	///
+	struct BoxArray
+	{
+		std::pmr::vector<float> min_x, min_y, min_z;
+		std::pmr::vector<float> max_x, max_y, max_z;
+
+		BoxArray() = default;
+
+		explicit BoxArray(std::pmr::memory_resource* resource) noexcept :
+			min_x(resource),
+			min_y(resource),
+			min_z(resource),
+			max_x(resource),
+			max_y(resource),
+			max_z(resource)
+		{}
+
+		void reserve(size_t size) noexcept;
+
+		void push_back(const glm::vec3& box_min, const glm::vec3& box_max) noexcept;
+
+		void set(size_t idx, const glm::vec3& box_min, const glm::vec3& box_max) noexcept;
+
+		glm::vec3 get_min(size_t idx) const noexcept { return {min_x[idx], min_y[idx], min_z[idx]}; }
+		glm::vec3 get_max(size_t idx) const noexcept { return {max_x[idx], max_y[idx], max_z[idx]}; }
+
+		size_t size() const noexcept { return min_x.size(); }
+	};
+
+	// Number of bytes of a visibility mask holding `box_count` boxes
+	constexpr size_t visibility_mask_size(size_t box_count) noexcept
+	{
+		return (box_count + 7) / 8;
+	}
+
+	// Tell if the box at `idx` is visible in a mask computed by `boxes_in_frustum`
+	inline bool is_visible(std::span<const uint8_t> visibility, size_t idx) noexcept
+	{
+		return ((visibility[idx / 8] >> (idx % 8)) & 1) != 0;
+	}
+
+	///
+	/// @brief Batched version of `box_in_frustum`, gives exactly the same results
+	/// @details Tests 8 boxes per iteration with AVX2 when available
+	///
+	/// @param boxes World space AABBs
+	/// @param planes Frustum planes, computed by `compute_frustum_planes()`. Can be a subset of planes.
+	/// @param visibility Output bitmask, bit `i % 8` of byte `i / 8` is set if box `i` is inside the
+	/// frustum. Must hold at least `visibility_mask_size(boxes.size())` bytes.
+	///
+	void boxes_in_frustum(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		std::span<uint8_t> visibility
+	) noexcept;
+
+	///
+	/// @brief Test up to 8 consecutive boxes against a frustum
+	///
+	/// @param boxes World space AABBs
+	/// @param planes Frustum planes, computed by `compute_frustum_planes()`. Can be a subset of planes.
+	/// @param first Index of the first box
+	/// @param count Number of boxes, at most 8
+	/// @return Visibility bitmask, bit `i` is set if box `first + i` is inside the frustum
+	///
+	uint8_t boxes_in_frustum(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		size_t first,
+		size_t count
+	) noexcept;
 }
\ No newline at end of file
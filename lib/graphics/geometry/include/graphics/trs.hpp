@@ -0,0 +1,52 @@
+///
+/// @file trs.hpp
+/// @brief Provides structure-of-arrays storage of TRS transforms, with batched conversion to matrices
+///
+
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <span>
+#include <vector>
+
+namespace graphics
+{
+	///
+	/// @brief Structure-of-arrays storage of translation-rotation-scale transforms
+	/// @details Each component lives in its own array, so that `compose` converts 8 transforms at once with
+	/// AVX2 instead of going through per-transform glm calls
+	///
+	class TrsArray
+	{
+		// Components: translation xyz, rotation xyzw, scale xyz
+		static constexpr size_t component_count = 10;
+
+		std::array<std::vector<float>, component_count> components;
+
+	  public:
+
+		// Resize the storage, new transforms are identity
+		void resize(size_t size) noexcept;
+
+		// Number of stored transforms
+		size_t size() const noexcept { return components[0].size(); }
+
+		// Set the transform at `idx`
+		void set(
+			size_t idx,
+			const glm::vec3& translation,
+			const glm::quat& rotation,
+			const glm::vec3& scale
+		) noexcept;
+
+		///
+		/// @brief Compose T*R*S matrices of a range of transforms
+		///
+		/// @param first Index of the first transform
+		/// @param matrices Output matrices, one per transform starting at `first`
+		///
+		void compose(size_t first, std::span<glm::mat4> matrices) const noexcept;
+	};
+}
@@ -0,0 +1,238 @@
+#include "graphics/bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <numeric>
+#include <ranges>
+
+namespace graphics
+{
+	Bvh Bvh::build(const BoxArray& primitive_boxes) noexcept
+	{
+		const auto count = static_cast<uint32_t>(primitive_boxes.size());
+
+		Bvh bvh;
+		bvh.leaf_order.resize(count);
+		std::iota(bvh.leaf_order.begin(), bvh.leaf_order.end(), 0u);
+		bvh.primitive_slot.resize(count);
+		bvh.primitive_leaf.resize(count);
+
+		if (count == 0) return bvh;
+
+		const auto centroids =
+			std::views::iota(0u, count)
+			| std::views::transform([&primitive_boxes](uint32_t idx) {
+				  return (primitive_boxes.get_min(idx) + primitive_boxes.get_max(idx)) * 0.5f;
+			  })
+			| std::ranges::to<std::vector>();
+
+		bvh.nodes.reserve(2 * (count / leaf_size + 1));
+		bvh.build_node(bvh.leaf_order, 0, primitive_boxes, centroids);
+		bvh.node_dirty.assign(bvh.nodes.size(), false);
+
+		// Store boxes by leaf slot, padded so that every leaf can be loaded as a full group of 8
+		bvh.boxes.reserve(count + leaf_size - 1);
+		for (const auto [slot, primitive] : bvh.leaf_order | std::views::enumerate)
+		{
+			bvh.primitive_slot[primitive] = static_cast<uint32_t>(slot);
+			bvh.boxes.push_back(primitive_boxes.get_min(primitive), primitive_boxes.get_max(primitive));
+		}
+		for (uint32_t padding = 0; padding < leaf_size - 1; padding++)
+			bvh.boxes.push_back(glm::vec3(0.0f), glm::vec3(0.0f));
+
+		return bvh;
+	}
+
+	uint32_t Bvh::build_node(
+		std::span<uint32_t> order,
+		uint32_t first,
+		const BoxArray& primitive_boxes,
+		std::span<const glm::vec3> centroids
+	) noexcept
+	{
+		const auto node_index = static_cast<uint32_t>(nodes.size());
+		const auto count = static_cast<uint32_t>(order.size());
+
+		auto box_min = glm::vec3(std::numeric_limits<float>::max());
+		auto box_max = glm::vec3(std::numeric_limits<float>::lowest());
+		auto centroid_min = box_min;
+		auto centroid_max = box_max;
+
+		for (const auto primitive : order)
+		{
+			box_min = glm::min(box_min, primitive_boxes.get_min(primitive));
+			box_max = glm::max(box_max, primitive_boxes.get_max(primitive));
+			centroid_min = glm::min(centroid_min, centroids[primitive]);
+			centroid_max = glm::max(centroid_max, centroids[primitive]);
+		}
+
+		nodes.push_back({.min = box_min, .max = box_max, .first = first, .count = count, .right_child = 0});
+		node_parents.push_back(node_index);
+
+		if (count <= leaf_size)
+		{
+			for (const auto primitive : order) primitive_leaf[primitive] = node_index;
+			return node_index;
+		}
+
+		// Split at the median along the longest centroid axis, keeping the left half a multiple of the leaf
+		// size, so that leaves are full
+		const auto extent = centroid_max - centroid_min;
+		const auto axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+		const auto mid = (count / 2 + leaf_size - 1) / leaf_size * leaf_size;
+
+		std::ranges::nth_element(order, order.begin() + mid, {}, [&centroids, axis](uint32_t primitive) {
+			return centroids[primitive][axis];
+		});
+
+		const auto left_child = build_node(order.first(mid), first, primitive_boxes, centroids);
+		const auto right_child = build_node(order.subspan(mid), first + mid, primitive_boxes, centroids);
+
+		nodes[node_index].right_child = right_child;
+		node_parents[left_child] = node_index;
+		node_parents[right_child] = node_index;
+
+		return node_index;
+	}
+
+	void Bvh::set_box(uint32_t primitive, const glm::vec3& box_min, const glm::vec3& box_max) noexcept
+	{
+		boxes.set(primitive_slot[primitive], box_min, box_max);
+
+		// Mark the path up to the root, stopping at a path marked before
+		for (auto node_index = primitive_leaf[primitive]; !node_dirty[node_index];
+			 node_index = node_parents[node_index])
+		{
+			node_dirty[node_index] = true;
+			if (node_index == 0) break;
+		}
+
+		dirty = true;
+	}
+
+	void Bvh::refit_node(uint32_t node_index) noexcept
+	{
+		auto& node = nodes[node_index];
+
+		if (node.right_child == 0)
+		{
+			node.min = glm::vec3(std::numeric_limits<float>::max());
+			node.max = glm::vec3(std::numeric_limits<float>::lowest());
+
+			for (const auto slot : std::views::iota(node.first, node.first + node.count))
+			{
+				node.min = glm::min(node.min, boxes.get_min(slot));
+				node.max = glm::max(node.max, boxes.get_max(slot));
+			}
+		}
+		else
+		{
+			const auto& left = nodes[node_index + 1];
+			const auto& right = nodes[node.right_child];
+			node.min = glm::min(left.min, right.min);
+			node.max = glm::max(left.max, right.max);
+		}
+	}
+
+	void Bvh::refit() noexcept
+	{
+		if (!dirty) return;
+
+		// Children come after their parent, so a reverse pass refits bottom-up
+		for (const auto node_index : std::views::iota(0zu, nodes.size()) | std::views::reverse)
+		{
+			if (!node_dirty[node_index]) continue;
+
+			refit_node(static_cast<uint32_t>(node_index));
+			node_dirty[node_index] = false;
+		}
+
+		dirty = false;
+	}
+
+	void Bvh::query(std::span<const glm::vec4> planes, std::pmr::vector<uint32_t>& visible) const noexcept
+	{
+		assert(planes.size() <= 32);
+
+		if (nodes.empty()) return;
+
+		const auto append_subtree = [this, &visible](const Node& node) {
+			visible.append_range(std::span(leaf_order).subspan(node.first, node.count));
+		};
+
+		// Pending nodes, with the planes their bound isn't known to be inside of. Median splits keep the
+		// depth logarithmic, so the stack never exceeds 64 entries.
+		std::array<std::pair<uint32_t, uint32_t>, 64> stack;
+		size_t stack_size = 0;
+		stack[stack_size++] = {0, static_cast<uint32_t>((uint64_t(1) << planes.size()) - 1)};
+
+		while (stack_size > 0)
+		{
+			auto [node_index, plane_mask] = stack[--stack_size];
+			const auto& node = nodes[node_index];
+
+			bool outside = false;
+			for (auto remaining = plane_mask; remaining != 0; remaining &= remaining - 1)
+			{
+				const auto plane_index = std::countr_zero(remaining);
+				const auto& plane = planes[plane_index];
+				const auto normal = glm::vec3(plane);
+
+				const auto positive_vertex = glm::vec3(
+					normal.x >= 0 ? node.max.x : node.min.x,
+					normal.y >= 0 ? node.max.y : node.min.y,
+					normal.z >= 0 ? node.max.z : node.min.z
+				);
+				const auto negative_vertex = glm::vec3(
+					normal.x >= 0 ? node.min.x : node.max.x,
+					normal.y >= 0 ? node.min.y : node.max.y,
+					normal.z >= 0 ? node.min.z : node.max.z
+				);
+
+				if (glm::dot(normal, positive_vertex) + plane.w < 0)
+				{
+					outside = true;
+					break;
+				}
+
+				// Entirely on the inner side, the subtree doesn't need this plane anymore
+				if (glm::dot(normal, negative_vertex) + plane.w >= 0) plane_mask &= ~(1u << plane_index);
+			}
+
+			if (outside) continue;
+
+			if (plane_mask == 0)
+			{
+				append_subtree(node);
+				continue;
+			}
+
+			if (node.right_child != 0)
+			{
+				assert(stack_size + 2 <= stack.size());
+				stack[stack_size++] = {node.right_child, plane_mask};
+				stack[stack_size++] = {node_index + 1, plane_mask};
+				continue;
+			}
+
+			// Leaf, test its primitives at once against the remaining planes
+			std::array<glm::vec4, 32> active_planes;
+			size_t active_count = 0;
+			for (auto remaining = plane_mask; remaining != 0; remaining &= remaining - 1)
+				active_planes[active_count++] = planes[std::countr_zero(remaining)];
+
+			const auto leaf_visibility = boxes_in_frustum(
+				boxes,
+				std::span(active_planes).first(active_count),
+				node.first,
+				node.count
+			);
+
+			for (auto remaining = uint32_t(leaf_visibility); remaining != 0; remaining &= remaining - 1)
+				visible.push_back(leaf_order[node.first + std::countr_zero(remaining)]);
+		}
+	}
+}
@@ -2,7 +2,13 @@
 #include "graphics/corner.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <glm/common.hpp>
+#include <ranges>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace graphics
 {
@@ -104,4 +110,159 @@ namespace graphics
 			return glm::dot(normal, positive_vertex) + plane.w >= 0;
 		});
 	}
+
+	bool sphere_in_frustum(const glm::vec3& center, float radius, std::span<const glm::vec4> planes) noexcept
+	{
+		return std::ranges::all_of(planes, [&center, radius](const auto& plane) {
+			const glm::vec3 normal = glm::vec3(plane);
+			return glm::dot(normal, center) + plane.w >= -radius * glm::length(normal);
+		});
+	}
+
+	bool cone_backfacing(
+		const glm::vec3& apex,
+		const glm::vec3& axis,
+		float cutoff,
+		const glm::vec3& eye
+	) noexcept
+	{
+		return glm::dot(glm::normalize(apex - eye), axis) >= cutoff;
+	}
+
+	void BoxArray::reserve(size_t size) noexcept
+	{
+		for (auto* component : {&min_x, &min_y, &min_z, &max_x, &max_y, &max_z}) component->reserve(size);
+	}
+
+	void BoxArray::push_back(const glm::vec3& box_min, const glm::vec3& box_max) noexcept
+	{
+		min_x.push_back(box_min.x);
+		min_y.push_back(box_min.y);
+		min_z.push_back(box_min.z);
+		max_x.push_back(box_max.x);
+		max_y.push_back(box_max.y);
+		max_z.push_back(box_max.z);
+	}
+
+	void BoxArray::set(size_t idx, const glm::vec3& box_min, const glm::vec3& box_max) noexcept
+	{
+		min_x[idx] = box_min.x;
+		min_y[idx] = box_min.y;
+		min_z[idx] = box_min.z;
+		max_x[idx] = box_max.x;
+		max_y[idx] = box_max.y;
+		max_z[idx] = box_max.z;
+	}
+
+	// Positive vertex components of a plane, picked per axis by the sign of the normal
+	struct PositiveVertex
+	{
+		const float *x, *y, *z;
+
+		PositiveVertex(const BoxArray& boxes, const glm::vec4& plane) noexcept :
+			x(plane.x >= 0 ? boxes.max_x.data() : boxes.min_x.data()),
+			y(plane.y >= 0 ? boxes.max_y.data() : boxes.min_y.data()),
+			z(plane.z >= 0 ? boxes.max_z.data() : boxes.min_z.data())
+		{}
+	};
+
+	// Scalar path testing up to 8 boxes starting at `idx`, same arithmetic order as `glm::dot` in
+	// `box_in_frustum`. Branchless, so that the inner loop can be auto-vectorized.
+	static uint8_t boxes_in_frustum_scalar(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		size_t idx,
+		size_t count
+	) noexcept
+	{
+		uint32_t outside = 0;
+
+		for (const auto& plane : planes)
+		{
+			const PositiveVertex vertex(boxes, plane);
+
+			for (const auto bit : std::views::iota(0zu, count))
+			{
+				const auto i = idx + bit;
+				const float dot = plane.x * vertex.x[i] + plane.y * vertex.y[i] + plane.z * vertex.z[i];
+				outside |= uint32_t(!(dot + plane.w >= 0)) << bit;
+			}
+		}
+
+		return static_cast<uint8_t>(~outside & ((1u << count) - 1));
+	}
+
+#ifdef __AVX2__
+
+	// Test 8 boxes starting at `idx`, bit `i` of the result is set if box `idx + i` is visible
+	static uint8_t boxes_in_frustum_8(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		size_t idx
+	) noexcept
+	{
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (const auto& plane : planes)
+		{
+			const PositiveVertex vertex(boxes, plane);
+
+			// Multiply and add separately, keeping the rounding of the scalar path
+			const __m256 dot_xy = _mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(vertex.x + idx)),
+				_mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(vertex.y + idx))
+			);
+			const __m256 dot = _mm256_add_ps(
+				dot_xy,
+				_mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(vertex.z + idx))
+			);
+			const __m256 distance = _mm256_add_ps(dot, _mm256_set1_ps(plane.w));
+
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+			if (_mm256_testz_ps(inside, inside)) break;
+		}
+
+		return static_cast<uint8_t>(_mm256_movemask_ps(inside));
+	}
+
+#endif
+
+	void boxes_in_frustum(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		std::span<uint8_t> visibility
+	) noexcept
+	{
+		assert(visibility.size() >= visibility_mask_size(boxes.size()));
+
+		const auto count = boxes.size();
+		size_t offset = 0;
+
+#ifdef __AVX2__
+		for (; offset + 8 <= count; offset += 8)
+			visibility[offset / 8] = boxes_in_frustum_8(boxes, planes, offset);
+#endif
+
+		for (; offset < count; offset += 8)
+			visibility[offset / 8] =
+				boxes_in_frustum_scalar(boxes, planes, offset, std::min<size_t>(8, count - offset));
+	}
+
+	uint8_t boxes_in_frustum(
+		const BoxArray& boxes,
+		std::span<const glm::vec4> planes,
+		size_t first,
+		size_t count
+	) noexcept
+	{
+		assert(count <= 8 && first + count <= boxes.size());
+
+#ifdef __AVX2__
+		// Boxes past `count` are loaded but masked out
+		if (first + 8 <= boxes.size())
+			return boxes_in_frustum_8(boxes, planes, first) & static_cast<uint8_t>((1u << count) - 1);
+#endif
+
+		return boxes_in_frustum_scalar(boxes, planes, first, count);
+	}
 }
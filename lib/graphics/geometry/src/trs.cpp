@@ -0,0 +1,177 @@
+#include "graphics/trs.hpp"
+
+#include <cassert>
+#include <glm/gtc/type_ptr.hpp>
+#include <ranges>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace graphics
+{
+	enum Component : size_t
+	{
+		TX,
+		TY,
+		TZ,
+		RX,
+		RY,
+		RZ,
+		RW,
+		SX,
+		SY,
+		SZ
+	};
+
+	void TrsArray::resize(size_t size) noexcept
+	{
+		for (const auto [idx, component] : components | std::views::enumerate)
+		{
+			const bool is_one = idx == RW || idx == SX || idx == SY || idx == SZ;
+			component.resize(size, is_one ? 1.0f : 0.0f);
+		}
+	}
+
+	void TrsArray::set(
+		size_t idx,
+		const glm::vec3& translation,
+		const glm::quat& rotation,
+		const glm::vec3& scale
+	) noexcept
+	{
+		components[TX][idx] = translation.x;
+		components[TY][idx] = translation.y;
+		components[TZ][idx] = translation.z;
+		components[RX][idx] = rotation.x;
+		components[RY][idx] = rotation.y;
+		components[RZ][idx] = rotation.z;
+		components[RW][idx] = rotation.w;
+		components[SX][idx] = scale.x;
+		components[SY][idx] = scale.y;
+		components[SZ][idx] = scale.z;
+	}
+
+	// Scalar path, same formula as `glm::translate(T) * glm::mat4(R) * glm::scale(S)`
+	static glm::mat4 compose_one(const std::array<std::vector<float>, 10>& c, size_t idx) noexcept
+	{
+		const float x = c[RX][idx], y = c[RY][idx], z = c[RZ][idx], w = c[RW][idx];
+		const float sx = c[SX][idx], sy = c[SY][idx], sz = c[SZ][idx];
+
+		return {
+			glm::vec4(1 - 2 * (y * y + z * z), 2 * (x * y + w * z), 2 * (x * z - w * y), 0) * sx,
+			glm::vec4(2 * (x * y - w * z), 1 - 2 * (x * x + z * z), 2 * (y * z + w * x), 0) * sy,
+			glm::vec4(2 * (x * z + w * y), 2 * (y * z - w * x), 1 - 2 * (x * x + y * y), 0) * sz,
+			glm::vec4(c[TX][idx], c[TY][idx], c[TZ][idx], 1)
+		};
+	}
+
+#ifdef __AVX2__
+
+	// Transpose 8 registers, each holding one element of 8 matrices, into 8 rows of 8 elements per matrix
+	static void transpose_8x8(__m256 (&r)[8]) noexcept
+	{
+		const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+		const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+		const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+		const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+		const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+		const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+		const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+		const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+		const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+		const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+		const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+		r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+		r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+		r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+		r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+		r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+		r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+		r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+		r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+	}
+
+	// Compose 8 matrices starting at `idx`
+	static void compose_8(const std::array<std::vector<float>, 10>& c, size_t idx, glm::mat4* out) noexcept
+	{
+		const auto load = [&c, idx](Component component) {
+			return _mm256_loadu_ps(c[component].data() + idx);
+		};
+
+		const __m256 x = load(RX), y = load(RY), z = load(RZ), w = load(RW);
+		const __m256 sx = load(SX), sy = load(SY), sz = load(SZ);
+
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 two = _mm256_set1_ps(2.0f);
+		const __m256 zero = _mm256_setzero_ps();
+
+		const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+		const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+		const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+		const auto twice = [&two](__m256 v) {
+			return _mm256_mul_ps(two, v);
+		};
+		const auto one_minus_twice = [&one, &twice](__m256 a, __m256 b) {
+			return _mm256_sub_ps(one, twice(_mm256_add_ps(a, b)));
+		};
+
+		// Elements 0-7: column 0 and column 1
+		__m256 low[8] = {
+			_mm256_mul_ps(one_minus_twice(yy, zz), sx),
+			_mm256_mul_ps(twice(_mm256_add_ps(xy, wz)), sx),
+			_mm256_mul_ps(twice(_mm256_sub_ps(xz, wy)), sx),
+			zero,
+			_mm256_mul_ps(twice(_mm256_sub_ps(xy, wz)), sy),
+			_mm256_mul_ps(one_minus_twice(xx, zz), sy),
+			_mm256_mul_ps(twice(_mm256_add_ps(yz, wx)), sy),
+			zero
+		};
+
+		// Elements 8-15: column 2 and column 3
+		__m256 high[8] = {
+			_mm256_mul_ps(twice(_mm256_add_ps(xz, wy)), sz),
+			_mm256_mul_ps(twice(_mm256_sub_ps(yz, wx)), sz),
+			_mm256_mul_ps(one_minus_twice(xx, yy), sz),
+			zero,
+			load(TX),
+			load(TY),
+			load(TZ),
+			one
+		};
+
+		transpose_8x8(low);
+		transpose_8x8(high);
+
+		for (const auto i : std::views::iota(0zu, 8zu))
+		{
+			float* const matrix = glm::value_ptr(out[i]);
+			_mm256_storeu_ps(matrix, low[i]);
+			_mm256_storeu_ps(matrix + 8, high[i]);
+		}
+	}
+
+#endif
+
+	void TrsArray::compose(size_t first, std::span<glm::mat4> matrices) const noexcept
+	{
+		assert(first + matrices.size() <= size());
+
+		size_t offset = 0;
+
+#ifdef __AVX2__
+		for (; offset + 8 <= matrices.size(); offset += 8)
+			compose_8(components, first + offset, matrices.data() + offset);
+#endif
+
+		for (; offset < matrices.size(); offset++) matrices[offset] = compose_one(components, first + offset);
+	}
+}
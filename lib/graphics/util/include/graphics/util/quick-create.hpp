@@ -9,14 +9,15 @@
 
 namespace graphics
 {
-	namespace detail
+	// Type-erased view of a single image level
+	struct ImageData
 	{
-		struct ImageData
-		{
-			glm::u32vec2 size;
-			std::span<const std::byte> pixels;
-		};
+		glm::u32vec2 size;
+		std::span<const std::byte> pixels;
+	};
 
+	namespace detail
+	{
 		// Type-independent internal implementation of create_texture_from_image
 		std::expected<gpu::Texture, util::Error> create_texture_from_image_internal(
 			SDL_GPUDevice* device,
@@ -24,14 +25,6 @@ namespace graphics
 			ImageData image,
 			const std::string& name
 		) noexcept;
-
-		// Type-independent internal implementation of create_texture_from_mipmap
-		std::expected<gpu::Texture, util::Error> create_texture_from_mipmap_internal(
-			SDL_GPUDevice* device,
-			gpu::Texture::Format format,
-			std::span<const ImageData> mipmap_chain,
-			const std::string& name
-		) noexcept;
 	}
 
 	///
@@ -80,6 +73,24 @@ namespace graphics
 		);
 	}
 
+	///
+	/// @brief Create a texture from type-erased mipmap chain data, e.g. memory-mapped from disk
+	/// @details
+	/// - This function is designed for initializing textures with data at **loading stage**.
+	/// - It has some overhead, which should be acceptable at loading stage but not at render-time.
+	/// - Don't use it on-the-fly during rendering. Manually copy on a copy pass from the main command buffer.
+	///
+	/// @param format Image format
+	/// @param mipmap_chain Image mipmap chain, level 0 first
+	/// @return Created texture, or error
+	///
+	std::expected<gpu::Texture, util::Error> create_texture_from_mipmap_data(
+		SDL_GPUDevice* device,
+		gpu::Texture::Format format,
+		std::span<const ImageData> mipmap_chain,
+		const std::string& name
+	) noexcept;
+
 	///
 	/// @brief Create a texture from mipmap chain
 	/// @details
@@ -100,13 +111,11 @@ namespace graphics
 		const std::string& name
 	) noexcept
 	{
-		std::vector<detail::ImageData> chain_data;
+		std::vector<ImageData> chain_data;
 		chain_data.reserve(mipmap_chain.size());
 		for (const auto& level : mipmap_chain)
-			chain_data.push_back(
-				detail::ImageData{.size = level.size, .pixels = util::as_bytes(level.pixels)}
-			);
+			chain_data.push_back(ImageData{.size = level.size, .pixels = util::as_bytes(level.pixels)});
 
-		return detail::create_texture_from_mipmap_internal(device, format, chain_data, name);
+		return create_texture_from_mipmap_data(device, format, chain_data, name);
 	}
 }
\ No newline at end of file
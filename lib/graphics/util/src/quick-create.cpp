@@ -70,7 +70,7 @@ namespace graphics
 		return texture;
 	}
 
-	std::expected<gpu::Texture, util::Error> detail::create_texture_from_mipmap_internal(
+	std::expected<gpu::Texture, util::Error> create_texture_from_mipmap_data(
 		SDL_GPUDevice* device,
 		gpu::Texture::Format format,
 		std::span<const ImageData> mipmap_chain,
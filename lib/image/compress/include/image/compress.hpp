@@ -10,6 +10,12 @@
 
 namespace image
 {
+	///
+	/// @brief Version of the block encoders and their settings
+	/// @note Bump this whenever encoder parameters change, so that persisted compressed images are invalidated
+	///
+	inline constexpr uint32_t compress_encoder_version = 1;
+
 	///
 	/// @brief BC block for 8 bits per pixel formats
 	///
@@ -31,6 +37,17 @@ namespace image
 		const Image<Precision::U8, Format::RGBA>& src_image
 	) noexcept;
 
+	///
+	/// @brief Compress a raw image into BC3 format, with block rows split across a shared thread pool
+	/// @note Output is bit-identical to `compress_to_bc3`. Small images fall back to serial compression.
+	///
+	/// @param src_image Source image in RGBA8 format. Size must be a multiple of 4x4.
+	/// @return Compressed BC3 image, or error on failure
+	///
+	std::expected<BCImage, util::Error> compress_to_bc3_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept;
+
 	///
 	/// @brief Compress a raw image into BC5 format.
 	///
@@ -42,6 +59,17 @@ namespace image
 		const Image<Precision::U8, Format::RGBA>& src_image
 	) noexcept;
 
+	///
+	/// @brief Compress a raw image into BC5 format, with block rows split across a shared thread pool
+	/// @note Output is bit-identical to `compress_to_bc5`. Small images fall back to serial compression.
+	///
+	/// @param src_image Source image in RGBA8 format. Size must be a multiple of 4x4.
+	/// @return Compressed BC5 image, or error on failure
+	///
+	std::expected<BCImage, util::Error> compress_to_bc5_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept;
+
 	///
 	/// @brief Compress a raw image into BC7 format
 	///
@@ -52,6 +80,17 @@ namespace image
 		const Image<Precision::U8, Format::RGBA>& src_image
 	) noexcept;
 
+	///
+	/// @brief Compress a raw image into BC7 format, with block rows split across a shared thread pool
+	/// @note Output is bit-identical to `compress_to_bc7`. Small images fall back to serial compression.
+	///
+	/// @param src_image Source image in RGBA8 format. Size must be a multiple of 4x4.
+	/// @return Compressed BC7 image, or error on failure
+	///
+	std::expected<BCImage, util::Error> compress_to_bc7_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept;
+
 	///
 	/// @brief Mipmap compressing funtor
 	///
@@ -1,10 +1,12 @@
 #include "image/compress.hpp"
 
 #include <bc7enc.h>
+#include <future>
 #include <mutex>
 #include <ranges>
 #include <rgbcx.h>
 #include <stb_dxt/stb_dxt.h>
+#include <thread_pool/thread_pool.h>
 
 namespace image
 {
@@ -50,6 +52,79 @@ namespace image
 		}
 	}
 
+	// Minimum block count for parallel compression, smaller images are compressed serially
+	static constexpr size_t parallel_min_blocks = 1024;
+
+	// Shared pool for parallel block compression, `hardware_concurrency` is 0 if unknown
+	static dp::thread_pool<>& get_compress_pool() noexcept
+	{
+		static dp::thread_pool pool(std::max(1u, std::thread::hardware_concurrency()));
+		return pool;
+	}
+
+	// Iterate over all 4x4 blocks in the source, with block rows split across the shared thread pool
+	template <typename Func>
+		requires(std::invocable<const Func&, const Block_pixel_array_8bpp&, CompressionBlock&>)
+	static void iterate_over_blocks_parallel(
+		const ImageContainer<RGBA_pixel_type>& src,
+		ImageContainer<CompressionBlock>& dst,
+		const Func& compress_block_func
+	) noexcept
+	{
+		if (dst.pixels.size() < parallel_min_blocks)
+		{
+			iterate_over_blocks(src, dst, compress_block_func);
+			return;
+		}
+
+		auto& pool = get_compress_pool();
+
+		const uint32_t block_cols = src.size.x / 4;
+		const uint32_t block_rows = src.size.y / 4;
+
+		// Oversubscribe a little so that the work-stealing pool can balance uneven rows
+		const uint32_t rows_per_task =
+			std::max(1u, block_rows / std::max(1u, static_cast<uint32_t>(pool.size() * 4)));
+
+		// Each task writes a disjoint range of output blocks, output is identical to the serial version
+		const auto compress_rows = [&src, &dst, &compress_block_func, block_cols](
+									   uint32_t row_begin,
+									   uint32_t row_end
+								   ) {
+			for (const auto block_y : std::views::iota(row_begin, row_end))
+				for (const auto block_x : std::views::iota(0u, block_cols))
+				{
+					const auto block_pixels = extract_block(src, block_x, block_y);
+					compress_block_func(block_pixels, dst.pixels[size_t(block_y) * block_cols + block_x]);
+				}
+		};
+
+		std::vector<std::future<void>> futures;
+		futures.reserve(block_rows / rows_per_task + 1);
+
+		for (uint32_t row_begin = 0; row_begin < block_rows; row_begin += rows_per_task)
+			futures.push_back(
+				pool.enqueue(compress_rows, row_begin, std::min(row_begin + rows_per_task, block_rows))
+			);
+
+		for (auto& future : futures) future.wait();
+	}
+
+	// Iterate over all 4x4 blocks in the source, either serially or in parallel
+	template <typename Func>
+	static void iterate_over_blocks(
+		bool parallel,
+		const ImageContainer<RGBA_pixel_type>& src,
+		ImageContainer<CompressionBlock>& dst,
+		const Func& compress_block_func
+	) noexcept
+	{
+		if (parallel)
+			iterate_over_blocks_parallel(src, dst, compress_block_func);
+		else
+			iterate_over_blocks(src, dst, compress_block_func);
+	}
+
 	// Generate destination image container
 	static std::expected<BCImage, util::Error> generate_dst_image(
 		const ImageContainer<RGBA_pixel_type>& src
@@ -71,14 +146,30 @@ namespace image
 		return dst_image;
 	}
 
-	std::expected<BCImage, util::Error> compress_to_bc3(
-		const Image<Precision::U8, Format::RGBA>& src_image
+	static std::expected<BCImage, util::Error> compress_to_bc3_impl(
+		const Image<Precision::U8, Format::RGBA>& src_image,
+		bool parallel
 	) noexcept
 	{
+		static std::once_flag dxt_init_flag;
+
 		auto dst_image = generate_dst_image(src_image);
 		if (!dst_image) return dst_image.error();
 
+		// stb_dxt lazily initializes its lookup tables on first use, do it once before spawning workers
+		std::call_once(dxt_init_flag, [] {
+			const Block_pixel_array_8bpp dummy_pixels{};
+			CompressionBlock dummy_output;
+			stb_compress_dxt_block(
+				reinterpret_cast<uint8_t*>(dummy_output.block.data()),
+				reinterpret_cast<const uint8_t*>(dummy_pixels.data()),
+				1,
+				10
+			);
+		});
+
 		iterate_over_blocks(
+			parallel,
 			src_image,
 			*dst_image,
 			[](const Block_pixel_array_8bpp& block_pixels, CompressionBlock& output) {
@@ -94,14 +185,16 @@ namespace image
 		return dst_image;
 	}
 
-	std::expected<BCImage, util::Error> compress_to_bc5(
-		const Image<Precision::U8, Format::RGBA>& src_image
+	static std::expected<BCImage, util::Error> compress_to_bc5_impl(
+		const Image<Precision::U8, Format::RGBA>& src_image,
+		bool parallel
 	) noexcept
 	{
 		auto dst_image = generate_dst_image(src_image);
 		if (!dst_image) return dst_image.error();
 
 		iterate_over_blocks(
+			parallel,
 			src_image,
 			*dst_image,
 			[](const Block_pixel_array_8bpp& block_pixels, CompressionBlock& output) {
@@ -115,8 +208,9 @@ namespace image
 		return dst_image;
 	}
 
-	std::expected<BCImage, util::Error> compress_to_bc7(
-		const Image<Precision::U8, Format::RGBA>& src_image
+	static std::expected<BCImage, util::Error> compress_to_bc7_impl(
+		const Image<Precision::U8, Format::RGBA>& src_image,
+		bool parallel
 	) noexcept
 	{
 		static std::once_flag bc7_init_flag;
@@ -130,7 +224,9 @@ namespace image
 		bc7enc_compress_block_params_init(&params);
 		bc7enc_compress_block_params_init_perceptual_weights(&params);
 
+		// Params are only read by the encoder, sharing them across workers is safe
 		iterate_over_blocks(
+			parallel,
 			src_image,
 			*dst_image,
 			[&params](const Block_pixel_array_8bpp& block_pixels, CompressionBlock& output) {
@@ -144,4 +240,46 @@ namespace image
 
 		return dst_image;
 	}
+
+	std::expected<BCImage, util::Error> compress_to_bc3(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc3_impl(src_image, false);
+	}
+
+	std::expected<BCImage, util::Error> compress_to_bc3_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc3_impl(src_image, true);
+	}
+
+	std::expected<BCImage, util::Error> compress_to_bc5(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc5_impl(src_image, false);
+	}
+
+	std::expected<BCImage, util::Error> compress_to_bc5_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc5_impl(src_image, true);
+	}
+
+	std::expected<BCImage, util::Error> compress_to_bc7(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc7_impl(src_image, false);
+	}
+
+	std::expected<BCImage, util::Error> compress_to_bc7_parallel(
+		const Image<Precision::U8, Format::RGBA>& src_image
+	) noexcept
+	{
+		return compress_to_bc7_impl(src_image, true);
+	}
 }
\ No newline at end of file
@@ -43,5 +43,5 @@ target("image.compress")
 	add_headerfiles("include/(**.hpp)")
 	add_files("src/**.cpp")
 
-	add_packages("bc7enc", "stb_dxt")
+	add_packages("bc7enc", "stb_dxt", "paul_thread_pool")
 	add_deps("image.repr", {public=true})
\ No newline at end of file
@@ -0,0 +1,99 @@
+///
+/// @file frame-arena.hpp
+/// @brief Provides a per-frame monotonic memory arena
+///
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+
+namespace util
+{
+	///
+	/// @brief Monotonic arena for data living within one frame
+	/// @details Containers allocate from `resource()` through `std::pmr`, deallocation is a no-op. When a
+	/// frame outgrows the buffer, the overflow comes from the heap and the buffer is enlarged at the next
+	/// `reset()`, so a steady workload stops touching the heap after a few frames.
+	/// @note Allocation is thread-safe, so that jobs of the same frame can share the arena. Everything
+	/// allocated from the arena must be destroyed before calling `reset()`
+	///
+	class FrameArena
+	{
+		// Upstream of the arena, counts the allocations and bytes that didn't fit in the buffer
+		class OverflowResource : public std::pmr::memory_resource
+		{
+			size_t overflow_bytes = 0;
+			size_t overflow_count = 0;
+
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		  public:
+
+			size_t get_overflow_bytes() const noexcept { return overflow_bytes; }
+			size_t get_overflow_count() const noexcept { return overflow_count; }
+
+			void clear() noexcept
+			{
+				overflow_bytes = 0;
+				overflow_count = 0;
+			}
+		};
+
+		// Front of the arena, serializes access to the monotonic resource which is not thread-safe
+		class SynchronizedResource : public std::pmr::memory_resource
+		{
+			std::mutex mutex;
+			std::pmr::memory_resource* upstream = nullptr;
+
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		  public:
+
+			void set_upstream(std::pmr::memory_resource* resource) noexcept { upstream = resource; }
+		};
+
+		std::unique_ptr<std::byte[]> buffer;
+		size_t buffer_size;
+		size_t last_heap_allocation_count = 0;
+		OverflowResource overflow;
+		std::optional<std::pmr::monotonic_buffer_resource> arena;
+		SynchronizedResource synchronized;
+
+	  public:
+
+		///
+		/// @brief Create a frame arena
+		///
+		/// @param initial_size Initial buffer size in bytes, default 1MiB
+		///
+		explicit FrameArena(size_t initial_size = 1 << 20) noexcept;
+
+		///
+		/// @brief Start a new frame, releasing everything allocated in the previous frame
+		/// @details If the previous frame overflowed, the buffer grows to hold all of it
+		///
+		void reset() noexcept;
+
+		// Memory resource of the current frame
+		std::pmr::memory_resource* resource() noexcept { return &synchronized; }
+
+		// Buffer capacity in bytes
+		size_t capacity() const noexcept { return buffer_size; }
+
+		// Heap allocations made by the previous frame because the buffer was full, trends to zero
+		size_t heap_allocation_count() const noexcept { return last_heap_allocation_count; }
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena(FrameArena&&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+		FrameArena& operator=(FrameArena&&) = delete;
+	};
+}
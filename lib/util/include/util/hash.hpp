@@ -0,0 +1,21 @@
+///
+/// @file hash.hpp
+/// @brief Provides non-cryptographic hash functions for content addressing
+///
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace util
+{
+	///
+	/// @brief Hash a byte span with XXH64
+	///
+	/// @param data Input bytes
+	/// @param seed Hash seed
+	/// @return 64-bit hash value
+	///
+	uint64_t hash_bytes(std::span<const std::byte> data, uint64_t seed = 0) noexcept;
+}
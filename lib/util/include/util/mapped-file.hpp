@@ -0,0 +1,55 @@
+///
+/// @file mapped-file.hpp
+/// @brief Provides a read-only memory-mapped file wrapper
+///
+
+#pragma once
+
+#include "error.hpp"
+
+#include <expected>
+#include <filesystem>
+#include <span>
+
+namespace util
+{
+	///
+	/// @brief Read-only memory mapping of a whole file
+	/// @note The object is move-only, the mapping is released on destruction.
+	///
+	class MappedFile
+	{
+	  public:
+
+		///
+		/// @brief Map a file into memory for reading
+		///
+		/// @param path File path
+		/// @return Mapped file, or error if failed
+		///
+		static std::expected<MappedFile, util::Error> open(const std::filesystem::path& path) noexcept;
+
+		// Get the mapped bytes
+		std::span<const std::byte> data() const noexcept { return {address, size}; }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		~MappedFile() noexcept;
+
+	  private:
+
+		const std::byte* address = nullptr;
+		size_t size = 0;
+
+		MappedFile(const std::byte* address, size_t size) noexcept :
+			address(address),
+			size(size)
+		{}
+
+		void release() noexcept;
+	};
+}
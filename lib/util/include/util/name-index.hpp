@@ -0,0 +1,53 @@
+///
+/// @file name-index.hpp
+/// @brief Provides a hash multi-index from interned names to element indices
+///
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+	///
+	/// @brief Immutable hash multi-index from names to element indices
+	/// @details Names are interned into one buffer owned by the index, and indices sharing a name are stored
+	/// contiguously in ascending order, so a lookup is one hash probe and never allocates
+	///
+	class NameIndex
+	{
+		std::unique_ptr<char[]> names;  // Interned names, keys of `groups` view into it
+		std::vector<uint32_t> indices;  // Indices grouped by name
+		std::unordered_map<std::string_view, std::pair<uint32_t, uint32_t>> groups;  // (offset, count)
+
+	  public:
+
+		NameIndex() = default;
+
+		///
+		/// @brief Build an index
+		///
+		/// @param entries (name, index) pairs, names only need to outlive the call
+		///
+		explicit NameIndex(std::vector<std::pair<std::string_view, uint32_t>> entries) noexcept;
+
+		///
+		/// @brief Find all indices with the given name
+		///
+		/// @param name Name to look up
+		/// @return Indices in ascending order, empty if none
+		///
+		std::span<const uint32_t> find(std::string_view name) const noexcept;
+
+		NameIndex(const NameIndex&) = delete;
+		NameIndex(NameIndex&&) noexcept = default;
+		NameIndex& operator=(const NameIndex&) = delete;
+		NameIndex& operator=(NameIndex&&) noexcept = default;
+	};
+}
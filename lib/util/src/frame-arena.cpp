@@ -0,0 +1,67 @@
+#include "util/frame-arena.hpp"
+
+#include <bit>
+
+namespace util
+{
+	void* FrameArena::OverflowResource::do_allocate(size_t bytes, size_t alignment)
+	{
+		overflow_bytes += bytes;
+		overflow_count++;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void FrameArena::OverflowResource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+	{
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+
+	bool FrameArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	void* FrameArena::SynchronizedResource::do_allocate(size_t bytes, size_t alignment)
+	{
+		const std::lock_guard lock(mutex);
+		return upstream->allocate(bytes, alignment);
+	}
+
+	void FrameArena::SynchronizedResource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+	{
+		const std::lock_guard lock(mutex);
+		upstream->deallocate(ptr, bytes, alignment);
+	}
+
+	bool FrameArena::SynchronizedResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	FrameArena::FrameArena(size_t initial_size) noexcept :
+		buffer(std::make_unique_for_overwrite<std::byte[]>(initial_size)),
+		buffer_size(initial_size)
+	{
+		arena.emplace(buffer.get(), buffer_size, &overflow);
+		synchronized.set_upstream(&*arena);
+	}
+
+	void FrameArena::reset() noexcept
+	{
+		// Releases overflow chunks back to the heap
+		arena.reset();
+
+		last_heap_allocation_count = overflow.get_overflow_count();
+
+		if (const auto overflow_bytes = overflow.get_overflow_bytes(); overflow_bytes > 0)
+		{
+			buffer_size = std::bit_ceil(buffer_size + overflow_bytes);
+			buffer = std::make_unique_for_overwrite<std::byte[]>(buffer_size);
+		}
+
+		overflow.clear();
+
+		arena.emplace(buffer.get(), buffer_size, &overflow);
+		synchronized.set_upstream(&*arena);
+	}
+}
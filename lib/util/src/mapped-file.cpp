@@ -0,0 +1,118 @@
+#include "util/mapped-file.hpp"
+
+#include <format>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace util
+{
+	std::expected<MappedFile, util::Error> MappedFile::open(const std::filesystem::path& path) noexcept
+	{
+#ifdef _WIN32
+		const HANDLE file = CreateFileW(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr
+		);
+		if (file == INVALID_HANDLE_VALUE)
+			return util::Error(std::format("Open file '{}' failed", path.string()));
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size))
+		{
+			CloseHandle(file);
+			return util::Error(std::format("Get size of file '{}' failed", path.string()));
+		}
+
+		if (file_size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return MappedFile(nullptr, 0);
+		}
+
+		const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr) return util::Error(std::format("Map file '{}' failed", path.string()));
+
+		const auto* address = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		CloseHandle(mapping);
+		if (address == nullptr)
+			return util::Error(std::format("Map view of file '{}' failed", path.string()));
+
+		return MappedFile(address, static_cast<size_t>(file_size.QuadPart));
+#else
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return util::Error(std::format("Open file '{}' failed", path.string()));
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0)
+		{
+			::close(fd);
+			return util::Error(std::format("Get size of file '{}' failed", path.string()));
+		}
+
+		const auto file_size = static_cast<size_t>(file_stat.st_size);
+		if (file_size == 0)
+		{
+			::close(fd);
+			return MappedFile(nullptr, 0);
+		}
+
+		void* const address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (address == MAP_FAILED) return util::Error(std::format("Map file '{}' failed", path.string()));
+
+		return MappedFile(static_cast<const std::byte*>(address), file_size);
+#endif
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept :
+		address(std::exchange(other.address, nullptr)),
+		size(std::exchange(other.size, 0))
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			address = std::exchange(other.address, nullptr);
+			size = std::exchange(other.size, 0);
+		}
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		release();
+	}
+
+	void MappedFile::release() noexcept
+	{
+		if (address == nullptr) return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(address);
+#else
+		munmap(const_cast<std::byte*>(address), size);
+#endif
+
+		address = nullptr;
+		size = 0;
+	}
+}
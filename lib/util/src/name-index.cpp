@@ -0,0 +1,48 @@
+#include "util/name-index.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+namespace util
+{
+	NameIndex::NameIndex(std::vector<std::pair<std::string_view, uint32_t>> entries) noexcept
+	{
+		std::ranges::sort(entries);
+
+		// Upper bound of the interned size, so that the buffer never moves while views are taken
+		size_t total_size = 0;
+		for (const auto& [name, index] : entries) total_size += name.size();
+		names = std::make_unique_for_overwrite<char[]>(total_size);
+		indices.reserve(entries.size());
+
+		char* cursor = names.get();
+
+		const auto same_name = [](const auto& a, const auto& b) {
+			return a.first == b.first;
+		};
+
+		for (const auto group : entries | std::views::chunk_by(same_name))
+		{
+			const auto name = group.front().first;
+			std::ranges::copy(name, cursor);
+
+			const auto offset = static_cast<uint32_t>(indices.size());
+			indices.append_range(group | std::views::values);
+
+			groups.emplace(
+				std::string_view(cursor, name.size()),
+				std::make_pair(offset, static_cast<uint32_t>(indices.size()) - offset)
+			);
+			cursor += name.size();
+		}
+	}
+
+	std::span<const uint32_t> NameIndex::find(std::string_view name) const noexcept
+	{
+		const auto it = groups.find(name);
+		if (it == groups.end()) return {};
+
+		const auto [offset, count] = it->second;
+		return std::span(indices).subspan(offset, count);
+	}
+}
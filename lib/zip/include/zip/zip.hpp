@@ -6,15 +6,117 @@
 #pragma once
 
 #include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
 #include "util/error.hpp"
 
+struct z_stream_s;
+
 namespace zip
 {
+	// Default chunk size for streaming decompression
+	inline constexpr size_t default_chunk_size = 256 * 1024;
+
+	// Location of an independently compressed member in indexed GZIP data
+	struct GzipMember
+	{
+		size_t compressed_offset;
+		size_t compressed_size;
+		size_t uncompressed_offset;
+		size_t uncompressed_size;
+	};
+
+	///
+	/// @brief Read the member index of GZIP data produced by the asset packer
+	/// @details The packer splits data into independent GZIP members, and stores their sizes in an extra
+	/// field (subfield `CG`) of the first member header
+	///
+	/// @param data Compressed data
+	/// @return Members in order, or `std::nullopt` if the data has no valid index
+	///
+	std::optional<std::vector<GzipMember>> gzip_member_index(std::span<const std::byte> data) noexcept;
+
+	///
+	/// @brief Get the uncompressed size of GZIP data, from the member index or the trailer
+	/// @note The trailer stores the size modulo 2^32 and is not verified until decompression, so the result
+	/// is only a hint
+	///
+	/// @param data Compressed data
+	/// @return Uncompressed size, or `std::nullopt` if the data is not a GZIP stream
+	///
+	std::optional<size_t> gzip_size_hint(std::span<const std::byte> data) noexcept;
+
+	///
+	/// @brief Pull-based streaming decompressor for GZIP or ZLIB data
+	/// @note Concatenated GZIP members are decompressed as one stream. The compressed data must outlive the
+	/// stream
+	///
+	class Stream
+	{
+	  public:
+
+		///
+		/// @brief Start decompressing a stream
+		///
+		/// @param data Compressed data
+		/// @param max_size Maximum acceptable size after decompression, default 1GiB
+		/// @return Stream object, or error on failure
+		///
+		static std::expected<Stream, util::Error> create(
+			std::span<const std::byte> data,
+			size_t max_size = 1 << 30
+		) noexcept;
+
+		///
+		/// @brief Decompress the next part of the stream
+		///
+		/// @param buffer Output buffer, filled as much as possible
+		/// @return Number of bytes written, less than the buffer size only at the end of stream
+		///
+		std::expected<size_t, util::Error> read(std::span<std::byte> buffer) noexcept;
+
+		// Whether the end of stream has been reached
+		bool finished() const noexcept { return end_of_stream; }
+
+		// Total decompressed bytes so far
+		size_t total_out() const noexcept { return total_size; }
+
+		Stream(const Stream&) = delete;
+		Stream(Stream&&) noexcept = default;
+		Stream& operator=(const Stream&) = delete;
+		Stream& operator=(Stream&&) noexcept = default;
+
+	  private:
+
+		struct Deleter
+		{
+			void operator()(z_stream_s* stream) const noexcept;
+		};
+
+		std::unique_ptr<z_stream_s, Deleter> stream;
+		std::span<const std::byte> input;
+		size_t max_size;
+		size_t total_size = 0;
+		bool end_of_stream = false;
+
+		Stream(
+			std::unique_ptr<z_stream_s, Deleter> stream,
+			std::span<const std::byte> input,
+			size_t max_size
+		) noexcept :
+			stream(std::move(stream)),
+			input(input),
+			max_size(max_size)
+		{}
+	};
+
 	///
 	/// @brief Decompress GZIP-compressed data
+	/// @details If the GZIP trailer gives the size up front, the output is allocated once and never grows
 	/// @note Use `Decompressor` for monad usage
 	///
 	/// @param data Compressed Data
@@ -26,6 +128,48 @@ namespace zip
 		size_t max_size = 1 << 30
 	) noexcept;
 
+	///
+	/// @brief Decompress GZIP-compressed data into a caller-provided buffer
+	/// @note Use `gzip_size_hint` to size the buffer
+	///
+	/// @param data Compressed data
+	/// @param output Output buffer, must be large enough for the whole decompressed data
+	/// @return Number of bytes written, or error if the data is malformed or doesn't fit
+	///
+	std::expected<size_t, util::Error> decompress_into(
+		std::span<const std::byte> data,
+		std::span<std::byte> output
+	) noexcept;
+
+	///
+	/// @brief Decompress GZIP-compressed data chunk by chunk, with bounded memory
+	///
+	/// @param data Compressed data
+	/// @param callback Called for each decompressed chunk in order, returning an error aborts decompression
+	/// @param chunk_size Maximum size of each chunk
+	/// @param max_size Maximum acceptable size after decompression, default 1GiB
+	/// @return Total decompressed size, or error on failure
+	///
+	std::expected<size_t, util::Error> decompress_chunked(
+		std::span<const std::byte> data,
+		const std::function<std::expected<void, util::Error>(std::span<const std::byte>)>& callback,
+		size_t chunk_size = default_chunk_size,
+		size_t max_size = 1 << 30
+	) noexcept;
+
+	///
+	/// @brief Decompress GZIP-compressed data, inflating indexed members concurrently
+	/// @note Falls back to `decompress` if the data has no member index
+	///
+	/// @param data Compressed data
+	/// @param max_size Maximum acceptable size after decompression, default 1GiB
+	/// @return Decompressed data, or error information on failure
+	///
+	std::expected<std::vector<std::byte>, util::Error> decompress_parallel(
+		std::span<const std::byte> data,
+		size_t max_size = 1 << 30
+	) noexcept;
+
 	///
 	/// @brief Decompressor functor for monadic usage
 	/// @note Example: `get_asset(...).and_then(zip::Decompressor())`
@@ -43,4 +187,18 @@ namespace zip
 		) const noexcept;
 	};
 
+	// Parallel counterpart of `Decompress`
+	struct DecompressParallel
+	{
+		size_t max_size;
+
+		DecompressParallel(size_t max_size = 1 << 30) :
+			max_size(max_size)
+		{}
+
+		std::expected<std::vector<std::byte>, util::Error> operator()(
+			std::span<const std::byte> data
+		) const noexcept;
+	};
+
 }
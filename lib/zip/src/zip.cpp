@@ -1,32 +1,294 @@
+#include <algorithm>
+#include <array>
+#include <climits>
 #include <format>
-#include <gzip/decompress.hpp>
-#include <stdexcept>
+#include <ranges>
+#include <thread>
+#include <thread_pool/thread_pool.h>
+#include <zlib.h>
 
 #include "zip/zip.hpp"
 
 namespace zip
 {
+	// Read a little-endian unsigned integer
+	static size_t read_le(std::span<const std::byte> bytes) noexcept
+	{
+		size_t value = 0;
+		for (const auto [idx, byte] : bytes | std::views::enumerate)
+			value |= std::to_integer<size_t>(byte) << (8 * idx);
+		return value;
+	}
+
+	// Parse the payload of the `CG` subfield: u32 member count, then u32 compressed and uncompressed sizes
+	static std::optional<std::vector<GzipMember>> parse_member_index(
+		std::span<const std::byte> payload,
+		size_t data_size
+	) noexcept
+	{
+		if (payload.size() < 4) return std::nullopt;
+
+		const auto count = read_le(payload.first(4));
+		if (payload.size() != 4 + count * 8) return std::nullopt;
+
+		std::vector<GzipMember> members;
+		members.reserve(count);
+
+		size_t compressed_offset = 0;
+		size_t uncompressed_offset = 0;
+
+		for (const auto entry : payload.subspan(4) | std::views::chunk(8))
+		{
+			const auto compressed_size = read_le(entry.first(4));
+			const auto uncompressed_size = read_le(entry.subspan(4));
+
+			members.push_back(
+				{.compressed_offset = compressed_offset,
+				 .compressed_size = compressed_size,
+				 .uncompressed_offset = uncompressed_offset,
+				 .uncompressed_size = uncompressed_size}
+			);
+
+			compressed_offset += compressed_size;
+			uncompressed_offset += uncompressed_size;
+		}
+
+		if (compressed_offset != data_size) return std::nullopt;
+
+		return members;
+	}
+
+	std::optional<std::vector<GzipMember>> gzip_member_index(std::span<const std::byte> data) noexcept
+	{
+		// Header: ID1 ID2 CM FLG MTIME(4) XFL OS, then XLEN(2) and the extra field if FLG.FEXTRA is set
+		if (data.size() < 12) return std::nullopt;
+		if (data[0] != std::byte(0x1F) || data[1] != std::byte(0x8B)) return std::nullopt;
+		if ((data[3] & std::byte(0x04)) == std::byte(0)) return std::nullopt;
+
+		const auto extra_size = read_le(data.subspan(10, 2));
+		if (data.size() < 12 + extra_size) return std::nullopt;
+
+		// Subfields: SI1 SI2 LEN(2) payload
+		auto extra = data.subspan(12, extra_size);
+		while (extra.size() >= 4)
+		{
+			const auto payload_size = read_le(extra.subspan(2, 2));
+			if (extra.size() < 4 + payload_size) return std::nullopt;
+
+			if (extra[0] == std::byte('C') && extra[1] == std::byte('G'))
+				return parse_member_index(extra.subspan(4, payload_size), data.size());
+
+			extra = extra.subspan(4 + payload_size);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<size_t> gzip_size_hint(std::span<const std::byte> data) noexcept
+	{
+		if (const auto members = gzip_member_index(data); members.has_value())
+		{
+			if (members->empty()) return 0;
+			return members->back().uncompressed_offset + members->back().uncompressed_size;
+		}
+
+		// 10-byte header starting with magic 1F 8B, 8-byte trailer of CRC32 and ISIZE
+		if (data.size() < 18) return std::nullopt;
+		if (data[0] != std::byte(0x1F) || data[1] != std::byte(0x8B)) return std::nullopt;
+
+		return read_le(data.last(4));
+	}
+
+	void Stream::Deleter::operator()(z_stream_s* stream) const noexcept
+	{
+		inflateEnd(stream);
+		delete stream;
+	}
+
+	std::expected<Stream, util::Error> Stream::create(
+		std::span<const std::byte> data,
+		size_t max_size
+	) noexcept
+	{
+		auto stream = std::make_unique<z_stream>();
+
+		// Window bits 32 + 15: detect GZIP or ZLIB header automatically
+		if (const auto result = inflateInit2(stream.get(), 32 + MAX_WBITS); result != Z_OK)
+			return util::Error(std::format("Initialize inflate failed: {}", zError(result)));
+
+		return Stream(std::unique_ptr<z_stream_s, Deleter>(stream.release()), data, max_size);
+	}
+
+	std::expected<size_t, util::Error> Stream::read(std::span<std::byte> buffer) noexcept
+	{
+		size_t produced = 0;
+
+		while (produced < buffer.size() && !end_of_stream)
+		{
+			// Feed input in pieces, as zlib counts bytes in 32-bit integers
+			if (stream->avail_in == 0 && !input.empty())
+			{
+				const auto feed = input.first(std::min<size_t>(input.size(), UINT_MAX));
+				stream->next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(feed.data()));
+				stream->avail_in = static_cast<uInt>(feed.size());
+				input = input.subspan(feed.size());
+			}
+
+			const auto out_capacity = std::min<size_t>(buffer.size() - produced, UINT_MAX);
+			stream->next_out = reinterpret_cast<Bytef*>(buffer.data() + produced);
+			stream->avail_out = static_cast<uInt>(out_capacity);
+
+			const auto result = inflate(stream.get(), Z_NO_FLUSH);
+			produced += out_capacity - stream->avail_out;
+
+			if (result == Z_STREAM_END)
+			{
+				// Continue with the next member of concatenated GZIP data
+				if (stream->avail_in == 0 && input.empty())
+					end_of_stream = true;
+				else if (const auto reset_result = inflateReset(stream.get()); reset_result != Z_OK)
+					return util::Error(std::format("Reset inflate failed: {}", zError(reset_result)));
+			}
+			else if (result == Z_BUF_ERROR && stream->avail_in == 0 && input.empty())
+				return util::Error("Decompress failed: unexpected end of compressed data");
+			else if (result != Z_OK)
+				return util::Error(
+					std::format(
+						"Decompress failed: {}",
+						stream->msg != nullptr ? stream->msg : zError(result)
+					)
+				);
+		}
+
+		total_size += produced;
+		if (total_size > max_size)
+			return util::Error(std::format("Decompressed size exceeds limit of {} bytes", max_size));
+
+		return produced;
+	}
+
 	std::expected<std::vector<std::byte>, util::Error> decompress(
 		std::span<const std::byte> data,
 		size_t max_size
 	) noexcept
 	{
-		try
+		auto stream = Stream::create(data, max_size);
+		if (!stream) return stream.error();
+
+		// One spare byte, so reaching the end of stream never requires growing the buffer
+		const auto size_hint = gzip_size_hint(data).value_or(default_chunk_size);
+		std::vector<std::byte> decompressed_data(std::min(size_hint, max_size) + 1);
+		size_t written = 0;
+
+		while (!stream->finished())
+		{
+			if (written == decompressed_data.size())
+				decompressed_data.resize(std::min(decompressed_data.size() * 2, max_size + 1));
+
+			const auto read_result = stream->read(std::span(decompressed_data).subspan(written));
+			if (!read_result) return read_result.error();
+			written += *read_result;
+		}
+
+		decompressed_data.resize(written);
+		return decompressed_data;
+	}
+
+	std::expected<size_t, util::Error> decompress_into(
+		std::span<const std::byte> data,
+		std::span<std::byte> output
+	) noexcept
+	{
+		auto stream = Stream::create(data, output.size());
+		if (!stream) return stream.error();
+
+		const auto read_result = stream->read(output);
+		if (!read_result) return read_result.error();
+
+		// Output is full, but the stream may only have its trailer left
+		if (!stream->finished())
 		{
-			std::vector<std::byte> decompressed_data;
-			decompressed_data.reserve(1024 * 1024);
+			std::array<std::byte, 1> probe;
+			const auto probe_result = stream->read(probe);
+			if (!probe_result) return probe_result.error();
+			if (*probe_result != 0 || !stream->finished())
+				return util::Error("Decompressed data exceeds the output buffer");
+		}
+
+		return *read_result;
+	}
+
+	std::expected<size_t, util::Error> decompress_chunked(
+		std::span<const std::byte> data,
+		const std::function<std::expected<void, util::Error>(std::span<const std::byte>)>& callback,
+		size_t chunk_size,
+		size_t max_size
+	) noexcept
+	{
+		auto stream = Stream::create(data, max_size);
+		if (!stream) return stream.error();
 
-			const gzip::Decompressor decompressor(max_size);
+		std::vector<std::byte> chunk(chunk_size);
 
-			decompressor
-				.decompress(decompressed_data, reinterpret_cast<const char*>(data.data()), data.size());
+		while (!stream->finished())
+		{
+			const auto read_result = stream->read(chunk);
+			if (!read_result) return read_result.error();
+			if (*read_result == 0) continue;
 
-			return decompressed_data;
+			if (const auto callback_result = callback(std::span(chunk).first(*read_result)); !callback_result)
+				return callback_result.error().forward("Process decompressed chunk failed");
 		}
-		catch (const std::runtime_error& e)
+
+		return stream->total_out();
+	}
+
+	std::expected<std::vector<std::byte>, util::Error> decompress_parallel(
+		std::span<const std::byte> data,
+		size_t max_size
+	) noexcept
+	{
+		const auto members = gzip_member_index(data);
+		if (!members.has_value() || members->size() <= 1) return decompress(data, max_size);
+
+		const auto total_size = members->back().uncompressed_offset + members->back().uncompressed_size;
+		if (total_size > max_size)
+			return util::Error(std::format("Decompressed size exceeds limit of {} bytes", max_size));
+
+		std::vector<std::byte> decompressed_data(total_size);
+
+		const auto thread_count = std::max<size_t>(
+			std::min<size_t>(std::thread::hardware_concurrency(), members->size()),
+			1
+		);
+		dp::thread_pool thread_pool(static_cast<unsigned int>(thread_count));
+
+		// Members are independent, each one is inflated straight into its own range of the output
+		auto member_futures =
+			*members
+			| std::views::transform([&thread_pool, data, output = std::span(decompressed_data)](
+										const GzipMember& member
+									) {
+				  return thread_pool.enqueue([data, output, member] {
+					  return decompress_into(
+						  data.subspan(member.compressed_offset, member.compressed_size),
+						  output.subspan(member.uncompressed_offset, member.uncompressed_size)
+					  );
+				  });
+			  })
+			| std::ranges::to<std::vector>();
+
+		thread_pool.wait_for_tasks();
+
+		for (auto [idx, future] : member_futures | std::views::enumerate)
 		{
-			return util::Error(std::format("Decompress failed: {}", e.what()));
+			const auto result = future.get();
+			if (!result) return result.error().forward(std::format("Decompress GZIP member {} failed", idx));
+			if (*result != (*members)[idx].uncompressed_size)
+				return util::Error(std::format("GZIP member {} is smaller than its indexed size", idx));
 		}
+
+		return decompressed_data;
 	}
 
 	std::expected<std::vector<std::byte>, util::Error> Decompress::operator()(
@@ -36,4 +298,11 @@ namespace zip
 		return decompress(data, max_size);
 	}
 
-}
\ No newline at end of file
+	std::expected<std::vector<std::byte>, util::Error> DecompressParallel::operator()(
+		std::span<const std::byte> data
+	) const noexcept
+	{
+		return decompress_parallel(data, max_size);
+	}
+
+}
@@ -3,7 +3,7 @@ target("zip")
 	set_kind("static")
 	set_languages("c++23", {public=true})
 
-	add_packages("gzip-hpp", {public=true})
+	add_packages("zlib", "paul_thread_pool")
 
 	add_files("src/*.cpp")
 	add_includedirs("include", {public=true})
@@ -10,6 +10,7 @@
 #include "logic/time-controller.hpp"
 #include "render/drawdata/light.hpp"
 #include "render/param.hpp"
+#include "util/frame-arena.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/trigonometric.hpp>
@@ -22,7 +23,7 @@ class Logic
 	{
 		render::Params params;
 		gltf::Drawdata main_drawdata;
-		std::vector<render::drawdata::Light> light_drawdata_list;
+		std::pmr::vector<render::drawdata::Light> light_drawdata_list;
 	};
 
 	///
@@ -37,9 +38,10 @@ class Logic
 	/// @brief Execute per-frame logic and produce render output
 	///
 	/// @param context SDL backend context
+	/// @param frame_arena Arena of the current frame, the render output allocates from it
 	/// @return Render output including render params and drawdata
 	///
-	RenderOutput logic(const backend::SDLcontext& context) noexcept;
+	RenderOutput logic(const backend::SDLcontext& context, util::FrameArena& frame_arena) noexcept;
 
   private:
 
@@ -49,6 +51,8 @@ class Logic
 
 	const uint32_t ceiling_node_index;
 
+	std::shared_ptr<gltf::ImageCache> image_cache;
+
 	/* Controllers & States */
 
 	struct FireAlarm
@@ -91,9 +95,10 @@ class Logic
 	/// @brief Update and produce render output
 	///
 	/// @param context SDL backend context
+	/// @param resource Memory resource for the render output
 	/// @return Render output including render params and drawdata
 	///
-	RenderOutput update(const backend::SDLcontext& context) noexcept;
+	RenderOutput update(const backend::SDLcontext& context, std::pmr::memory_resource* resource) noexcept;
 
 	/* UI & UI States */
 
@@ -122,10 +127,12 @@ class Logic
 	///
 	/// @param node_vertices Node transformation matrices from main drawdata.
 	/// @param camera_matrices Current camera matrices
+	/// @param frame_arena Arena of the current frame, for the debug overlay
 	///
 	void render_ui(
 		std::span<const glm::mat4> node_vertices,
-		const render::CameraMatrices& camera_matrices
+		const render::CameraMatrices& camera_matrices,
+		const util::FrameArena& frame_arena
 	) noexcept;
 
 	///
@@ -147,10 +154,11 @@ class Logic
 	void sidebar_ui_camera() noexcept;
 
 	///
-	/// @brief Draw debug overlay (fps, device name, driver name)
+	/// @brief Draw debug overlay (fps, device, driver, texture cache, frame arena and mesh statistics)
 	///
+	/// @param frame_arena Arena of the current frame
 	///
-	void draw_debug_overlay() noexcept;
+	void draw_debug_overlay(const util::FrameArena& frame_arena) noexcept;
 
 	/* Constructor */
 
@@ -161,10 +169,12 @@ class Logic
 		logic::Environment environment,
 		std::string device_name,
 		std::string driver_name,
-		uint32_t ceiling_node_index
+		uint32_t ceiling_node_index,
+		std::shared_ptr<gltf::ImageCache> image_cache
 	) :
 		model(std::move(model)),
 		ceiling_node_index(ceiling_node_index),
+		image_cache(std::move(image_cache)),
 		light_controller(std::move(light_controller)),
 		furniture_controller(std::move(furniture_controller)),
 		environment(std::move(environment)),
@@ -8,6 +8,7 @@
 #include <expected>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 
 namespace logic
@@ -50,17 +51,22 @@ namespace logic
 
 		///
 		/// @brief Get emission overrides for light groups
+		/// @param resource Memory resource for the returned list
 		/// @return List of node index and emission multiplier pairs
 		///
-		std::vector<std::pair<uint32_t, float>> get_emission_overrides() const noexcept;
+		std::pmr::vector<std::pair<uint32_t, float>> get_emission_overrides(
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+		) const noexcept;
 
 		///
 		/// @brief Get light drawdata from enabled light groups
 		/// @param drawdata Main drawdata for node matrices
+		/// @param resource Memory resource for the returned list
 		/// @return List of light drawdata
 		///
-		std::vector<render::drawdata::Light> get_light_drawdata(
-			const gltf::Drawdata& drawdata
+		std::pmr::vector<render::drawdata::Light> get_light_drawdata(
+			const gltf::Drawdata& drawdata,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
 		) const noexcept;
 
 		///
@@ -2,6 +2,7 @@
 #include "asset/scene.hpp"
 #include "backend/loop.hpp"
 #include "backend/sdl.hpp"
+#include "gltf/image-cache.hpp"
 #include "gltf/model.hpp"
 #include "logic/area.hpp"
 #include "logic/light-controller.hpp"
@@ -10,21 +11,120 @@
 #include "util/asset.hpp"
 #include "zip/zip.hpp"
 
+#include <SDL3/SDL_filesystem.h>
 #include <SDL3/SDL_properties.h>
 #include <cstdint>
+#include <filesystem>
 #include <imgui.h>
 #include <implot.h>
 #include <string>
 
+// Maximum size of the on-disk compressed texture cache
+static constexpr uint64_t image_cache_max_size = 2ull << 30;
+
+// Create the compressed texture cache under the user preference directory, or nullptr if unavailable
+static std::shared_ptr<gltf::ImageCache> create_image_cache() noexcept
+{
+	char* const pref_path = SDL_GetPrefPath("Stehsaer", "CG-Assignment-2025");
+	if (pref_path == nullptr) return nullptr;
+
+	const auto pref_path_u8 = std::u8string_view(reinterpret_cast<const char8_t*>(pref_path));
+	const auto directory = std::filesystem::path(pref_path_u8) / "image-cache";
+	SDL_free(pref_path);
+
+	return gltf::ImageCache::create(directory, image_cache_max_size).value_or(nullptr);
+}
+
+// Name of the baked scene file, looked up next to the executable. Produced by the `scene-bake` tool.
+static constexpr auto baked_scene_filename = "scene.cgscene";
+
+// Get path of the baked scene, or nullopt if not present
+static std::optional<std::filesystem::path> find_baked_scene() noexcept
+{
+	const char* const base_path = SDL_GetBasePath();
+	if (base_path == nullptr) return std::nullopt;
+
+	const auto path =
+		std::filesystem::path(std::u8string_view(reinterpret_cast<const char8_t*>(base_path)))
+		/ baked_scene_filename;
+
+	std::error_code ec;
+	if (!std::filesystem::is_regular_file(path, ec)) return std::nullopt;
+
+	return path;
+}
+
+// Display model loading progress
+static void display_load_progress(const std::atomic<gltf::Model::LoadProgress>& load_progress) noexcept
+{
+	const auto current = load_progress.load();
+
+	switch (current.stage)
+	{
+	case gltf::Model::LoadStage::Node:
+		ImGui::Text("解析节点树...");
+		break;
+	case gltf::Model::LoadStage::Mesh:
+		ImGui::Text("分析并优化网格...");
+		break;
+	case gltf::Model::LoadStage::Material:
+		ImGui::Text("压缩材质...");
+		break;
+	case gltf::Model::LoadStage::Animation:
+		ImGui::Text("解析动画...");
+		break;
+	case gltf::Model::LoadStage::Skin:
+		ImGui::Text("解析皮肤...");
+		break;
+	case gltf::Model::LoadStage::Postprocess:
+		ImGui::Text("处理中...");
+		break;
+	}
+
+	ImGui::ProgressBar(
+		current.progress < 0 ? (-ImGui::GetTime()) : current.progress,
+		ImVec2(300.0f, 0.0f)
+	);
+}
+
+static std::expected<gltf::Model, util::Error> create_scene_from_baked(
+	const backend::SDLcontext& context,
+	const std::filesystem::path& path
+) noexcept
+{
+	std::atomic<gltf::Model::LoadProgress> load_progress;
+
+	auto future = std::async(std::launch::async, [&context, &path, &load_progress]() {
+		return gltf::Model::from_baked(
+			context.device,
+			path,
+			gltf::SamplerConfig{.anisotropy = 4.0f},
+			gltf::MeshConfig{.quantize_vertices = true},
+			std::ref(load_progress)
+		);
+	});
+
+	auto gltf_result = backend::display_until_task_done(context, std::move(future), [&load_progress] {
+		display_load_progress(load_progress);
+	});
+	if (!gltf_result) return gltf_result.error().forward("Load baked scene failed");
+
+	return gltf_result;
+}
+
 static std::expected<gltf::Model, util::Error> create_scene_from_model(
-	const backend::SDLcontext& context
+	const backend::SDLcontext& context,
+	const std::shared_ptr<gltf::ImageCache>& image_cache
 ) noexcept
 {
 	auto model_decompress_result = backend::display_until_task_done(
 		context,
 		std::async(
 			std::launch::async,
-			[] { return util::get_asset(resource_asset::scene, "scene.glb").and_then(zip::Decompress()); }
+			[] {
+				return util::get_asset(resource_asset::scene, "scene.glb")
+					.and_then(zip::DecompressParallel());
+			}
 		),
 		[] {
 			ImGui::Text("解压场景数据...");
@@ -49,46 +149,23 @@ static std::expected<gltf::Model, util::Error> create_scene_from_model(
 
 	std::atomic<gltf::Model::LoadProgress> load_progress;
 
-	auto future = std::async(std::launch::async, [&context, &gltf_load_result, &load_progress]() {
-		return gltf::Model::from_tinygltf(
-			context.device,
-			*gltf_load_result,
-			gltf::SamplerConfig{.anisotropy = 4.0f},
-			{.color_mode = gltf::ColorCompressMode::RGBA8_BC3,
-			 .normal_mode = gltf::NormalCompressMode::RGn_BC5},
-			std::ref(load_progress)
-		);
-	});
+	auto future =
+		std::async(std::launch::async, [&context, &gltf_load_result, &load_progress, &image_cache]() {
+			return gltf::Model::from_tinygltf(
+				context.device,
+				*gltf_load_result,
+				gltf::SamplerConfig{.anisotropy = 4.0f},
+				{.color_mode = gltf::ColorCompressMode::RGBA8_BC3,
+				 .normal_mode = gltf::NormalCompressMode::RGn_BC5,
+				 .parallel_compress = true,
+				 .cache = image_cache},
+				gltf::MeshConfig{.quantize_vertices = true},
+				std::ref(load_progress)
+			);
+		});
 
 	auto gltf_result = backend::display_until_task_done(context, std::move(future), [&load_progress] {
-		const auto current = load_progress.load();
-
-		switch (current.stage)
-		{
-		case gltf::Model::LoadStage::Node:
-			ImGui::Text("解析节点树...");
-			break;
-		case gltf::Model::LoadStage::Mesh:
-			ImGui::Text("分析并优化网格...");
-			break;
-		case gltf::Model::LoadStage::Material:
-			ImGui::Text("压缩材质...");
-			break;
-		case gltf::Model::LoadStage::Animation:
-			ImGui::Text("解析动画...");
-			break;
-		case gltf::Model::LoadStage::Skin:
-			ImGui::Text("解析皮肤...");
-			break;
-		case gltf::Model::LoadStage::Postprocess:
-			ImGui::Text("处理中...");
-			break;
-		}
-
-		ImGui::ProgressBar(
-			current.progress < 0 ? (-ImGui::GetTime()) : current.progress,
-			ImVec2(300.0f, 0.0f)
-		);
+		display_load_progress(load_progress);
 	});
 	if (!gltf_result) return gltf_result.error().forward("Load gltf model failed");
 
@@ -97,7 +174,14 @@ static std::expected<gltf::Model, util::Error> create_scene_from_model(
 
 std::expected<Logic, util::Error> Logic::create(const backend::SDLcontext& context) noexcept
 {
-	auto model = create_scene_from_model(context);
+	auto image_cache = create_image_cache();
+
+	// Prefer the baked scene, fall back to processing the embedded model if it is missing or outdated
+	const auto baked_scene_path = find_baked_scene();
+
+	std::expected<gltf::Model, util::Error> model = util::Error("Baked scene not found");
+	if (baked_scene_path.has_value()) model = create_scene_from_baked(context, *baked_scene_path);
+	if (!model) model = create_scene_from_model(context, image_cache);
 	if (!model) return model.error().forward("Load 3D model failed");
 
 	auto light_controller = logic::LightController::create(context.device, *model);
@@ -131,7 +215,8 @@ std::expected<Logic, util::Error> Logic::create(const backend::SDLcontext& conte
 		std::move(*environment),
 		device_name,
 		std::format("{} ({})", driver_name, driver_version),
-		*ceiling_node_index
+		*ceiling_node_index,
+		std::move(image_cache)
 	);
 }
 
@@ -202,14 +287,15 @@ void Logic::sidebar_ui_camera() noexcept
 
 void Logic::render_ui(
 	std::span<const glm::mat4> node_vertices,
-	const render::CameraMatrices& camera_matrices
+	const render::CameraMatrices& camera_matrices,
+	const util::FrameArena& frame_arena
 ) noexcept
 {
 	// Bottom left sidebar
 	sidebar_ui();
 
-	// Debug overlay: fps, device name, driver name
-	draw_debug_overlay();
+	// Debug overlay: fps, device name, driver name, statistics
+	draw_debug_overlay(frame_arena);
 
 	// Time controller UI, always visible
 	time_controller.control_ui();
@@ -261,7 +347,7 @@ void Logic::render_ui(
 	}
 }
 
-void Logic::draw_debug_overlay() noexcept
+void Logic::draw_debug_overlay(const util::FrameArena& frame_arena) noexcept
 {
 	auto drawlist = ImGui::GetBackgroundDrawList();
 
@@ -288,9 +374,36 @@ void Logic::draw_debug_overlay() noexcept
 	draw_text(fps_string, {10.0f, 10.0f}, 24.0f);
 	draw_text(device_name, {10.0f, 40.0f}, 16.0f);
 	draw_text(driver_name, {10.0f, 60.0f}, 16.0f);
+
+	if (image_cache != nullptr)
+	{
+		const auto [hits, misses, evictions] = image_cache->get_stats();
+		draw_text(
+			std::format("Texture cache: {} hits, {} misses, {} evicted", hits, misses, evictions),
+			{10.0f, 80.0f},
+			16.0f
+		);
+	}
+
+	draw_text(
+		std::format(
+			"Frame arena: {} KiB, {} heap allocations in the last frame",
+			frame_arena.capacity() / 1024,
+			frame_arena.heap_allocation_count()
+		),
+		{10.0f, 100.0f},
+		16.0f
+	);
+
+	// Only models processed at load time carry statistics, baked scenes were optimized offline
+	if (const auto& mesh_statistics = model.get_mesh_statistics(); mesh_statistics.primitive_count > 0)
+		draw_text(mesh_statistics.to_string(), {10.0f, 120.0f}, 16.0f);
 }
 
-Logic::RenderOutput Logic::update(const backend::SDLcontext& context) noexcept
+Logic::RenderOutput Logic::update(
+	const backend::SDLcontext& context,
+	std::pmr::memory_resource* resource
+) noexcept
 {
 	const auto camera_matrices = [&]() {
 		switch (view_mode)
@@ -325,16 +438,16 @@ Logic::RenderOutput Logic::update(const backend::SDLcontext& context) noexcept
 
 	/* Generate render params */
 
-	std::vector<std::pair<uint32_t, float>> emission_overrides = light_controller.get_emission_overrides();
+	const auto emission_overrides = light_controller.get_emission_overrides(resource);
 	const auto [primary_light_param, ambient_light_param] = time_controller.get_sun_params();
 
-	std::vector<uint32_t> hidden_nodes;
+	std::pmr::vector<uint32_t> hidden_nodes(resource);
 	if (view_mode == ViewMode::Cross_section) hidden_nodes.push_back(ceiling_node_index);
 
 	auto main_drawdata =
-		model.generate_drawdata(glm::mat4(1.0f), animation_keys, emission_overrides, hidden_nodes);
+		model.generate_drawdata(glm::mat4(1.0f), animation_keys, emission_overrides, hidden_nodes, resource);
 
-	auto light_drawdata_list = light_controller.get_light_drawdata(main_drawdata);
+	auto light_drawdata_list = light_controller.get_light_drawdata(main_drawdata, resource);
 
 	const render::Params params{
 		.camera = camera_matrices,
@@ -349,9 +462,9 @@ Logic::RenderOutput Logic::update(const backend::SDLcontext& context) noexcept
 	};
 }
 
-Logic::RenderOutput Logic::logic(const backend::SDLcontext& context) noexcept
+Logic::RenderOutput Logic::logic(const backend::SDLcontext& context, util::FrameArena& frame_arena) noexcept
 {
-	auto render_results = update(context);
-	render_ui(render_results.main_drawdata.node_matrices, render_results.params.camera);
+	auto render_results = update(context, frame_arena.resource());
+	render_ui(render_results.main_drawdata.node_matrices, render_results.params.camera, frame_arena);
 	return render_results;
 }
@@ -212,9 +212,11 @@ namespace logic
 		);
 	}
 
-	std::vector<std::pair<uint32_t, float>> LightController::get_emission_overrides() const noexcept
+	std::pmr::vector<std::pair<uint32_t, float>> LightController::get_emission_overrides(
+		std::pmr::memory_resource* resource
+	) const noexcept
 	{
-		std::vector<std::pair<uint32_t, float>> emission_overrides;
+		std::pmr::vector<std::pair<uint32_t, float>> emission_overrides(resource);
 
 		for (const auto& light_group : light_groups | std::views::values)
 			emission_overrides.append_range(
@@ -226,8 +228,9 @@ namespace logic
 		return emission_overrides;
 	}
 
-	std::vector<render::drawdata::Light> LightController::get_light_drawdata(
-		const gltf::Drawdata& drawdata
+	std::pmr::vector<render::drawdata::Light> LightController::get_light_drawdata(
+		const gltf::Drawdata& drawdata,
+		std::pmr::memory_resource* resource
 	) const noexcept
 	{
 		return light_groups
@@ -243,7 +246,7 @@ namespace logic
 					   light.volume
 				   );
 			   })
-			| std::ranges::to<std::vector>();
+			| std::ranges::to<std::pmr::vector<render::drawdata::Light>>(resource);
 	}
 
 	void LightController::handle_fire_event() noexcept
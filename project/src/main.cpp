@@ -11,6 +11,7 @@
 #include "backend/sdl.hpp"
 #include "logic.hpp"
 #include "render.hpp"
+#include "util/frame-arena.hpp"
 #include "util/unwrap.hpp"
 
 static void main_logic(const backend::SDLcontext& sdl_context)
@@ -33,8 +34,13 @@ static void main_logic(const backend::SDLcontext& sdl_context)
 	bool quit = false;
 	bool fullscreen = false;
 
+	// Per-frame containers allocate from here, everything of the last frame is gone at the loop start
+	util::FrameArena frame_arena;
+
 	while (!quit)
 	{
+		frame_arena.reset();
+
 		SDL_Event event;
 		while (SDL_PollEvent(&event))
 		{
@@ -51,14 +57,18 @@ static void main_logic(const backend::SDLcontext& sdl_context)
 		/*===== Logic =====*/
 
 		backend::imgui_new_frame();
-		auto [params, main_drawdata, primary_point_lights] = logic.logic(sdl_context);
+		auto [params, main_drawdata, primary_point_lights] = logic.logic(sdl_context, frame_arena);
 
-		std::vector<gltf::Drawdata> drawdata_list;
+		std::pmr::vector<gltf::Drawdata> drawdata_list(frame_arena.resource());
 		drawdata_list.emplace_back(std::move(main_drawdata));
 
 		/*===== Render =====*/
 
-		const render::Drawdata drawdata = {.models = drawdata_list, .lights = primary_point_lights};
+		const render::Drawdata drawdata = {
+			.models = drawdata_list,
+			.lights = primary_point_lights,
+			.frame_resource = frame_arena.resource()
+		};
 
 		render_resource.render(sdl_context, drawdata, params) | util::unwrap("Render frame failed");
 	}
@@ -3,6 +3,7 @@
 #include <expected>
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
+#include <memory_resource>
 
 #include "gltf/model.hpp"
 #include "render/drawdata/light.hpp"
@@ -16,6 +17,9 @@ namespace render
 	{
 		std::span<const gltf::Drawdata> models;
 		std::span<const drawdata::Light> lights;
+
+		// Memory resource for per-frame render drawdata, must outlive the `render` call
+		std::pmr::memory_resource* frame_resource = std::pmr::get_default_resource();
 	};
 
 	class Renderer
@@ -40,7 +44,8 @@ namespace render
 
 		std::expected<std::tuple<drawdata::Gbuffer, drawdata::Shadow>, util::Error> prepare_drawdata(
 			std::span<const gltf::Drawdata> drawdata_list,
-			const Params& params
+			const Params& params,
+			std::pmr::memory_resource* frame_resource
 		) noexcept;
 
 		std::expected<void, util::Error> copy_resources(
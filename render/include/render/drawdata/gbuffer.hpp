@@ -2,6 +2,9 @@
 
 #include "gltf/material.hpp"
 #include "gltf/model.hpp"
+#include "render/drawdata/sort-key.hpp"
+
+#include <memory_resource>
 
 namespace render::drawdata
 {
@@ -9,9 +12,9 @@ namespace render::drawdata
 	{
 		struct Drawcall
 		{
+			uint64_t sort_key;  // See `make_sort_key`, depth is the negated maximum Z
 			gltf::PrimitiveDrawcall drawcall;
 			size_t resource_set_index;
-			float max_z;
 		};
 
 		struct Resource
@@ -20,8 +23,8 @@ namespace render::drawdata
 			std::shared_ptr<gltf::DeferredSkinningResource> deferred_skinning_resource;
 		};
 
-		std::map<std::pair<gltf::PipelineMode, bool>, std::vector<Drawcall>> drawcalls;
-		std::vector<Resource> resource_sets;
+		std::pmr::vector<Drawcall> drawcalls;  // Grouped by pipeline after `sort()`
+		std::pmr::vector<Resource> resource_sets;
 
 		glm::mat4 camera_matrix;
 		glm::vec3 eye_position;
@@ -31,15 +34,27 @@ namespace render::drawdata
 		float min_z = 1;      // Minimum Z value
 		float near_distance;  // Distance from eye to near plane
 
+		// Maximum simplification error on screen, relative to the screen size, see `gltf::select_lod`
+		float lod_max_error = 1.0f / 1024.0f;
+
+		// Meshlet ranges per drawcall beyond which one merged range is drawn, see `gltf::cull_meshlets`
+		size_t max_cluster_ranges = 8;
+
 		///
 		/// @brief Create drawdata with camera matrix
 		///
 		/// @param camera_matrix Camera matrix
+		/// @param resource Memory resource for the drawcall containers, usually a per-frame arena
 		///
-		Gbuffer(const glm::mat4& camera_matrix, const glm::vec3& eye_position) noexcept;
+		Gbuffer(
+			const glm::mat4& camera_matrix,
+			const glm::vec3& eye_position,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+		) noexcept;
 
 		///
 		/// @brief Add glTF drawdata
+		/// @details Full detail primitives are split into the index ranges of their visible meshlets
 		///
 		/// @param drawdata glTF drawdata
 		///
@@ -60,7 +75,7 @@ namespace render::drawdata
 		float get_max_distance() const noexcept;
 
 		///
-		/// @brief Sort drawcalls for optimal rendering
+		/// @brief Sort drawcalls by pipeline, then material, then front to back
 		///
 		///
 		void sort() noexcept;
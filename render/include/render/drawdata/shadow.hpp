@@ -3,6 +3,13 @@
 #include "gltf/material.hpp"
 #include "gltf/model.hpp"
 #include "graphics/smallest-bound.hpp"
+#include "render/drawdata/sort-key.hpp"
+
+#include <array>
+#include <future>
+#include <memory_resource>
+#include <span>
+#include <thread_pool/thread_pool.h>
 
 namespace render::drawdata
 {
@@ -10,9 +17,9 @@ namespace render::drawdata
 	{
 		struct Drawcall
 		{
+			uint64_t sort_key;  // See `make_sort_key`, depth is the minimum distance in light view
 			gltf::PrimitiveDrawcall drawcall;
 			size_t resource_set_index;
-			float min_z;
 		};
 
 		struct Resource
@@ -23,8 +30,8 @@ namespace render::drawdata
 
 		struct ShadowLevelData
 		{
-			std::map<std::pair<gltf::PipelineMode, bool>, std::vector<Drawcall>> drawcalls;
-			std::vector<Resource> resource_sets;
+			std::pmr::vector<Drawcall> drawcalls;  // Grouped by pipeline after `sort()`
+			std::pmr::vector<Resource> resource_sets;
 
 			graphics::SmallestBound smallest_bound;
 			std::array<glm::vec4, 4> frustum_planes;
@@ -32,14 +39,24 @@ namespace render::drawdata
 			float near = std::numeric_limits<float>::max();
 			float far = std::numeric_limits<float>::lowest();
 
-			void append(const gltf::Drawdata& drawdata) noexcept;
+			explicit ShadowLevelData(std::pmr::memory_resource* resource) noexcept :
+				drawcalls(resource),
+				resource_sets(resource)
+			{}
+
+			void append(const gltf::Drawdata& drawdata, float lod_max_error) noexcept;
 
 			glm::mat4 get_vp_matrix() const noexcept;
 
 			void sort() noexcept;
 		};
 
-		std::array<ShadowLevelData, 3> csm_levels;
+		static constexpr size_t level_count = 3;
+
+		std::array<ShadowLevelData, level_count> csm_levels;
+
+		// Maximum simplification error in a cascade, relative to the cascade size, see `gltf::select_lod`
+		float lod_max_error = 1.0f / 1024.0f;
 
 		///
 		/// @brief Create a drawdata for shadow rendering
@@ -48,12 +65,14 @@ namespace render::drawdata
 		/// @param light_direction Light direction
 		/// @param min_z Minimum Z in view space
 		/// @param linear_blend_ratio Linear blend ratio for CSM levels
+		/// @param resource Memory resource for the drawcall containers, usually a per-frame arena
 		///
 		Shadow(
 			const glm::mat4& camera_matrix,
 			const glm::vec3& light_direction,
 			float min_z,
-			float linear_blend_ratio
+			float linear_blend_ratio,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()
 		) noexcept;
 
 		///
@@ -63,6 +82,21 @@ namespace render::drawdata
 		///
 		void append(const gltf::Drawdata& drawdata) noexcept;
 
+		///
+		/// @brief Append and sort glTF drawdata of a frame, with one job per CSM level
+		/// @details Jobs only write to their own level, so the result is identical to `append` on every
+		/// drawdata followed by `sort`
+		/// @warning The drawdata list and this object must stay in place until all futures are ready
+		///
+		/// @param drawdata_list glTF drawdata list
+		/// @param pool Thread pool running the jobs
+		/// @return Futures of the level jobs
+		///
+		std::array<std::future<void>, level_count> append_sort_async(
+			std::span<const gltf::Drawdata> drawdata_list,
+			dp::thread_pool<>& pool
+		) noexcept;
+
 		///
 		/// @brief Compute view-projection matrix
 		///
@@ -72,7 +106,7 @@ namespace render::drawdata
 		glm::mat4 get_vp_matrix(size_t level) const noexcept;
 
 		///
-		/// @brief Sort drawcalls for optimal rendering
+		/// @brief Sort drawcalls by pipeline, then material, then front to back
 		///
 		///
 		void sort() noexcept;
@@ -0,0 +1,97 @@
+///
+/// @file sort-key.hpp
+/// @brief Provides packed 64-bit drawcall sort keys, and a radix sort over them
+///
+
+#pragma once
+
+#include "gltf/material.hpp"
+#include "gltf/mesh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace render::drawdata
+{
+	///
+	/// @brief Pack a drawcall sort key
+	/// @details Layout from the most significant bit:
+	/// - 5 bits pipeline: alpha mode, double sided, vertex format
+	/// - 27 bits material index, then 32 bits depth
+	/// - For blended pipelines the depth comes before the material, so blending order follows depth only
+	///
+	/// @param pipeline_mode Pipeline mode of the material
+	/// @param vertex_format Vertex format of the drawcall
+	/// @param material_index Material index, no material sorts last
+	/// @param depth Depth value, drawcalls with smaller depth come first
+	/// @return Sort key
+	///
+	uint64_t make_sort_key(
+		gltf::PipelineMode pipeline_mode,
+		gltf::VertexFormat vertex_format,
+		std::optional<uint32_t> material_index,
+		float depth
+	) noexcept;
+
+	///
+	/// @brief Unpack the pipeline of a sort key
+	///
+	/// @param sort_key Sort key made by `make_sort_key`
+	/// @return Pipeline mode and vertex format
+	///
+	std::pair<gltf::PipelineMode, gltf::VertexFormat> sort_key_pipeline(uint64_t sort_key) noexcept;
+
+	///
+	/// @brief Sort elements by their `sort_key` member with an LSD radix sort
+	/// @details Only (key, index) pairs are shuffled between passes, digits shared by all keys are skipped.
+	/// Elements are moved into place once at the end.
+	///
+	/// @param elements Elements to sort, must have a `uint64_t sort_key` member
+	///
+	template <typename T>
+	void radix_sort(std::pmr::vector<T>& elements) noexcept
+	{
+		constexpr size_t digit_bits = 8;
+		constexpr size_t digit_count = 64 / digit_bits;
+		constexpr size_t bucket_count = 1 << digit_bits;
+
+		const auto resource = elements.get_allocator().resource();
+
+		std::pmr::vector<std::pair<uint64_t, uint32_t>> keys(resource), scratch(resource);
+		keys.reserve(elements.size());
+		for (const auto [idx, element] : elements | std::views::enumerate)
+			keys.emplace_back(element.sort_key, static_cast<uint32_t>(idx));
+		scratch.resize(keys.size());
+
+		// Histograms of all digits in one pass
+		std::array<std::array<uint32_t, bucket_count>, digit_count> histograms{};
+		for (const auto key : keys | std::views::keys)
+			for (const auto digit : std::views::iota(0zu, digit_count))
+				histograms[digit][(key >> (digit * digit_bits)) & (bucket_count - 1)]++;
+
+		for (const auto [digit, histogram] : histograms | std::views::enumerate)
+		{
+			if (std::ranges::contains(histogram, static_cast<uint32_t>(keys.size()))) continue;
+
+			std::array<uint32_t, bucket_count> offsets;
+			std::exclusive_scan(histogram.begin(), histogram.end(), offsets.begin(), 0u);
+
+			for (const auto& entry : keys)
+				scratch[offsets[(entry.first >> (digit * digit_bits)) & (bucket_count - 1)]++] = entry;
+
+			std::swap(keys, scratch);
+		}
+
+		std::pmr::vector<T> sorted(resource);
+		sorted.reserve(elements.size());
+		for (const auto index : keys | std::views::values) sorted.emplace_back(std::move(elements[index]));
+
+		elements = std::move(sorted);
+	}
+}
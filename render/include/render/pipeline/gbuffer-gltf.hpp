@@ -15,8 +15,8 @@ namespace render::pipeline
 {
 	class GbufferGLTF
 	{
-		// (Pipeline Mode, Rigged) -> Pipeline Instance
-		std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipelines;
+		// (Pipeline Mode, Vertex Format) -> Pipeline Instance
+		std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>> pipelines;
 
 		struct alignas(64) Frag_param
 		{
@@ -38,8 +38,19 @@ namespace render::pipeline
 			static PerObjectParam from(const gltf::PrimitiveDrawcall& drawcall) noexcept;
 		};
 
+		// Model uniform of the quantized vertex shader
+		struct QuantizedModelParam
+		{
+			alignas(16) glm::mat4 model;
+			alignas(16) glm::vec4 position_offset;
+			alignas(16) glm::vec4 position_scale;
+
+			static QuantizedModelParam from(const gltf::PrimitiveDrawcall& drawcall) noexcept;
+		};
+
 		GbufferGLTF(
-			std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipelines
+			std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>>
+				pipelines
 		) noexcept :
 			pipelines(std::move(pipelines))
 		{}
@@ -85,6 +96,20 @@ namespace render::pipeline
 			) const noexcept override;
 		};
 
+		// Same as `PipelineNormal`, but positions are dequantized in the vertex shader
+		class PipelineQuantized : public PipelineNormal
+		{
+		  public:
+
+			using PipelineNormal::PipelineNormal;
+
+			void draw(
+				const gpu::CommandBuffer& command_buffer,
+				const gpu::RenderPass& render_pass,
+				const gltf::PrimitiveDrawcall& drawcall
+			) const noexcept override;
+		};
+
 		class PipelineRigged : public PipelineGLTF
 		{
 			gltf::PipelineMode mode;
@@ -13,11 +13,12 @@ namespace render::pipeline
 {
 	class ShadowGLTF
 	{
-		// (Pipeline Mode, Rigged) -> Pipeline Instance
-		std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipelines;
+		// (Pipeline Mode, Vertex Format) -> Pipeline Instance
+		std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>> pipelines;
 
 		ShadowGLTF(
-			std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipelines
+			std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>>
+				pipelines
 		) noexcept :
 			pipelines(std::move(pipelines))
 		{}
@@ -69,6 +70,20 @@ namespace render::pipeline
 			) const noexcept override;
 		};
 
+		// Same as `PipelineNormal`, with dequantization folded into the model matrix
+		class PipelineQuantized : public PipelineNormal
+		{
+		  public:
+
+			using PipelineNormal::PipelineNormal;
+
+			void draw(
+				const gpu::CommandBuffer& command_buffer,
+				const gpu::RenderPass& render_pass,
+				const gltf::PrimitiveDrawcall& drawcall
+			) const noexcept override;
+		};
+
 		class PipelineRigged : public PipelineGLTF
 		{
 			gltf::PipelineMode mode;
@@ -0,0 +1,44 @@
+// G-Buffer Vertex Shader, quantized vertices
+
+#version 460
+
+#include "../common/oct.glsl"
+
+layout(location = 0) in vec4 in_pos;             // Unorm, relative to the primitive bounds, bitangent sign in w
+layout(location = 1) in vec4 in_normal_tangent;  // Octahedral normal and tangent
+layout(location = 2) in vec2 in_uv;
+
+layout(location = 0) out vec2 out_uv;
+layout(location = 1) out vec3 out_normal;
+layout(location = 2) out vec3 out_tangent;
+layout(location = 3) out vec3 out_bitangent;
+
+layout(std140, set = 1, binding = 0) uniform Transform
+{
+    mat4 VP;
+} transform;
+
+layout(std140, set = 1, binding = 1) uniform Model
+{
+    mat4 M;
+    vec4 position_offset;
+    vec4 position_scale;
+} model;
+
+void main()
+{
+    out_uv = in_uv;
+
+    out_normal = (model.M * vec4(octToNormal(in_normal_tangent.xy), 0.0f)).xyz;
+    out_normal = normalize(out_normal);
+
+    out_tangent = (model.M * vec4(octToNormal(in_normal_tangent.zw), 0.0f)).xyz;
+    out_tangent = normalize(out_tangent);
+
+    out_bitangent = cross(out_normal, out_tangent);
+    out_tangent = cross(out_bitangent, out_normal);
+    out_bitangent *= in_pos.w * 2.0f - 1.0f;
+
+    vec3 position = model.position_offset.xyz + in_pos.xyz * model.position_scale.xyz;
+    gl_Position = transform.VP * model.M * vec4(position, 1.0f);
+}
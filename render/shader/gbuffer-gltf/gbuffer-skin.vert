@@ -4,7 +4,7 @@
 
 layout(location = 0) in vec3 in_pos;
 layout(location = 1) in vec3 in_normal;
-layout(location = 2) in vec3 in_tangent;
+layout(location = 2) in vec4 in_tangent;  // Bitangent sign in w
 layout(location = 3) in vec2 in_uv;
 layout(location = 4) in uvec4 in_joint_indices;
 layout(location = 5) in vec4 in_joint_weights;
@@ -47,11 +47,12 @@ void main()
     out_normal = (skin_matrix * vec4(in_normal, 0.0f)).xyz;
     out_normal = normalize(out_normal);
 
-    out_tangent = (skin_matrix * vec4(in_tangent, 0.0f)).xyz;
+    out_tangent = (skin_matrix * vec4(in_tangent.xyz, 0.0f)).xyz;
     out_tangent = normalize(out_tangent);
 
     out_bitangent = cross(out_normal, out_tangent);
     out_tangent = cross(out_bitangent, out_normal);
+    out_bitangent *= in_tangent.w;
 
     gl_Position = transform.VP * skin_matrix * vec4(in_pos, 1.0f);
 }
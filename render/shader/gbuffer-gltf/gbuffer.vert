@@ -4,7 +4,7 @@
 
 layout(location = 0) in vec3 in_pos;
 layout(location = 1) in vec3 in_normal;
-layout(location = 2) in vec3 in_tangent;
+layout(location = 2) in vec4 in_tangent;  // Bitangent sign in w
 layout(location = 3) in vec2 in_uv;
 
 layout(location = 0) out vec2 out_uv;
@@ -29,11 +29,12 @@ void main()
     out_normal = (model.M * vec4(in_normal, 0.0f)).xyz;
     out_normal = normalize(out_normal);
 
-    out_tangent = (model.M * vec4(in_tangent, 0.0f)).xyz;
+    out_tangent = (model.M * vec4(in_tangent.xyz, 0.0f)).xyz;
     out_tangent = normalize(out_tangent);
 
     out_bitangent = cross(out_normal, out_tangent);
     out_tangent = cross(out_bitangent, out_normal);
+    out_bitangent *= in_tangent.w;
 
     gl_Position = transform.VP * model.M * vec4(in_pos, 1.0f);
 }
@@ -3,11 +3,18 @@
 #include "graphics/culling.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <ranges>
 
 namespace render::drawdata
 {
-	Gbuffer::Gbuffer(const glm::mat4& camera_matrix, const glm::vec3& eye_position) noexcept :
+	Gbuffer::Gbuffer(
+		const glm::mat4& camera_matrix,
+		const glm::vec3& eye_position,
+		std::pmr::memory_resource* resource
+	) noexcept :
+		drawcalls(resource),
+		resource_sets(resource),
 		camera_matrix(camera_matrix),
 		eye_position(eye_position)
 	{
@@ -30,14 +37,16 @@ namespace render::drawdata
 			}
 		);
 
+		std::pmr::vector<uint32_t> visible_primitives(drawcalls.get_allocator());
+		drawdata.primitive_bvh->query(frustum_planes, visible_primitives);
+
 		auto visible_nonrigged_drawcalls =
-			drawdata.primitive_drawcalls | std::views::filter([this](const auto& drawcall) -> bool {
-				return graphics::box_in_frustum(
-					drawcall.world_position_min,
-					drawcall.world_position_max,
-					frustum_planes
-				);
-			});
+			visible_primitives
+			| std::views::transform([&drawdata](uint32_t idx) { return drawdata.bvh_drawcall_indices[idx]; })
+			| std::views::filter([](uint32_t idx) { return idx != gltf::Drawdata::hidden_drawcall; })
+			| std::views::transform([&drawdata](uint32_t idx) -> const gltf::PrimitiveDrawcall& {
+				  return drawdata.primitive_drawcalls[idx];
+			  });
 
 		/* Process Non-rigged Drawcalls */
 
@@ -52,13 +61,37 @@ namespace render::drawdata
 			return glm::vec3(homo) / homo.w;
 		};
 
+		// Level of detail from the size of the bounds on screen, full detail if they cross the near plane
+		const auto select_lod = [&](const gltf::PrimitiveDrawcall& drawcall, const auto& corners) {
+			if (!std::ranges::all_of(corners, point_in_range)) return drawcall.primitive.lods.front();
+
+			glm::vec2 ndc_min(std::numeric_limits<float>::max());
+			glm::vec2 ndc_max(std::numeric_limits<float>::lowest());
+			for (const auto& corner : corners)
+			{
+				const auto ndc = glm::vec2(clip_to_world(corner));
+				ndc_min = glm::min(ndc_min, ndc);
+				ndc_max = glm::max(ndc_max, ndc);
+			}
+
+			const auto projected_extent = (ndc_max - ndc_min) * 0.5f;
+			const auto projected_size = std::max(projected_extent.x, projected_extent.y);
+			return gltf::select_lod(drawcall.primitive.lods, projected_size, lod_max_error);
+		};
+
+		drawcalls.reserve(drawcalls.size() + drawdata.primitive_drawcalls.size());
+
+		std::pmr::vector<std::pair<uint32_t, uint32_t>> cluster_ranges(drawcalls.get_allocator());
+
 		for (const auto& drawcall : visible_nonrigged_drawcalls)
 		{
 			const auto& pipeline_mode = drawdata.material_cache[drawcall.material_index].params.pipeline;
-			auto& target = drawcalls[std::pair(pipeline_mode, drawcall.is_rigged())];
+
+			const auto corners =
+				graphics::get_corner_points(drawcall.world_position_min, drawcall.world_position_max);
 
 			const auto [local_min_z, local_max_z] = std::ranges::minmax(
-				graphics::get_corner_points(drawcall.world_position_min, drawcall.world_position_max)
+				corners
 					| std::views::filter(point_in_range)
 					| std::views::transform(clip_to_world),
 				{},
@@ -66,21 +99,57 @@ namespace render::drawdata
 			);
 			min_z = std::min(local_min_z.z, min_z);
 
-			if (target.empty()) target.reserve(1024);
-			target.emplace_back(
-				Drawcall{
-					.drawcall = drawcall,
-					.resource_set_index = current_resource_set_idx,
-					.max_z = local_max_z.z
-				}
+			const Drawcall sorted_drawcall{
+				.sort_key = make_sort_key(
+					pipeline_mode,
+					drawcall.get_vertex_format(),
+					drawcall.material_index,
+					-local_max_z.z
+				),
+				.drawcall = drawcall,
+				.resource_set_index = current_resource_set_idx
+			};
+
+			const auto emit = [this, &sorted_drawcall](const gltf::PrimitiveLod& range) {
+				drawcalls.emplace_back(sorted_drawcall).drawcall.primitive.lod = range;
+			};
+
+			// Meshlets only cover the full detail level, which starts the index buffer
+			const auto lod = select_lod(drawcall, corners);
+			if (lod.first_index != 0 || drawcall.primitive.meshlets.empty() || drawcall.is_rigged())
+			{
+				emit(lod);
+				continue;
+			}
+
+			/* Cluster Culling */
+
+			cluster_ranges.clear();
+			gltf::cull_meshlets(
+				drawcall.primitive.meshlets,
+				drawcall.get_world_transform(),
+				frustum_planes,
+				eye_position,
+				!pipeline_mode.double_sided,
+				cluster_ranges
 			);
+
+			// Too fragmented, one range over all visible meshlets is cheaper than many drawcalls
+			if (cluster_ranges.size() > max_cluster_ranges)
+			{
+				const auto end = cluster_ranges.back().first + cluster_ranges.back().second;
+				cluster_ranges.front().second = end - cluster_ranges.front().first;
+				cluster_ranges.resize(1);
+			}
+
+			for (const auto [first_index, index_count] : cluster_ranges)
+				emit({.first_index = first_index, .index_count = index_count, .error = 0.0f});
 		}
 	}
 
 	void Gbuffer::sort() noexcept
 	{
-		for (auto& drawcalls_vec : drawcalls | std::views::values)
-			std::ranges::sort(drawcalls_vec, std::greater{}, &Drawcall::max_z);
+		radix_sort(drawcalls);
 	}
 
 	float Gbuffer::get_min_z() const noexcept
@@ -18,8 +18,10 @@ namespace render::drawdata
 		const glm::mat4& camera_matrix,
 		const glm::vec3& light_direction,
 		float min_z,
-		float linear_blend_ratio
-	) noexcept
+		float linear_blend_ratio,
+		std::pmr::memory_resource* resource
+	) noexcept :
+		csm_levels{ShadowLevelData(resource), ShadowLevelData(resource), ShadowLevelData(resource)}
 	{
 		const auto camera_mat_inv = glm::inverse(camera_matrix);
 
@@ -70,7 +72,7 @@ namespace render::drawdata
 		}
 	}
 
-	void Shadow::ShadowLevelData::append(const gltf::Drawdata& drawdata) noexcept
+	void Shadow::ShadowLevelData::append(const gltf::Drawdata& drawdata, float lod_max_error) noexcept
 	{
 		const auto current_resource_set_idx = resource_sets.size();
 		resource_sets.emplace_back(
@@ -80,21 +82,24 @@ namespace render::drawdata
 			}
 		);
 
+		std::pmr::vector<uint32_t> visible_primitives(drawcalls.get_allocator());
+		drawdata.primitive_bvh->query(frustum_planes, visible_primitives);
+
 		auto visible_drawcalls =
-			drawdata.primitive_drawcalls | std::views::filter([this](const auto& drawcall) -> bool {
-				return graphics::box_in_frustum(
-					drawcall.world_position_min,
-					drawcall.world_position_max,
-					frustum_planes
-				);
-			});
+			visible_primitives
+			| std::views::transform([&drawdata](uint32_t idx) { return drawdata.bvh_drawcall_indices[idx]; })
+			| std::views::filter([](uint32_t idx) { return idx != gltf::Drawdata::hidden_drawcall; })
+			| std::views::transform([&drawdata](uint32_t idx) -> const gltf::PrimitiveDrawcall& {
+				  return drawdata.primitive_drawcalls[idx];
+			  });
 
 		/* Process Non-rigged Drawcalls */
 
+		drawcalls.reserve(drawcalls.size() + drawdata.primitive_drawcalls.size());
+
 		for (const auto& drawcall : visible_drawcalls)
 		{
 			const auto& pipeline_mode = drawdata.material_cache[drawcall.material_index].params.pipeline;
-			auto& target = drawcalls[std::pair(pipeline_mode, drawcall.is_rigged())];
 
 			const auto corners_world =
 				graphics::get_corner_points(drawcall.world_position_min, drawcall.world_position_max);
@@ -105,15 +110,28 @@ namespace render::drawdata
 			near = std::min(near, -max_z.z);
 			far = std::max(far, -min_z.z);
 
-			if (target.empty()) target.reserve(1024);
+			// Level of detail from the size of the bounds relative to the cascade, projection is orthographic
+			const auto [min_x, max_x] = std::ranges::minmax(corners_light_view, {}, &glm::vec3::x);
+			const auto [min_y, max_y] = std::ranges::minmax(corners_light_view, {}, &glm::vec3::y);
+			const auto projected_size = std::max(
+				(max_x.x - min_x.x) / (smallest_bound.right - smallest_bound.left),
+				(max_y.y - min_y.y) / (smallest_bound.top - smallest_bound.bottom)
+			);
 
-			target.emplace_back(
+			auto& appended = drawcalls.emplace_back(
 				Drawcall{
+					.sort_key = make_sort_key(
+						pipeline_mode,
+						drawcall.get_vertex_format(),
+						drawcall.material_index,
+						-min_z.z
+					),
 					.drawcall = drawcall,
-					.resource_set_index = current_resource_set_idx,
-					.min_z = -min_z.z
+					.resource_set_index = current_resource_set_idx
 				}
 			);
+			appended.drawcall.primitive.lod =
+				gltf::select_lod(drawcall.primitive.shadow_lods, projected_size, lod_max_error);
 		}
 	}
 
@@ -133,13 +151,30 @@ namespace render::drawdata
 
 	void Shadow::ShadowLevelData::sort() noexcept
 	{
-		for (auto& drawcall_vec : drawcalls | std::views::values)
-			std::ranges::sort(drawcall_vec, {}, &Drawcall::min_z);
+		radix_sort(drawcalls);
 	}
 
 	void Shadow::append(const gltf::Drawdata& drawdata) noexcept
 	{
-		for (auto& level : csm_levels) level.append(drawdata);
+		for (auto& level : csm_levels) level.append(drawdata, lod_max_error);
+	}
+
+	std::array<std::future<void>, Shadow::level_count> Shadow::append_sort_async(
+		std::span<const gltf::Drawdata> drawdata_list,
+		dp::thread_pool<>& pool
+	) noexcept
+	{
+		std::array<std::future<void>, level_count> level_futures;
+
+		for (const auto [future, level] : std::views::zip(level_futures, csm_levels))
+		{
+			future = pool.enqueue([drawdata_list, &level, lod_max_error = lod_max_error] {
+				for (const auto& drawdata : drawdata_list) level.append(drawdata, lod_max_error);
+				level.sort();
+			});
+		}
+
+		return level_futures;
 	}
 
 	void Shadow::sort() noexcept
@@ -0,0 +1,47 @@
+#include "render/drawdata/sort-key.hpp"
+
+#include <bit>
+
+namespace render::drawdata
+{
+	static constexpr uint64_t material_mask = (1ull << 27) - 1;
+
+	// Map a float to an unsigned integer with the same ordering
+	static uint32_t ordered_bits(float value) noexcept
+	{
+		const auto bits = std::bit_cast<uint32_t>(value);
+		return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+	}
+
+	uint64_t make_sort_key(
+		gltf::PipelineMode pipeline_mode,
+		gltf::VertexFormat vertex_format,
+		std::optional<uint32_t> material_index,
+		float depth
+	) noexcept
+	{
+		const uint64_t pipeline = static_cast<uint64_t>(pipeline_mode.alpha_mode) << 3
+			| static_cast<uint64_t>(pipeline_mode.double_sided) << 2
+			| static_cast<uint64_t>(vertex_format);
+		const uint64_t material = std::min<uint64_t>(material_index.value_or(material_mask), material_mask);
+		const uint64_t depth_bits = ordered_bits(depth);
+
+		if (pipeline_mode.alpha_mode == gltf::AlphaMode::Blend)
+			return pipeline << 59 | depth_bits << 27 | material;
+
+		return pipeline << 59 | material << 32 | depth_bits;
+	}
+
+	std::pair<gltf::PipelineMode, gltf::VertexFormat> sort_key_pipeline(uint64_t sort_key) noexcept
+	{
+		const auto pipeline = sort_key >> 59;
+
+		return {
+			gltf::PipelineMode{
+				.alpha_mode = static_cast<gltf::AlphaMode>(pipeline >> 3),
+				.double_sided = (pipeline & 0b100) != 0
+			},
+			static_cast<gltf::VertexFormat>(pipeline & 0b11)
+		};
+	}
+}
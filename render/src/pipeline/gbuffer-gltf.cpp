@@ -1,5 +1,6 @@
 #include "render/pipeline/gbuffer-gltf.hpp"
 #include "asset/shader/gbuffer-mask.frag.hpp"
+#include "asset/shader/gbuffer-quantized.vert.hpp"
 #include "asset/shader/gbuffer-skin.vert.hpp"
 #include "asset/shader/gbuffer.frag.hpp"
 #include "asset/shader/gbuffer.vert.hpp"
@@ -29,7 +30,7 @@ namespace render::pipeline
 			 .offset = offsetof(gltf::Vertex, normal)  },
 			{.location = 2,
 			 .buffer_slot = 0,
-			 .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4,
 			 .offset = offsetof(gltf::Vertex, tangent) },
 			{.location = 3,
 			 .buffer_slot = 0,
@@ -37,6 +38,21 @@ namespace render::pipeline
 			 .offset = offsetof(gltf::Vertex, texcoord)},
 		});
 
+		const auto vertex_quantized_attributes = std::to_array<SDL_GPUVertexAttribute>({
+			{.location = 0,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM,
+			 .offset = offsetof(gltf::QuantizedVertex, position)      },
+			{.location = 1,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM,
+			 .offset = offsetof(gltf::QuantizedVertex, normal_tangent)},
+			{.location = 2,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2,
+			 .offset = offsetof(gltf::QuantizedVertex, texcoord)      },
+		});
+
 		const auto vertex_rigged_attributes = std::to_array<SDL_GPUVertexAttribute>({
 			{.location = 0,
 			 .buffer_slot = 0,
@@ -48,7 +64,7 @@ namespace render::pipeline
 			 .offset = offsetof(gltf::RiggedVertex, normal)       },
 			{.location = 2,
 			 .buffer_slot = 0,
-			 .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4,
 			 .offset = offsetof(gltf::RiggedVertex, tangent)      },
 			{.location = 3,
 			 .buffer_slot = 0,
@@ -78,6 +94,13 @@ namespace render::pipeline
 			 .instance_step_rate = 0},
 		});
 
+		const auto vertex_buffer_quantized_descs = std::to_array<SDL_GPUVertexBufferDescription>({
+			{.slot = 0,
+			 .pitch = sizeof(gltf::QuantizedVertex),
+			 .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
+			 .instance_step_rate = 0},
+		});
+
 		const SDL_GPUColorTargetBlendState albedo_color_blend_state = {
 			.src_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
 			.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ZERO,
@@ -219,6 +242,21 @@ namespace render::pipeline
 		);
 	}
 
+	static std::expected<gpu::GraphicsShader, util::Error> create_vertex_quantized_shader(
+		SDL_GPUDevice* device
+	) noexcept
+	{
+		return gpu::GraphicsShader::create(
+			device,
+			shader_asset::gbuffer_quantized_vert,
+			gpu::GraphicsShader::Stage::Vertex,
+			0,
+			0,
+			0,
+			2
+		);
+	}
+
 	static std::expected<gpu::GraphicsShader, util::Error> create_fragment_shader(
 		SDL_GPUDevice* device
 	) noexcept
@@ -253,10 +291,11 @@ namespace render::pipeline
 		SDL_GPUDevice* device,
 		const gpu::GraphicsShader& vertex,
 		const gpu::GraphicsShader& vertex_rigged,
+		const gpu::GraphicsShader& vertex_quantized,
 		const gpu::GraphicsShader& fragment,
 		const gpu::GraphicsShader& fragment_mask,
 		gltf::PipelineMode mode,
-		bool rigged
+		gltf::VertexFormat vertex_format
 	) noexcept
 	{
 		SDL_GPURasterizerState rasterizer_state;
@@ -272,7 +311,25 @@ namespace render::pipeline
 		const gpu::GraphicsShader& fragment_shader =
 			(mode.alpha_mode == gltf::AlphaMode::Opaque) ? fragment : fragment_mask;
 
-		const gpu::GraphicsShader& vertex_shader = rigged ? vertex_rigged : vertex;
+		// Vertex format -> (vertex attributes, vertex buffer descriptions, vertex shader)
+		const std::map<
+			gltf::VertexFormat,
+			std::tuple<
+				std::span<const SDL_GPUVertexAttribute>,
+				std::span<const SDL_GPUVertexBufferDescription>,
+				std::reference_wrapper<const gpu::GraphicsShader>
+			>
+		>
+			vertex_format_map = {
+				{gltf::VertexFormat::Standard,  {vertex_attributes, vertex_buffer_descs, vertex}},
+				{gltf::VertexFormat::Rigged,
+				 {vertex_rigged_attributes, vertex_buffer_rigged_descs, vertex_rigged}},
+				{gltf::VertexFormat::Quantized,
+				 {vertex_quantized_attributes, vertex_buffer_quantized_descs, vertex_quantized}},
+			};
+
+		const auto& [used_vertex_attributes, used_vertex_buffer_descs, vertex_shader] =
+			vertex_format_map.at(vertex_format);
 
 		return gpu::GraphicsPipeline::create(
 			device,
@@ -281,12 +338,15 @@ namespace render::pipeline
 			SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
 			SDL_GPU_SAMPLECOUNT_1,
 			rasterizer_state,
-			rigged ? std::span<const SDL_GPUVertexAttribute>(vertex_rigged_attributes)
-				   : std::span<const SDL_GPUVertexAttribute>(vertex_attributes),
-			rigged ? vertex_buffer_rigged_descs : vertex_buffer_descs,
+			used_vertex_attributes,
+			used_vertex_buffer_descs,
 			color_target_descs,
 			get_depth_stencil_state(mode.double_sided),
-			std::format("Gbuffer Gltf Pipeline (mode: {}, rigged: {})", mode.to_string(), rigged)
+			std::format(
+				"Gbuffer Gltf Pipeline (mode: {}, vertex format: {})",
+				mode.to_string(),
+				static_cast<int>(vertex_format)
+			)
 		);
 	}
 
@@ -299,6 +359,10 @@ namespace render::pipeline
 		if (!vertex_rigged_shader)
 			return vertex_rigged_shader.error().forward("Create vertex rigged shader failed");
 
+		auto vertex_quantized_shader = create_vertex_quantized_shader(device);
+		if (!vertex_quantized_shader)
+			return vertex_quantized_shader.error().forward("Create vertex quantized shader failed");
+
 		auto fragment_shader = create_fragment_shader(device);
 		if (!fragment_shader) return fragment_shader.error().forward("Create fragment shader failed");
 
@@ -306,12 +370,17 @@ namespace render::pipeline
 		if (!fragment_mask_shader)
 			return fragment_mask_shader.error().forward("Create fragment mask shader failed");
 
-		std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipeline_result;
+		std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>>
+			pipeline_result;
 
-		for (const auto [alpha_mode, double_sided, rigged] : std::views::cartesian_product(
+		for (const auto [alpha_mode, double_sided, vertex_format] : std::views::cartesian_product(
 				 std::array{gltf::AlphaMode::Opaque, gltf::AlphaMode::Mask, gltf::AlphaMode::Blend},
 				 std::array{false, true},
-				 std::array{false, true}
+				 std::array{
+					 gltf::VertexFormat::Standard,
+					 gltf::VertexFormat::Rigged,
+					 gltf::VertexFormat::Quantized
+				 }
 			 ))
 		{
 			const auto pipeline_cfg =
@@ -321,32 +390,39 @@ namespace render::pipeline
 				device,
 				*vertex_shader,
 				*vertex_rigged_shader,
+				*vertex_quantized_shader,
 				*fragment_shader,
 				*fragment_mask_shader,
 				pipeline_cfg,
-				rigged
+				vertex_format
 			);
 
 			if (!pipeline)
 				return pipeline.error().forward(
 					std::format(
-						"Create graphics pipeline failed (alpha_mode: {}, double_sided: {}, rigged: {})",
+						"Create graphics pipeline failed (alpha_mode: {}, double_sided: {}, format: {})",
 						static_cast<int>(alpha_mode),
 						double_sided,
-						rigged
+						static_cast<int>(vertex_format)
 					)
 				);
 
-			if (rigged)
-				pipeline_result.emplace(
-					std::pair(pipeline_cfg, rigged),
-					std::make_unique<PipelineRigged>(pipeline_cfg, std::move(*pipeline))
-				);
-			else
-				pipeline_result.emplace(
-					std::pair(pipeline_cfg, rigged),
-					std::make_unique<PipelineNormal>(pipeline_cfg, std::move(*pipeline))
-				);
+			std::unique_ptr<PipelineGLTF> pipeline_instance;
+			switch (vertex_format)
+			{
+			case gltf::VertexFormat::Standard:
+				pipeline_instance = std::make_unique<PipelineNormal>(pipeline_cfg, std::move(*pipeline));
+				break;
+			case gltf::VertexFormat::Rigged:
+				pipeline_instance = std::make_unique<PipelineRigged>(pipeline_cfg, std::move(*pipeline));
+				break;
+			case gltf::VertexFormat::Quantized:
+				pipeline_instance =
+					std::make_unique<PipelineQuantized>(pipeline_cfg, std::move(*pipeline));
+				break;
+			}
+
+			pipeline_result.emplace(std::pair(pipeline_cfg, vertex_format), std::move(pipeline_instance));
 		}
 
 		return GbufferGLTF(std::move(pipeline_result));
@@ -440,9 +516,32 @@ namespace render::pipeline
 		command_buffer.push_uniform_to_vertex(1, util::as_bytes(transform));
 
 		render_pass.bind_vertex_buffers(0, drawcall.primitive.vertex_buffer_binding);
-		render_pass
-			.bind_index_buffer(drawcall.primitive.index_buffer_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-		render_pass.draw_indexed(drawcall.primitive.index_count, 0, 1, 0, 0);
+		render_pass.bind_index_buffer(
+			drawcall.primitive.index_buffer_binding,
+			drawcall.primitive.index_element_size
+		);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
+	}
+
+	void GbufferGLTF::PipelineQuantized::draw(
+		const gpu::CommandBuffer& command_buffer,
+		const gpu::RenderPass& render_pass,
+		const gltf::PrimitiveDrawcall& drawcall
+	) const noexcept
+	{
+		const auto per_object_param = PerObjectParam::from(drawcall);
+		command_buffer.push_uniform_to_fragment(1, util::as_bytes(per_object_param));
+		const auto model_param = QuantizedModelParam::from(drawcall);
+		command_buffer.push_uniform_to_vertex(1, util::as_bytes(model_param));
+
+		render_pass.bind_vertex_buffers(0, drawcall.primitive.vertex_buffer_binding);
+		render_pass.bind_index_buffer(
+			drawcall.primitive.index_buffer_binding,
+			drawcall.primitive.index_element_size
+		);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
 	}
 
 	void GbufferGLTF::PipelineRigged::draw(
@@ -456,9 +555,12 @@ namespace render::pipeline
 		command_buffer.push_uniform_to_vertex(1, util::as_bytes(drawcall.get_joint_matrix_offset()));
 
 		render_pass.bind_vertex_buffers(0, drawcall.primitive.vertex_buffer_binding);
-		render_pass
-			.bind_index_buffer(drawcall.primitive.index_buffer_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-		render_pass.draw_indexed(drawcall.primitive.index_count, 0, 1, 0, 0);
+		render_pass.bind_index_buffer(
+			drawcall.primitive.index_buffer_binding,
+			drawcall.primitive.index_element_size
+		);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
 	}
 
 	void GbufferGLTF::render(
@@ -467,25 +569,39 @@ namespace render::pipeline
 		const drawdata::Gbuffer& drawdata
 	) const noexcept
 	{
+		const auto same_pipeline = [](const auto& a, const auto& b) {
+			return drawdata::sort_key_pipeline(a.sort_key) == drawdata::sort_key_pipeline(b.sort_key);
+		};
+
 		command_buffer.push_debug_group("Gbuffer Pass");
-		for (const auto& [pipeline_cfg, drawcalls] : drawdata.drawcalls)
+		for (const auto& drawcalls : drawdata.drawcalls | std::views::chunk_by(same_pipeline))
 		{
+			const auto pipeline_cfg = drawdata::sort_key_pipeline(drawcalls.front().sort_key);
 			const auto& draw_pipeline = pipelines.at(pipeline_cfg);
 
 			draw_pipeline->bind(command_buffer, gbuffer_pass, drawdata.camera_matrix);
 
-			for (const auto& [drawcall, set_idx, _] : drawcalls)
+			// Drawcalls are grouped by material, only rebind when it changes
+			std::optional<std::pair<size_t, std::optional<uint32_t>>> bound_material;
+
+			for (const auto& [_, drawcall, set_idx] : drawcalls)
 			{
 				const auto& resource_set = drawdata.resource_sets[set_idx];
 
-				draw_pipeline->set_material(
-					command_buffer,
-					gbuffer_pass,
-					resource_set.material_cache[drawcall.material_index]
-				);
+				if (const auto material = std::pair(set_idx, drawcall.material_index);
+					material != bound_material)
+				{
+					draw_pipeline->set_material(
+						command_buffer,
+						gbuffer_pass,
+						resource_set.material_cache[drawcall.material_index]
+					);
 
-				if (resource_set.deferred_skinning_resource != nullptr)
-					draw_pipeline->set_skin(gbuffer_pass, *resource_set.deferred_skinning_resource);
+					if (resource_set.deferred_skinning_resource != nullptr)
+						draw_pipeline->set_skin(gbuffer_pass, *resource_set.deferred_skinning_resource);
+
+					bound_material = material;
+				}
 
 				draw_pipeline->draw(command_buffer, gbuffer_pass, drawcall);
 			}
@@ -499,4 +615,15 @@ namespace render::pipeline
 	{
 		return PerObjectParam{.emissive_multiplier = drawcall.emissive_multiplier};
 	}
+
+	GbufferGLTF::QuantizedModelParam GbufferGLTF::QuantizedModelParam::from(
+		const gltf::PrimitiveDrawcall& drawcall
+	) noexcept
+	{
+		return QuantizedModelParam{
+			.model = drawcall.get_world_transform(),
+			.position_offset = glm::vec4(drawcall.primitive.position_offset, 0.0f),
+			.position_scale = glm::vec4(drawcall.primitive.position_scale, 0.0f)
+		};
+	}
 }
\ No newline at end of file
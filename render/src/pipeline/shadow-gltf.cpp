@@ -16,6 +16,7 @@
 #include "util/as-byte.hpp"
 
 #include <SDL3/SDL_gpu.h>
+#include <glm/gtc/matrix_transform.hpp>
 #include <ranges>
 #include <span>
 
@@ -41,6 +42,24 @@ namespace render::pipeline
 			 .offset = offsetof(gltf::ShadowVertex, texcoord)},
 		});
 
+		const auto quantized_vertex_attributes = std::to_array<SDL_GPUVertexAttribute>({
+			{.location = 0,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM,
+			 .offset = offsetof(gltf::QuantizedShadowVertex, position)},
+		});
+
+		const auto masked_quantized_vertex_attributes = std::to_array<SDL_GPUVertexAttribute>({
+			{.location = 0,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM,
+			 .offset = offsetof(gltf::QuantizedShadowVertex, position)},
+			{.location = 1,
+			 .buffer_slot = 0,
+			 .format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2,
+			 .offset = offsetof(gltf::QuantizedShadowVertex, texcoord)},
+		});
+
 		const auto rigged_vertex_attributes = std::to_array<SDL_GPUVertexAttribute>({
 			{.location = 0,
 			 .buffer_slot = 0,
@@ -89,6 +108,13 @@ namespace render::pipeline
 			 .instance_step_rate = 0},
 		});
 
+		const auto vertex_buffer_quantized_descs = std::to_array<SDL_GPUVertexBufferDescription>({
+			{.slot = 0,
+			 .pitch = sizeof(gltf::QuantizedShadowVertex),
+			 .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
+			 .instance_step_rate = 0},
+		});
+
 		const auto depth_stencil_state = gpu::GraphicsPipeline::DepthStencilState{
 			.format = target::Shadow::depth_format.format,
 			.compare_op = SDL_GPU_COMPAREOP_GREATER,
@@ -197,7 +223,7 @@ namespace render::pipeline
 			SDL_GPUDevice* device,
 			const Shaders& shaders,
 			gltf::PipelineMode mode,
-			bool rigged
+			gltf::VertexFormat vertex_format
 		) noexcept
 		{
 			SDL_GPURasterizerState rasterizer_state;
@@ -212,24 +238,39 @@ namespace render::pipeline
 
 			const bool masked = (mode.alpha_mode != gltf::AlphaMode::Opaque);
 
-			// (rigged, masked) -> (vertex attributes, vertex shader)
+			// (vertex format, masked) -> (vertex attributes, vertex shader)
+			// Quantized positions are dequantized by the model matrix, so they share the standard shaders
 			const std::map<
-				std::tuple<bool, bool>,
+				std::tuple<gltf::VertexFormat, bool>,
 				std::tuple<
 					std::span<const SDL_GPUVertexAttribute>,
 					std::reference_wrapper<const gpu::GraphicsShader>
 				>
 			>
 				vertex_attribute_map = {
-					{{false, false}, {vertex_attributes, shaders.vertex}                          },
-					{{false, true},  {masked_vertex_attributes, shaders.vertex_mask}              },
-					{{true, false},  {rigged_vertex_attributes, shaders.vertex_rigged}            },
-					{{true, true},   {masked_rigged_vertex_attributes, shaders.vertex_rigged_mask}},
+					{{gltf::VertexFormat::Standard, false},  {vertex_attributes, shaders.vertex}},
+					{{gltf::VertexFormat::Standard, true},   {masked_vertex_attributes, shaders.vertex_mask}},
+					{{gltf::VertexFormat::Rigged, false},
+					 {rigged_vertex_attributes, shaders.vertex_rigged}},
+					{{gltf::VertexFormat::Rigged, true},
+					 {masked_rigged_vertex_attributes, shaders.vertex_rigged_mask}},
+					{{gltf::VertexFormat::Quantized, false}, {quantized_vertex_attributes, shaders.vertex}},
+					{{gltf::VertexFormat::Quantized, true},
+					 {masked_quantized_vertex_attributes, shaders.vertex_mask}},
+            };
+
+			// Vertex format -> vertex buffer descriptions
+			const std::map<gltf::VertexFormat, std::span<const SDL_GPUVertexBufferDescription>>
+				vertex_buffer_desc_map = {
+					{gltf::VertexFormat::Standard,  vertex_buffer_descs          },
+					{gltf::VertexFormat::Rigged,    vertex_buffer_rigged_descs   },
+					{gltf::VertexFormat::Quantized, vertex_buffer_quantized_descs},
             };
 
 			const auto& fragment_shader = masked ? shaders.fragment_mask : shaders.fragment;
-			const auto& [used_vertex_attributes, vertex_shader] = vertex_attribute_map.at({rigged, masked});
-			const auto& used_vertex_buffer_descs = rigged ? vertex_buffer_rigged_descs : vertex_buffer_descs;
+			const auto& [used_vertex_attributes, vertex_shader] =
+				vertex_attribute_map.at({vertex_format, masked});
+			const auto& used_vertex_buffer_descs = vertex_buffer_desc_map.at(vertex_format);
 
 			return gpu::GraphicsPipeline::create(
 				device,
@@ -242,7 +283,11 @@ namespace render::pipeline
 				used_vertex_buffer_descs,
 				{},
 				depth_stencil_state,
-				std::format("Shadow Gltf Pipeline (mode: {}, rigged: {})", mode.to_string(), rigged)
+				std::format(
+					"Shadow Gltf Pipeline (mode: {}, vertex format: {})",
+					mode.to_string(),
+					static_cast<int>(vertex_format)
+				)
 			);
 		}
 	}
@@ -252,39 +297,50 @@ namespace render::pipeline
 		auto shaders = Shaders::create(device);
 		if (!shaders) return shaders.error().forward("Create Shadow shaders failed");
 
-		std::map<std::pair<gltf::PipelineMode, bool>, std::unique_ptr<PipelineGLTF>> pipeline_result;
+		std::map<std::pair<gltf::PipelineMode, gltf::VertexFormat>, std::unique_ptr<PipelineGLTF>>
+			pipeline_result;
 
-		for (const auto [alpha_mode, double_sided, rigged] : std::views::cartesian_product(
+		for (const auto [alpha_mode, double_sided, vertex_format] : std::views::cartesian_product(
 				 std::array{gltf::AlphaMode::Opaque, gltf::AlphaMode::Mask, gltf::AlphaMode::Blend},
 				 std::array{false, true},
-				 std::array{false, true}
+				 std::array{
+					 gltf::VertexFormat::Standard,
+					 gltf::VertexFormat::Rigged,
+					 gltf::VertexFormat::Quantized
+				 }
 			 ))
 		{
 			const auto pipeline_cfg =
 				gltf::PipelineMode{.alpha_mode = alpha_mode, .double_sided = double_sided};
 
-			auto pipeline = create_pipeline(device, *shaders, pipeline_cfg, rigged);
+			auto pipeline = create_pipeline(device, *shaders, pipeline_cfg, vertex_format);
 
 			if (!pipeline)
 				return pipeline.error().forward(
 					std::format(
-						"Create graphics pipeline failed (alpha_mode: {}, double_sided: {}, rigged: {})",
+						"Create graphics pipeline failed (alpha_mode: {}, double_sided: {}, format: {})",
 						static_cast<int>(alpha_mode),
 						double_sided,
-						rigged
+						static_cast<int>(vertex_format)
 					)
 				);
 
-			if (rigged)
-				pipeline_result.emplace(
-					std::pair(pipeline_cfg, rigged),
-					std::make_unique<PipelineRigged>(pipeline_cfg, std::move(*pipeline))
-				);
-			else
-				pipeline_result.emplace(
-					std::pair(pipeline_cfg, rigged),
-					std::make_unique<PipelineNormal>(pipeline_cfg, std::move(*pipeline))
-				);
+			std::unique_ptr<PipelineGLTF> pipeline_instance;
+			switch (vertex_format)
+			{
+			case gltf::VertexFormat::Standard:
+				pipeline_instance = std::make_unique<PipelineNormal>(pipeline_cfg, std::move(*pipeline));
+				break;
+			case gltf::VertexFormat::Rigged:
+				pipeline_instance = std::make_unique<PipelineRigged>(pipeline_cfg, std::move(*pipeline));
+				break;
+			case gltf::VertexFormat::Quantized:
+				pipeline_instance =
+					std::make_unique<PipelineQuantized>(pipeline_cfg, std::move(*pipeline));
+				break;
+			}
+
+			pipeline_result.emplace(std::pair(pipeline_cfg, vertex_format), std::move(pipeline_instance));
 		}
 
 		return ShadowGLTF(std::move(pipeline_result));
@@ -376,9 +432,30 @@ namespace render::pipeline
 		render_pass.bind_vertex_buffers(0, drawcall.primitive.shadow_vertex_buffer_binding);
 		render_pass.bind_index_buffer(
 			drawcall.primitive.shadow_index_buffer_binding,
-			SDL_GPU_INDEXELEMENTSIZE_32BIT
+			drawcall.primitive.shadow_index_element_size
 		);
-		render_pass.draw_indexed(drawcall.primitive.index_count, 0, 1, 0, 0);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
+	}
+
+	void ShadowGLTF::PipelineQuantized::draw(
+		const gpu::CommandBuffer& command_buffer,
+		const gpu::RenderPass& render_pass,
+		const gltf::PrimitiveDrawcall& drawcall
+	) const noexcept
+	{
+		const auto world_transform = drawcall.get_world_transform()
+			* glm::translate(glm::mat4(1.0f), drawcall.primitive.position_offset)
+			* glm::scale(glm::mat4(1.0f), drawcall.primitive.position_scale);
+
+		command_buffer.push_uniform_to_vertex(1, util::as_bytes(world_transform));
+		render_pass.bind_vertex_buffers(0, drawcall.primitive.shadow_vertex_buffer_binding);
+		render_pass.bind_index_buffer(
+			drawcall.primitive.shadow_index_buffer_binding,
+			drawcall.primitive.shadow_index_element_size
+		);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
 	}
 
 	void ShadowGLTF::PipelineRigged::draw(
@@ -392,9 +469,10 @@ namespace render::pipeline
 		render_pass.bind_vertex_buffers(0, drawcall.primitive.shadow_vertex_buffer_binding);
 		render_pass.bind_index_buffer(
 			drawcall.primitive.shadow_index_buffer_binding,
-			SDL_GPU_INDEXELEMENTSIZE_32BIT
+			drawcall.primitive.shadow_index_element_size
 		);
-		render_pass.draw_indexed(drawcall.primitive.index_count, 0, 1, 0, 0);
+		const auto& lod = drawcall.primitive.lod;
+		render_pass.draw_indexed(lod.index_count, lod.first_index, 1, 0, 0);
 	}
 
 	std::expected<void, util::Error> ShadowGLTF::render(
@@ -403,6 +481,10 @@ namespace render::pipeline
 		const drawdata::Shadow& drawdata
 	) const noexcept
 	{
+		const auto same_pipeline = [](const auto& a, const auto& b) {
+			return drawdata::sort_key_pipeline(a.sort_key) == drawdata::sort_key_pipeline(b.sort_key);
+		};
+
 		command_buffer.push_debug_group("Shadow Pass");
 		for (const auto [level, level_data] : drawdata.csm_levels | std::views::enumerate)
 		{
@@ -411,24 +493,34 @@ namespace render::pipeline
 				return shadow_pass_result.error().forward("Acquire shadow render pass failed");
 			auto shadow_pass = std::move(*shadow_pass_result);
 
-			for (const auto& [pipeline_cfg, drawcalls] : level_data.drawcalls)
+			for (const auto& drawcalls : level_data.drawcalls | std::views::chunk_by(same_pipeline))
 			{
-				const auto& draw_pipeline = pipelines.at(pipeline_cfg);
+				const auto pipeline_cfg = drawdata::sort_key_pipeline(drawcalls.front().sort_key);
+			const auto& draw_pipeline = pipelines.at(pipeline_cfg);
 
 				draw_pipeline->bind(command_buffer, shadow_pass, level_data.get_vp_matrix());
 
-				for (const auto& [drawcall, set_idx, _] : drawcalls)
+				// Drawcalls are grouped by material, only rebind when it changes
+				std::optional<std::pair<size_t, std::optional<uint32_t>>> bound_material;
+
+				for (const auto& [_, drawcall, set_idx] : drawcalls)
 				{
 					const auto& resource_set = level_data.resource_sets[set_idx];
 
-					draw_pipeline->set_material(
-						command_buffer,
-						shadow_pass,
-						resource_set.material_cache[drawcall.material_index]
-					);
+					if (const auto material = std::pair(set_idx, drawcall.material_index);
+						material != bound_material)
+					{
+						draw_pipeline->set_material(
+							command_buffer,
+							shadow_pass,
+							resource_set.material_cache[drawcall.material_index]
+						);
+
+						if (resource_set.deferred_skinning_resource != nullptr)
+							draw_pipeline->set_skin(shadow_pass, *resource_set.deferred_skinning_resource);
 
-					if (resource_set.deferred_skinning_resource != nullptr)
-						draw_pipeline->set_skin(shadow_pass, *resource_set.deferred_skinning_resource);
+						bound_material = material;
+					}
 
 					draw_pipeline->draw(command_buffer, shadow_pass, drawcall);
 				}
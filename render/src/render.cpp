@@ -12,10 +12,20 @@
 #include "render/pipeline/tonemapping.hpp"
 #include "util/error.hpp"
 
+#include <array>
+#include <future>
 #include <ranges>
+#include <thread_pool/thread_pool.h>
 
 namespace render
 {
+	// Persistent pool for drawdata jobs, one thread per CSM level
+	static dp::thread_pool<>& get_drawdata_pool() noexcept
+	{
+		static dp::thread_pool pool(drawdata::Shadow::level_count);
+		return pool;
+	}
+
 	std::expected<Renderer, util::Error> Renderer::create(const backend::SDLcontext& sdl_context) noexcept
 	{
 		auto pipeline = Pipeline::create(sdl_context);
@@ -34,7 +44,8 @@ namespace render
 
 	std::expected<std::tuple<drawdata::Gbuffer, drawdata::Shadow>, util::Error> Renderer::prepare_drawdata(
 		std::span<const gltf::Drawdata> drawdata_list,
-		const Params& params
+		const Params& params,
+		std::pmr::memory_resource* frame_resource
 	) noexcept
 	{
 		auto deferred_resources = drawdata_list
@@ -43,19 +54,23 @@ namespace render
 
 		const auto camera_matrix = params.camera.proj_matrix * params.camera.view_matrix;
 
-		drawdata::Gbuffer gbuffer_drawdata(camera_matrix, params.camera.eye_position);
+		drawdata::Gbuffer gbuffer_drawdata(camera_matrix, params.camera.eye_position, frame_resource);
 		for (const auto& drawdata : drawdata_list) gbuffer_drawdata.append(drawdata);
 
 		drawdata::Shadow shadow_drawdata(
 			camera_matrix,
 			params.primary_light.direction,
 			gbuffer_drawdata.get_min_z(),
-			params.shadow.csm_linear_blend
+			params.shadow.csm_linear_blend,
+			frame_resource
 		);
-		for (const auto& drawdata : drawdata_list) shadow_drawdata.append(drawdata);
+
+		// CSM levels are independent, each one is culled and sorted by its own job while the G-buffer list is
+		// sorted here
+		auto level_futures = shadow_drawdata.append_sort_async(drawdata_list, get_drawdata_pool());
 
 		gbuffer_drawdata.sort();
-		shadow_drawdata.sort();
+		for (auto& future : level_futures) future.wait();
 
 		transfer_buffer_pool.cycle();
 		buffer_pool.cycle();
@@ -357,7 +372,7 @@ namespace render
 	{
 		/* Preparation */
 
-		auto prepare_result = prepare_drawdata(drawdata.models, params);
+		auto prepare_result = prepare_drawdata(drawdata.models, params, drawdata.frame_resource);
 		if (!prepare_result) return prepare_result.error().forward("Prepare drawdata failed");
 		const auto [gbuffer_drawdata, shadow_drawdata] = std::move(*prepare_result);
 
@@ -2,7 +2,7 @@ target("render")
 	set_kind("static")
     set_languages("c++23")
 
-    add_packages("libsdl3", "glm", "imgui")
+    add_packages("libsdl3", "glm", "imgui", "paul_thread_pool")
 
     add_rules("asset.shader", {debug = is_mode("debug"), includedir = "shader/common"})
     add_rules("asset.pack")
@@ -1,21 +1,75 @@
-import gzip
 import argparse
+import struct
+import zlib
+from concurrent.futures import ThreadPoolExecutor
 
+# The output is a standard multi-member gzip file, readable by any gzip tool. The first member carries an
+# extra field (subfield "CG") indexing all members, so that they can be inflated in parallel:
+#   u32 member_count, then for each member: u32 compressed_size, u32 uncompressed_size
 
-def _compress_file(path: str) -> bytes:
+_INDEX_ID = b"CG"
+_DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024
+
+
+def _deflate(chunk: bytes) -> bytes:
+    compressor = zlib.compressobj(9, zlib.DEFLATED, -zlib.MAX_WBITS)
+    return compressor.compress(chunk) + compressor.flush()
+
+
+def _member(chunk: bytes, deflated: bytes, extra: bytes = b"") -> bytes:
+    flags = 0x04 if extra else 0x00
+    header = struct.pack("<BBBBIBB", 0x1F, 0x8B, 8, flags, 0, 2, 255)
+    if extra:
+        header += struct.pack("<H", len(extra)) + extra
+    trailer = struct.pack("<II", zlib.crc32(chunk), len(chunk) & 0xFFFFFFFF)
+    return header + deflated + trailer
+
+
+def _compress_file(path: str, chunk_size: int) -> bytes:
     with open(path, "rb") as f:
         data: bytes = f.read()
-    return gzip.compress(data)
+
+    chunks = [data[i : i + chunk_size] for i in range(0, len(data), chunk_size)] or [b""]
+
+    # zlib releases the GIL, so threads compress in parallel
+    with ThreadPoolExecutor() as executor:
+        deflated_chunks = list(executor.map(_deflate, chunks))
+
+    index_size = 4 + 8 * len(chunks)
+    extra_size = 4 + index_size
+    if extra_size > 0xFFFF:
+        raise ValueError("Too many gzip members for the index, increase the chunk size")
+
+    # Member overhead: 10-byte header, 8-byte trailer, plus the extra field in the first member
+    compressed_sizes = [18 + len(deflated) for deflated in deflated_chunks]
+    compressed_sizes[0] += 2 + extra_size
+
+    index = struct.pack("<I", len(chunks))
+    for compressed_size, chunk in zip(compressed_sizes, chunks):
+        index += struct.pack("<II", compressed_size, len(chunk))
+    extra = _INDEX_ID + struct.pack("<H", index_size) + index
+
+    members = [
+        _member(chunk, deflated, extra if idx == 0 else b"")
+        for idx, (chunk, deflated) in enumerate(zip(chunks, deflated_chunks))
+    ]
+    return b"".join(members)
 
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Compress a file using gzip.")
     parser.add_argument("input", type=str, help="Path to the input file")
     parser.add_argument("output", type=str, help="Path to the output compressed file")
+    parser.add_argument(
+        "--chunk-size",
+        type=int,
+        default=_DEFAULT_CHUNK_SIZE,
+        help="Uncompressed size of each independently compressed gzip member",
+    )
     args = parser.parse_args()
     input_path = args.input
     output_path = args.output
 
-    compressed_data = _compress_file(input_path)
+    compressed_data = _compress_file(input_path, args.chunk_size)
     with open(output_path, "wb") as f:
         f.write(compressed_data)
@@ -0,0 +1,54 @@
+///
+/// @file check.hpp
+/// @brief Minimal test case registry and checks for the unit test binary
+///
+
+#pragma once
+
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+namespace test
+{
+	struct Case
+	{
+		std::string_view name;
+		void (*function)();
+	};
+
+	// All registered test cases, in registration order
+	std::vector<Case>& cases() noexcept;
+
+	// Registers a test case during static initialization, see `TEST_CASE`
+	struct Registrar
+	{
+		Registrar(std::string_view name, void (*function)()) noexcept;
+	};
+
+	///
+	/// @brief Record a failure of the running test case if `condition` is false
+	/// @note The test case keeps running, so that all failing checks get reported
+	///
+	/// @param condition Checked condition
+	/// @param expression Source text of the condition, printed on failure
+	/// @param location Location of the check, printed on failure
+	///
+	void check(
+		bool condition,
+		std::string_view expression,
+		std::source_location location = std::source_location::current()
+	) noexcept;
+
+	// Number of failed checks so far
+	size_t failure_count() noexcept;
+}
+
+// Define and register a test case, the body follows the macro
+#define TEST_CASE(name)                                                                                      \
+	static void name() noexcept;                                                                             \
+	static const test::Registrar name##_registrar(#name, name);                                              \
+	static void name() noexcept
+
+// Check a condition, see `test::check`
+#define CHECK(...) test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__)
@@ -0,0 +1,176 @@
+#include "graphics/culling.hpp"
+#include "test/check.hpp"
+
+#include <array>
+#include <glm/gtc/matrix_transform.hpp>
+#include <limits>
+#include <random>
+#include <ranges>
+
+// 90 degree square frustum at the origin, looking down -Z. Side planes are `|x| <= -z` and `|y| <= -z`.
+static std::array<glm::vec4, 6> test_frustum_planes() noexcept
+{
+	return graphics::compute_frustum_planes(glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f));
+}
+
+TEST_CASE(sphere_in_frustum_known_frustum)
+{
+	const auto planes = test_frustum_planes();
+
+	CHECK(graphics::sphere_in_frustum({0.0f, 0.0f, -10.0f}, 1.0f, planes));
+	CHECK(graphics::sphere_in_frustum({0.0f, 0.0f, -99.5f}, 1.0f, planes));
+
+	// Right plane at depth 10 is x = 10, the distance to it is (x - 10) / sqrt(2)
+	CHECK(graphics::sphere_in_frustum({10.5f, 0.0f, -10.0f}, 1.0f, planes));
+	CHECK(!graphics::sphere_in_frustum({12.0f, 0.0f, -10.0f}, 1.0f, planes));
+	CHECK(graphics::sphere_in_frustum({0.0f, -11.0f, -10.0f}, 1.0f, planes));
+	CHECK(!graphics::sphere_in_frustum({0.0f, -12.0f, -10.0f}, 1.0f, planes));
+
+	// Beyond the far plane, and behind the eye
+	CHECK(!graphics::sphere_in_frustum({0.0f, 0.0f, -102.0f}, 1.0f, planes));
+	CHECK(!graphics::sphere_in_frustum({0.0f, 0.0f, 10.0f}, 1.0f, planes));
+
+	// A subset of planes only tests those
+	CHECK(graphics::sphere_in_frustum({0.0f, 0.0f, -200.0f}, 1.0f, std::span(planes).first(4)));
+}
+
+TEST_CASE(sphere_in_frustum_local_planes)
+{
+	const auto planes = test_frustum_planes();
+
+	// Planes moved into a local space scaled by 2 are no longer normalized, radius scales with the space
+	const auto world_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(2.0f));
+	std::array<glm::vec4, 6> local_planes;
+	for (const auto [local_plane, plane] : std::views::zip(local_planes, planes))
+		local_plane = glm::transpose(world_matrix) * plane;
+
+	CHECK(graphics::sphere_in_frustum({5.25f, 0.0f, -5.0f}, 0.5f, local_planes));
+	CHECK(!graphics::sphere_in_frustum({6.0f, 0.0f, -5.0f}, 0.5f, local_planes));
+}
+
+TEST_CASE(cone_backfacing_rejection)
+{
+	// Flat patch at the origin facing +Z, the normal cone has no spread
+	const glm::vec3 apex(0.0f), axis(0.0f, 0.0f, 1.0f);
+
+	CHECK(!graphics::cone_backfacing(apex, axis, 0.0f, {0.0f, 0.0f, 5.0f}));
+	CHECK(!graphics::cone_backfacing(apex, axis, 0.0f, {3.0f, 1.0f, 0.5f}));
+	CHECK(graphics::cone_backfacing(apex, axis, 0.0f, {0.0f, 0.0f, -5.0f}));
+	CHECK(graphics::cone_backfacing(apex, axis, 0.0f, {3.0f, 1.0f, -0.5f}));
+
+	// Cutoff of cos(60deg) rejects only eyes within 60 degrees behind the patch
+	const float cutoff = 0.5f;
+	CHECK(graphics::cone_backfacing(apex, axis, cutoff, {0.5f, 0.0f, -1.0f}));
+	CHECK(!graphics::cone_backfacing(apex, axis, cutoff, {2.0f, 0.0f, -1.0f}));
+
+	// Cutoff of 1 never culls, as produced for meshlets with widely spread normals
+	CHECK(!graphics::cone_backfacing(apex, axis, 1.0f, {0.3f, 0.2f, -5.0f}));
+	CHECK(!graphics::cone_backfacing(apex, glm::vec3(0.0f), 1.0f, {0.0f, 0.0f, -5.0f}));
+}
+
+// Random boxes around the test frustum, with edge cases first: boxes touching a plane exactly, empty and
+// inverted boxes, huge boxes and NaN
+static graphics::BoxArray random_boxes(std::mt19937& rng, size_t count) noexcept
+{
+	std::uniform_real_distribution<float> position(-120.0f, 120.0f), size(0.0f, 20.0f);
+
+	const auto nan = std::numeric_limits<float>::quiet_NaN();
+	const auto huge = std::numeric_limits<float>::max();
+	const std::array<std::pair<glm::vec3, glm::vec3>, 7> edge_boxes = {{
+		{{10.0f, -1.0f, -10.0f}, {11.0f, 1.0f, -9.0f}},  // Touches the right plane at a corner
+		{{-10.0f, 0.0f, -30.0f}, {-10.0f, 0.0f, -10.0f}},
+		{{0.0f, 0.0f, -10.0f}, {0.0f, 0.0f, -10.0f}},
+		{{1.0f, 1.0f, -5.0f}, {-1.0f, -1.0f, -6.0f}},
+		{glm::vec3(-huge), glm::vec3(huge)},
+		{{nan, 0.0f, -10.0f}, {1.0f, 1.0f, -9.0f}},
+		{{0.0f, 0.0f, -100.0f}, {1.0f, 1.0f, -100.0f}},  // On the far plane
+	}};
+
+	graphics::BoxArray boxes;
+	for (const auto idx : std::views::iota(0zu, count))
+	{
+		if (idx < edge_boxes.size())
+		{
+			boxes.push_back(edge_boxes[idx].first, edge_boxes[idx].second);
+			continue;
+		}
+
+		const glm::vec3 box_min(position(rng), position(rng), position(rng) - 60.0f);
+		boxes.push_back(box_min, box_min + glm::vec3(size(rng), size(rng), size(rng)));
+	}
+
+	return boxes;
+}
+
+// Reference result of `box_in_frustum` for every box
+static bool matches_reference(
+	const graphics::BoxArray& boxes,
+	std::span<const glm::vec4> planes,
+	std::span<const uint8_t> visibility
+) noexcept
+{
+	return std::ranges::all_of(std::views::iota(0zu, boxes.size()), [&](size_t idx) {
+		return graphics::is_visible(visibility, idx)
+			== graphics::box_in_frustum(boxes.get_min(idx), boxes.get_max(idx), planes);
+	});
+}
+
+TEST_CASE(boxes_in_frustum_matches_scalar)
+{
+	std::mt19937 rng(0x5eed);
+	std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+
+	// Normalized camera planes, the side planes only as used by shadow cascades, and random unnormalized
+	// planes with zero components
+	const auto camera_planes = test_frustum_planes();
+	std::array<glm::vec4, 5> random_planes;
+	for (auto& plane : random_planes)
+		plane = {component(rng) * 4.0f, component(rng), 0.0f, component(rng) * 50.0f};
+	random_planes[1].x = -0.0f;
+
+	const std::array<std::span<const glm::vec4>, 3> plane_sets = {
+		std::span<const glm::vec4>(camera_planes),
+		std::span<const glm::vec4>(camera_planes).first(4),
+		std::span<const glm::vec4>(random_planes),
+	};
+
+	// Counts around multiples of 8, so that the scalar tail after the 8-wide blocks is covered
+	for (const auto count : {0zu, 1zu, 7zu, 8zu, 9zu, 15zu, 16zu, 17zu, 100zu, 1003zu})
+	{
+		const auto boxes = random_boxes(rng, count);
+
+		for (const auto& planes : plane_sets)
+		{
+			// Padding bytes past the mask must be left alone, and tail bits past the last box cleared
+			std::vector<uint8_t> visibility(graphics::visibility_mask_size(count) + 1, 0xAA);
+			graphics::boxes_in_frustum(boxes, planes, visibility);
+
+			CHECK(matches_reference(boxes, planes, visibility));
+			CHECK(visibility.back() == 0xAA);
+			if (count % 8 != 0) CHECK((visibility[count / 8] >> (count % 8)) == 0);
+		}
+	}
+}
+
+TEST_CASE(boxes_in_frustum_ranges_match_scalar)
+{
+	std::mt19937 rng(0xbeef);
+	const auto planes = test_frustum_planes();
+	const auto boxes = random_boxes(rng, 29);
+
+	// Ranges fully inside the array use the 8-wide path with masking, ranges at the end the scalar tail
+	for (const auto first : std::views::iota(0zu, boxes.size()))
+		for (const auto count : std::views::iota(0zu, std::min<size_t>(8, boxes.size() - first) + 1))
+		{
+			const auto mask = graphics::boxes_in_frustum(boxes, planes, first, count);
+
+			CHECK((mask >> count) == 0);
+			for (const auto bit : std::views::iota(0zu, count))
+			{
+				const auto idx = first + bit;
+				const bool expected =
+					graphics::box_in_frustum(boxes.get_min(idx), boxes.get_max(idx), planes);
+				CHECK(bool((mask >> bit) & 1) == expected);
+			}
+		}
+}
@@ -0,0 +1,58 @@
+#include "gltf/detail/mesh/optimize.hpp"
+#include "test/check.hpp"
+
+#include <ranges>
+
+using gltf::detail::mesh::narrow_indices;
+using gltf::detail::mesh::remap_vertices;
+
+// Unindexed triangle list of `unique_count` distinct vertices, each repeated three times
+static std::vector<gltf::ShadowVertex> repeated_vertices(uint32_t unique_count) noexcept
+{
+	return std::views::iota(0u, unique_count * 3)
+		| std::views::transform([unique_count](uint32_t idx) {
+			   const auto unique = idx % unique_count;
+			   return gltf::ShadowVertex{
+				   .position = glm::vec3(float(unique), 0.0f, 0.0f),
+				   .texcoord = glm::vec2(0.0f),
+			   };
+		   })
+		| std::ranges::to<std::vector>();
+}
+
+TEST_CASE(narrow_indices_boundary)
+{
+	CHECK(narrow_indices({}).value_or(std::vector<uint16_t>{1}).empty());
+
+	const std::vector<uint32_t> fitting = {0, 1, 65534, 65535};
+	const auto narrowed = narrow_indices(fitting);
+	CHECK(narrowed.has_value() && std::ranges::equal(*narrowed, fitting));
+
+	CHECK(!narrow_indices(std::vector<uint32_t>{0, 1, 65536}).has_value());
+	CHECK(!narrow_indices(std::vector<uint32_t>{65536, 0, 0}).has_value());
+	CHECK(!narrow_indices(std::vector<uint32_t>{0, 0, UINT32_MAX}).has_value());
+}
+
+TEST_CASE(narrow_indices_after_remap)
+{
+	// 65536 unique vertices is the largest count whose indices fit in 16 bits
+	for (const auto unique_count : {3u, 65535u, 65536u, 65537u})
+	{
+		const auto vertices = repeated_vertices(unique_count);
+		const auto [remapped_vertices, remapped_indices] = remap_vertices(vertices);
+
+		CHECK(remapped_vertices.size() == unique_count);
+		CHECK(remapped_indices.size() == vertices.size());
+
+		const auto narrowed = narrow_indices(remapped_indices);
+		CHECK(narrowed.has_value() == (unique_count <= 65536));
+		if (!narrowed.has_value()) continue;
+
+		// Lossless: every narrowed index equals its 32-bit source and still fetches the original vertex
+		CHECK(std::ranges::equal(*narrowed, remapped_indices));
+		CHECK(std::ranges::all_of(std::views::zip(*narrowed, vertices), [&](const auto& pair) {
+			const auto& [index, vertex] = pair;
+			return remapped_vertices[index] == vertex;
+		}));
+	}
+}
@@ -0,0 +1,108 @@
+#include "gltf/detail/animation/sampler.hpp"
+#include "test/check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ranges>
+#include <vector>
+
+using gltf::detail::animation::find_upper_keyframe;
+using Keyframes = std::vector<std::pair<float, float>>;
+
+// Keyframes at `times`, values are unused by the lookup
+static Keyframes make_keyframes(std::initializer_list<float> times) noexcept
+{
+	return times
+		| std::views::transform([](float time) { return std::make_pair(time, 0.0f); })
+		| std::ranges::to<std::vector>();
+}
+
+// Look up every time in order with one cursor, checking each result against `std::ranges::upper_bound`
+static bool lookups_match(const Keyframes& keyframes, std::span<const float> times, uint32_t& cursor) noexcept
+{
+	return std::ranges::all_of(times, [&](float time) {
+		const auto expected = static_cast<size_t>(
+			std::ranges::upper_bound(keyframes, time, {}, &std::pair<float, float>::first) - keyframes.begin()
+		);
+		const auto found =
+			find_upper_keyframe(std::span<const std::pair<float, float>>(keyframes), time, cursor);
+		return found == expected && cursor == expected;
+	});
+}
+
+// Times from `start` to `end` inclusive in `step` increments
+static std::vector<float> time_steps(float start, float end, float step) noexcept
+{
+	const auto count = static_cast<int>(std::floor((end - start) / step));
+	return std::views::iota(0, count + 1)
+		| std::views::transform([=](int idx) { return start + idx * step; })
+		| std::ranges::to<std::vector>();
+}
+
+// Uneven keyframes over [0, 2], with two sharing a timestamp as in a step discontinuity
+static const auto test_keyframes =
+	make_keyframes({0.0f, 0.1f, 0.15f, 0.5f, 0.5f, 0.8f, 1.0f, 1.3f, 1.31f, 1.32f, 1.33f, 1.6f, 2.0f});
+
+TEST_CASE(find_upper_keyframe_forward_playback)
+{
+	// Small steps advance a keyframe or two, large ones go beyond the linear steps into the binary search
+	for (const auto step : {1.0f / 240.0f, 1.0f / 60.0f, 0.1f, 0.45f, 1.5f})
+	{
+		uint32_t cursor = 0;
+		CHECK(lookups_match(test_keyframes, time_steps(-0.5f, 2.5f, step), cursor));
+	}
+
+	// Exactly on keyframe timestamps
+	uint32_t cursor = 0;
+	const auto exact = test_keyframes | std::views::keys | std::ranges::to<std::vector>();
+	CHECK(lookups_match(test_keyframes, exact, cursor));
+}
+
+TEST_CASE(find_upper_keyframe_backward_seek)
+{
+	uint32_t cursor = 0;
+	CHECK(lookups_match(test_keyframes, time_steps(0.0f, 2.5f, 1.0f / 60.0f), cursor));
+	CHECK(cursor == test_keyframes.size());
+
+	// Seeking back anywhere, including before the first keyframe, then playing forward again
+	const std::array seek_times = {1.9f, 1.0f, 0.5f, 0.49f, 1.31f, 0.0f, -1.0f, 0.12f, 2.0f, 0.05f};
+	CHECK(lookups_match(test_keyframes, seek_times, cursor));
+	CHECK(lookups_match(test_keyframes, time_steps(0.05f, 1.0f, 1.0f / 60.0f), cursor));
+
+	// Reverse playback
+	auto reversed = time_steps(-0.2f, 2.2f, 1.0f / 30.0f);
+	std::ranges::reverse(reversed);
+	CHECK(lookups_match(test_keyframes, reversed, cursor));
+}
+
+TEST_CASE(find_upper_keyframe_loop_wrap)
+{
+	// Looping playback wraps time back to the start of the clip, three times over
+	const auto times = time_steps(0.0f, 6.5f, 1.0f / 60.0f)
+		| std::views::transform([](float time) { return std::fmod(time, 2.0f); })
+		| std::ranges::to<std::vector>();
+
+	uint32_t cursor = 0;
+	CHECK(lookups_match(test_keyframes, times, cursor));
+}
+
+TEST_CASE(find_upper_keyframe_single_keyframe)
+{
+	const auto single = make_keyframes({0.75f});
+
+	uint32_t cursor = 0;
+	const std::array times = {0.0f, 0.75f, 0.76f, 5.0f, 0.74f, -1.0f, 0.75f};
+	CHECK(lookups_match(single, times, cursor));
+}
+
+TEST_CASE(find_upper_keyframe_stale_cursor)
+{
+	// A cursor past the end, e.g. kept from a longer channel, falls back to a full search
+	for (const auto stale : {14u, 100u, UINT32_MAX})
+	{
+		uint32_t cursor = stale;
+		const std::array times = {0.3f, 0.31f};
+		CHECK(lookups_match(test_keyframes, times, cursor));
+	}
+}
@@ -0,0 +1,131 @@
+#include "gltf/detail/mesh/optimize.hpp"
+#include "test/check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+
+using gltf::detail::mesh::generate_lods;
+
+// Indexed height field over [0, 1]^2 with `cells` quads per side, bumpy so that simplification has error
+struct TestGrid
+{
+	std::vector<gltf::ShadowVertex> vertices;
+	std::vector<uint32_t> indices;
+
+	explicit TestGrid(uint32_t cells) noexcept
+	{
+		for (const auto [y, x] :
+			 std::views::cartesian_product(std::views::iota(0u, cells + 1), std::views::iota(0u, cells + 1)))
+		{
+			const float u = float(x) / cells, v = float(y) / cells;
+			const float height =
+				0.05f * std::sin(u * 9.0f) * std::cos(v * 7.0f) + 0.02f * std::sin(u * v * 40.0f);
+			vertices.push_back({.position = {u, v, height}, .texcoord = {u, v}});
+		}
+
+		for (const auto [y, x] :
+			 std::views::cartesian_product(std::views::iota(0u, cells), std::views::iota(0u, cells)))
+		{
+			const auto corner = y * (cells + 1) + x;
+			const auto above = corner + cells + 1;
+			indices.insert(indices.end(), {corner, corner + 1, above + 1, corner, above + 1, above});
+		}
+	}
+};
+
+// Non-sloppy config, so that every level stays within `max_error`
+static constexpr gltf::LodConfig test_config = {
+	.max_level_count = 5,
+	.index_ratio = 0.5f,
+	.max_error = 0.05f,
+	.min_triangle_count = 64,
+	.sloppy_fallback = false,
+};
+
+TEST_CASE(generate_lods_reduces_triangles)
+{
+	TestGrid grid(128);
+	const auto full_count = grid.indices.size();
+	const auto lods = generate_lods(grid.vertices, grid.indices, test_config);
+
+	// The bumpy grid simplifies well, so the chain should go past full detail
+	CHECK(lods.size() > 1);
+	CHECK(lods.size() <= test_config.max_level_count);
+
+	CHECK(lods[0].first_index == 0);
+	CHECK(lods[0].index_count == full_count);
+	CHECK(lods[0].error == 0.0f);
+
+	// Levels follow full detail back to back
+	uint32_t running_total = 0;
+	for (const auto& lod : lods)
+	{
+		CHECK(lod.first_index == running_total);
+		CHECK(lod.index_count % 3 == 0);
+		running_total += lod.index_count;
+	}
+	CHECK(grid.indices.size() == running_total);
+
+	for (const auto [previous, current] : lods | std::views::adjacent<2>)
+	{
+		// Within the stall tolerance of the target, see `generate_lods`
+		const auto target = size_t(float(previous.index_count) * test_config.index_ratio) / 3 * 3;
+		CHECK(current.index_count <= (previous.index_count + target) / 2);
+
+		CHECK(current.error >= previous.error);
+		CHECK(current.error <= test_config.max_error);
+	}
+
+	// Every level references valid vertices
+	const auto vertex_count = grid.vertices.size();
+	CHECK(std::ranges::all_of(grid.indices, [vertex_count](uint32_t index) { return index < vertex_count; }));
+}
+
+TEST_CASE(generate_lods_full_detail_only)
+{
+	// Simplification disabled
+	TestGrid disabled_grid(32);
+	const auto disabled_count = disabled_grid.indices.size();
+	auto single_level = test_config;
+	single_level.max_level_count = 1;
+
+	const auto disabled_lods = generate_lods(disabled_grid.vertices, disabled_grid.indices, single_level);
+	CHECK(disabled_lods.size() == 1);
+	CHECK(disabled_grid.indices.size() == disabled_count);
+
+	// 8x8 cells make 128 triangles, the first level would target 64, below the minimum of 100
+	TestGrid small_grid(8);
+	const auto small_count = small_grid.indices.size();
+	auto high_minimum = test_config;
+	high_minimum.min_triangle_count = 100;
+
+	const auto small_lods = generate_lods(small_grid.vertices, small_grid.indices, high_minimum);
+	CHECK(small_lods.size() == 1);
+	CHECK(small_lods[0].index_count == small_count);
+	CHECK(small_grid.indices.size() == small_count);
+}
+
+TEST_CASE(select_lod_by_projected_size)
+{
+	TestGrid grid(128);
+	const auto lods = generate_lods(grid.vertices, grid.indices, test_config);
+	CHECK(lods.size() > 1);
+	CHECK(lods.back().error > 0.0f);
+
+	constexpr float max_error = 0.001f;
+
+	// Filling the screen, any simplification error shows
+	CHECK(&gltf::select_lod(lods, 1.0e6f, max_error) == &lods[0]);
+
+	// A few pixels across, the coarsest level is good enough
+	CHECK(&gltf::select_lod(lods, 1.0e-6f, max_error) == &lods.back());
+
+	// In between, the selected level is the coarsest one within the error bound
+	for (const auto projected_size : {0.01f, 0.1f, 1.0f, 10.0f})
+	{
+		const auto& selected = gltf::select_lod(lods, projected_size, max_error);
+		CHECK(&selected == &lods[0] || selected.error * projected_size <= max_error);
+		CHECK(&selected == &lods.back() || (&selected + 1)->error * projected_size > max_error);
+	}
+}
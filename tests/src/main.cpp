@@ -0,0 +1,68 @@
+#include "test/check.hpp"
+
+#include <cstdlib>
+#include <print>
+#include <span>
+
+namespace test
+{
+	static size_t failures = 0;
+	static std::string_view current_case;
+
+	std::vector<Case>& cases() noexcept
+	{
+		static std::vector<Case> registered_cases;
+		return registered_cases;
+	}
+
+	Registrar::Registrar(std::string_view name, void (*function)()) noexcept
+	{
+		cases().push_back({.name = name, .function = function});
+	}
+
+	void check(bool condition, std::string_view expression, std::source_location location) noexcept
+	{
+		if (condition) return;
+
+		failures++;
+		std::println(
+			stderr,
+			"{}:{}: check failed in {}: {}",
+			location.file_name(),
+			location.line(),
+			current_case,
+			expression
+		);
+	}
+
+	size_t failure_count() noexcept
+	{
+		return failures;
+	}
+}
+
+// Usage: unit-test [name filter], runs the cases whose name contains the filter
+int main(int argc, const char* argv[])
+{
+	const auto args = std::span(argv, argc);
+	const std::string_view filter = args.size() > 1 ? args[1] : "";
+
+	size_t run_count = 0, failed_count = 0;
+
+	for (const auto& [name, function] : test::cases())
+	{
+		if (!name.contains(filter)) continue;
+
+		const auto failures_before = test::failure_count();
+		test::current_case = name;
+		function();
+		run_count++;
+
+		const bool passed = test::failure_count() == failures_before;
+		if (!passed) failed_count++;
+		std::println("[{}] {}", passed ? "PASS" : "FAIL", name);
+	}
+
+	std::println("{} of {} test cases passed", run_count - failed_count, run_count);
+	return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+#include "gltf/meshlet.hpp"
+#include "graphics/culling.hpp"
+#include "test/check.hpp"
+
+#include <array>
+#include <glm/gtc/matrix_transform.hpp>
+
+using Ranges = std::pmr::vector<std::pair<uint32_t, uint32_t>>;
+
+// Meshlet of `index_count` indices, a unit sphere at `center` with triangles facing +Z
+static gltf::Meshlet test_meshlet(
+	uint32_t first_index,
+	uint32_t index_count,
+	const glm::vec3& center
+) noexcept
+{
+	return {
+		.first_index = first_index,
+		.index_count = index_count,
+		.center = center,
+		.radius = 1.0f,
+		.cone_apex = center,
+		.cone_cutoff = 0.0f,
+		.cone_axis = {0.0f, 0.0f, 1.0f}
+	};
+}
+
+// 90 degree square frustum at the origin, looking down -Z. The eye sees the +Z facing side of meshlets.
+static const auto frustum_planes =
+	graphics::compute_frustum_planes(glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f));
+static const glm::vec3 eye_position(0.0f);
+
+static const glm::vec3 visible_center(0.0f, 0.0f, -10.0f), hidden_center(50.0f, 0.0f, -10.0f);
+
+TEST_CASE(cull_meshlets_merges_contiguous_ranges)
+{
+	const std::array meshlets = {
+		test_meshlet(0, 12, visible_center),
+		test_meshlet(12, 24, visible_center),
+		test_meshlet(36, 6, visible_center),
+	};
+
+	Ranges ranges;
+	gltf::cull_meshlets(meshlets, glm::mat4(1.0f), frustum_planes, eye_position, true, ranges);
+	CHECK(ranges == Ranges{{0, 42}});
+}
+
+TEST_CASE(cull_meshlets_splits_around_culled)
+{
+	const std::array meshlets = {
+		test_meshlet(0, 12, visible_center),
+		test_meshlet(12, 12, hidden_center),
+		test_meshlet(24, 12, visible_center),
+		test_meshlet(36, 12, visible_center),
+		test_meshlet(48, 12, hidden_center),
+	};
+
+	Ranges ranges;
+	gltf::cull_meshlets(meshlets, glm::mat4(1.0f), frustum_planes, eye_position, true, ranges);
+	CHECK(ranges == Ranges{{0, 12}, {24, 24}});
+}
+
+TEST_CASE(cull_meshlets_keeps_gaps)
+{
+	// Not adjacent in the index buffer, so not merged even if both are visible
+	const std::array meshlets = {
+		test_meshlet(0, 12, visible_center),
+		test_meshlet(24, 12, visible_center),
+	};
+
+	Ranges ranges;
+	gltf::cull_meshlets(meshlets, glm::mat4(1.0f), frustum_planes, eye_position, true, ranges);
+	CHECK(ranges == Ranges{{0, 12}, {24, 12}});
+}
+
+TEST_CASE(cull_meshlets_appends_without_merging_previous)
+{
+	// Ranges of another primitive are already in the list, and must not be extended
+	const std::array meshlets = {test_meshlet(12, 12, visible_center)};
+
+	Ranges ranges{{0, 12}};
+	gltf::cull_meshlets(meshlets, glm::mat4(1.0f), frustum_planes, eye_position, true, ranges);
+	CHECK(ranges == Ranges{{0, 12}, {12, 12}});
+}
+
+TEST_CASE(cull_meshlets_backfacing)
+{
+	// Rotated half a turn, the triangles face away from the eye
+	const auto rotation = glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const std::array meshlets = {test_meshlet(0, 12, {0.0f, 0.0f, 10.0f})};
+
+	Ranges culled;
+	gltf::cull_meshlets(meshlets, rotation, frustum_planes, eye_position, true, culled);
+	CHECK(culled.empty());
+
+	// Double-sided materials skip the cone test
+	Ranges double_sided;
+	gltf::cull_meshlets(meshlets, rotation, frustum_planes, eye_position, false, double_sided);
+	CHECK(double_sided == Ranges{{0, 12}});
+
+	// Mirroring flips the winding, the cone test no longer applies
+	const auto mirror = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, -1.0f));
+	Ranges mirrored;
+	gltf::cull_meshlets(meshlets, mirror, frustum_planes, eye_position, true, mirrored);
+	CHECK(mirrored == Ranges{{0, 12}});
+}
@@ -0,0 +1,154 @@
+#include "gltf/mesh.hpp"
+#include "test/check.hpp"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <ranges>
+
+// Octahedral snorm16 is off by at most half a step in each coordinate, which stays below this angle
+static constexpr double max_direction_error = 1.0e-4;
+
+// Half floats round to nearest with 11 significant bits, `meshopt_quantizeHalf` flushes values below the
+// smallest normal half of 2^-14 to zero
+static bool texcoord_within_half(float original, float decoded) noexcept
+{
+	const float smallest_normal = std::exp2(-14.0f);
+	const float bound = std::abs(original) < smallest_normal ? smallest_normal
+															  : std::abs(original) * std::exp2(-11.0f);
+	return std::abs(decoded - original) <= bound;
+}
+
+// Unorm16 positions are off by at most half of `extent / 65535` per axis, the check allows a full step
+static bool position_within_unorm16(
+	const glm::vec3& original,
+	const glm::vec3& decoded,
+	const glm::vec3& position_min,
+	const glm::vec3& position_max
+) noexcept
+{
+	const auto bound = (position_max - position_min) / 65535.0f;
+	return glm::all(glm::lessThanEqual(glm::abs(decoded - original), bound));
+}
+
+// Angle between directions in double precision, stable for tiny angles
+static double direction_error(const glm::vec3& original, const glm::vec3& decoded) noexcept
+{
+	const auto a = glm::normalize(glm::dvec3(original)), b = glm::dvec3(decoded);
+	return std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+}
+
+static glm::vec3 random_direction(std::mt19937& rng) noexcept
+{
+	std::normal_distribution<float> distribution;
+	glm::vec3 direction(0.0f);
+	while (glm::length(direction) < 1.0e-3f)
+		direction = {distribution(rng), distribution(rng), distribution(rng)};
+	return glm::normalize(direction);
+}
+
+// Directions on the axes and along the octahedral fold, where the lower hemisphere is unfolded
+static const auto edge_directions = std::to_array<glm::vec3>({
+	{1.0f, 0.0f, 0.0f},
+	{-1.0f, 0.0f, 0.0f},
+	{0.0f, 1.0f, 0.0f},
+	{0.0f, -1.0f, 0.0f},
+	{0.0f, 0.0f, 1.0f},
+	{0.0f, 0.0f, -1.0f},
+	{0.6f, 0.8f, -1.0e-7f},
+	{-0.6f, 0.8f, -1.0e-7f},
+	{0.6f, -0.8f, 1.0e-7f},
+	{0.5f, 0.5f, -0.70710678f},
+	{-0.5f, -0.5f, -0.70710678f},
+});
+
+static const auto edge_texcoords = std::to_array<glm::vec2>({
+	{0.0f, 1.0f},
+	{0.5f, 0.25f},
+	{-1.0f, 2.0f},
+	{1.0e-6f, -3.0e-5f},
+	{1000.5f, -2047.75f},
+	{0.333333f, 0.999f},
+});
+
+TEST_CASE(quantized_vertex_round_trip)
+{
+	std::mt19937 rng(0x5eed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f), texcoord(-4.0f, 4.0f);
+
+	const std::array<std::pair<glm::vec3, glm::vec3>, 3> bounds_list = {{
+		{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+		{{-250.0f, 3.0f, 1000.0f}, {780.0f, 3.5f, 1200.0f}},
+		{{0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 0.0f}},  // Flat along z
+	}};
+
+	for (const auto& [position_min, position_max] : bounds_list)
+	{
+		const auto check_vertex = [&](const gltf::Vertex& vertex) {
+			const auto decoded =
+				gltf::QuantizedVertex::from_vertex(vertex, position_min, position_max)
+					.to_vertex(position_min, position_max);
+
+			CHECK(position_within_unorm16(vertex.position, decoded.position, position_min, position_max));
+			CHECK(direction_error(vertex.normal, decoded.normal) <= max_direction_error);
+			const auto tangent_error = direction_error(glm::vec3(vertex.tangent), glm::vec3(decoded.tangent));
+			CHECK(tangent_error <= max_direction_error);
+			CHECK(decoded.tangent.w == vertex.tangent.w);
+			CHECK(texcoord_within_half(vertex.texcoord.x, decoded.texcoord.x));
+			CHECK(texcoord_within_half(vertex.texcoord.y, decoded.texcoord.y));
+		};
+
+		// Corners of the bounds, and edge case directions and texcoords
+		for (const auto [idx, direction] : edge_directions | std::views::enumerate)
+			check_vertex({
+				.position = idx % 2 == 0 ? position_min : position_max,
+				.normal = direction,
+				.tangent = glm::vec4(
+					edge_directions[(idx + 1) % edge_directions.size()],
+					idx % 3 == 0 ? -1.0f : 1.0f
+				),
+				.texcoord = edge_texcoords[idx % edge_texcoords.size()],
+			});
+
+		for (const auto _ : std::views::iota(0, 10000))
+		{
+			const glm::vec3 t(unit(rng), unit(rng), unit(rng));
+			check_vertex({
+				.position = position_min + t * (position_max - position_min),
+				.normal = random_direction(rng),
+				.tangent = glm::vec4(random_direction(rng), unit(rng) < 0.5f ? -1.0f : 1.0f),
+				.texcoord = {texcoord(rng), texcoord(rng)},
+			});
+		}
+	}
+}
+
+TEST_CASE(quantized_shadow_vertex_round_trip)
+{
+	std::mt19937 rng(0x5eed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f), texcoord(-4.0f, 4.0f);
+
+	const glm::vec3 position_min(-12.0f, 0.0f, -0.5f), position_max(12.0f, 40.0f, 0.5f);
+
+	const auto check_vertex = [&](const gltf::ShadowVertex& vertex) {
+		const auto decoded =
+			gltf::QuantizedShadowVertex::from_shadow_vertex(vertex, position_min, position_max)
+				.to_shadow_vertex(position_min, position_max);
+
+		CHECK(position_within_unorm16(vertex.position, decoded.position, position_min, position_max));
+		CHECK(texcoord_within_half(vertex.texcoord.x, decoded.texcoord.x));
+		CHECK(texcoord_within_half(vertex.texcoord.y, decoded.texcoord.y));
+	};
+
+	for (const auto& uv : edge_texcoords) check_vertex({.position = position_min, .texcoord = uv});
+	check_vertex({.position = position_max, .texcoord = {1.0f, 1.0f}});
+
+	for (const auto _ : std::views::iota(0, 10000))
+	{
+		const glm::vec3 t(unit(rng), unit(rng), unit(rng));
+		check_vertex({
+			.position = position_min + t * (position_max - position_min),
+			.texcoord = {texcoord(rng), texcoord(rng)},
+		});
+	}
+}
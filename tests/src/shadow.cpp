@@ -0,0 +1,137 @@
+#include "graphics/bvh.hpp"
+#include "render/drawdata/shadow.hpp"
+#include "test/check.hpp"
+
+#include <array>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <ranges>
+
+using render::drawdata::Shadow;
+
+static const auto test_shadow_lods = std::to_array<gltf::PrimitiveLod>({
+	{.first_index = 0, .index_count = 3000, .error = 0.0f},
+	{.first_index = 3000, .index_count = 1200, .error = 0.002f},
+	{.first_index = 4200, .index_count = 300, .error = 0.02f},
+});
+
+// Fixed scene of one model: random boxes with mixed materials, vertex formats and rigging, some hidden
+struct TestScene
+{
+	gltf::MaterialCache material_cache;
+	graphics::Bvh bvh;
+	std::vector<gltf::PrimitiveDrawcall> drawcalls;
+	std::vector<uint32_t> bvh_drawcall_indices;
+
+	TestScene(uint32_t seed, size_t drawcall_count) :
+		material_cache(
+			{
+				{.params = {.pipeline = {.alpha_mode = gltf::AlphaMode::Opaque, .double_sided = false}}},
+				{.params = {.pipeline = {.alpha_mode = gltf::AlphaMode::Mask, .double_sided = true}}},
+				{.params = {.pipeline = {.alpha_mode = gltf::AlphaMode::Blend, .double_sided = false}}},
+			},
+			{}
+		)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> position(-60.0f, 60.0f), size(0.1f, 8.0f);
+		std::uniform_int_distribution<uint32_t> material(0, 3), kind(0, 9);
+
+		graphics::BoxArray boxes;
+
+		for (const auto idx : std::views::iota(0zu, drawcall_count))
+		{
+			const glm::vec3 box_min(position(rng), position(rng) * 0.2f, position(rng));
+			const glm::vec3 box_max = box_min + glm::vec3(size(rng), size(rng), size(rng));
+			const auto material_index = material(rng);
+			const auto drawcall_kind = kind(rng);
+
+			boxes.push_back(box_min, box_max);
+			drawcalls.push_back({
+				.world_position_min = box_min,
+				.world_position_max = box_max,
+				.material_index = material_index < 3 ? std::optional(material_index) : std::nullopt,
+				.transform_or_joint_matrix_offset = drawcall_kind == 0
+					? std::variant<glm::mat4, uint32_t>(uint32_t(idx))
+					: std::variant<glm::mat4, uint32_t>(glm::mat4(1.0f)),
+				.primitive = {
+					.vertex_format =
+						drawcall_kind < 5 ? gltf::VertexFormat::Standard : gltf::VertexFormat::Quantized,
+					.shadow_lods = test_shadow_lods,
+					.lod = test_shadow_lods[0],
+				},
+			});
+			bvh_drawcall_indices.push_back(
+				drawcall_kind == 9 ? gltf::Drawdata::hidden_drawcall : static_cast<uint32_t>(idx)
+			);
+		}
+
+		bvh = graphics::Bvh::build(boxes);
+	}
+
+	gltf::Drawdata drawdata() const noexcept
+	{
+		return {
+			.primitive_drawcalls = std::pmr::vector<gltf::PrimitiveDrawcall>(std::from_range, drawcalls),
+			.primitive_bvh = &bvh,
+			.bvh_drawcall_indices = std::pmr::vector<uint32_t>(std::from_range, bvh_drawcall_indices),
+			.node_matrices = {},
+			.deferred_skin_resource = nullptr,
+			.material_cache = material_cache.ref()
+		};
+	}
+};
+
+static Shadow make_test_shadow() noexcept
+{
+	// Reversed depth, the near plane is at 1 as the renderer expects
+	const auto camera_matrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1000.0f, 0.1f)
+		* glm::lookAt(glm::vec3(0.0f, 10.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	return {camera_matrix, glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f)), 0.0005f, 0.5f};
+}
+
+static bool same_drawcall(const Shadow::Drawcall& a, const Shadow::Drawcall& b) noexcept
+{
+	return a.sort_key == b.sort_key
+		&& a.resource_set_index == b.resource_set_index
+		&& a.drawcall.world_position_min == b.drawcall.world_position_min
+		&& a.drawcall.world_position_max == b.drawcall.world_position_max
+		&& a.drawcall.material_index == b.drawcall.material_index
+		&& a.drawcall.primitive.lod.first_index == b.drawcall.primitive.lod.first_index
+		&& a.drawcall.primitive.lod.index_count == b.drawcall.primitive.lod.index_count;
+}
+
+TEST_CASE(shadow_parallel_matches_serial)
+{
+	const TestScene scene_a(1, 400), scene_b(2, 150);
+	const std::vector drawdata_list = {scene_a.drawdata(), scene_b.drawdata()};
+
+	auto serial = make_test_shadow();
+	for (const auto& drawdata : drawdata_list) serial.append(drawdata);
+	serial.sort();
+
+	// The scene must exercise the comparison
+	CHECK(std::ranges::any_of(serial.csm_levels, [](const auto& level) {
+		return level.drawcalls.size() > 1;
+	}));
+
+	dp::thread_pool pool(Shadow::level_count);
+
+	// Repeated, so that different job interleavings are covered
+	for (const auto _ : std::views::iota(0, 16))
+	{
+		auto parallel = make_test_shadow();
+		for (auto& future : parallel.append_sort_async(drawdata_list, pool)) future.wait();
+
+		for (const auto& [serial_level, parallel_level] :
+			 std::views::zip(serial.csm_levels, parallel.csm_levels))
+		{
+			CHECK(serial_level.near == parallel_level.near);
+			CHECK(serial_level.far == parallel_level.far);
+			CHECK(serial_level.resource_sets.size() == parallel_level.resource_sets.size());
+			CHECK(serial_level.get_vp_matrix() == parallel_level.get_vp_matrix());
+			CHECK(std::ranges::equal(serial_level.drawcalls, parallel_level.drawcalls, same_drawcall));
+		}
+	}
+}
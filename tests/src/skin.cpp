@@ -0,0 +1,93 @@
+#include "gltf/skin.hpp"
+#include "test/check.hpp"
+
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+
+// Joint matrix entries stay within a few tens, where float rounding of a 4-term dot product is near 1e-5
+static constexpr float max_matrix_error = 1.0e-4f;
+
+static bool matrix_near(const glm::mat4& actual, const glm::mat4& expected) noexcept
+{
+	return std::ranges::all_of(std::views::iota(0, 4), [&](int col) {
+		const auto difference = glm::abs(actual[col] - expected[col]);
+		return glm::all(glm::lessThanEqual(difference, glm::vec4(max_matrix_error)));
+	});
+}
+
+static bool vector_near(const glm::vec3& actual, const glm::vec3& expected) noexcept
+{
+	return glm::all(glm::lessThanEqual(glm::abs(actual - expected), glm::vec3(max_matrix_error)));
+}
+
+// Random TRS matrix, with a translation w other than 1 when `projective`
+static glm::mat4 random_matrix(std::mt19937& rng, bool projective) noexcept
+{
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f), scale(0.5f, 2.0f);
+
+	const glm::vec3 translation(unit(rng), unit(rng), unit(rng));
+	const auto rotation = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+	auto matrix = glm::translate(glm::mat4(1.0f), translation)
+		* glm::mat4_cast(rotation)
+		* glm::scale(glm::mat4(1.0f), glm::vec3(scale(rng), scale(rng), scale(rng)));
+
+	if (projective) matrix[3][3] = scale(rng);
+	return matrix;
+}
+
+// Two skins of 5 and 11 joints over 16 nodes, sharing some joints
+static gltf::SkinList make_test_skins(std::mt19937& rng) noexcept
+{
+	gltf::SkinList skins;
+	skins.joints = {0, 3, 4, 7, 9, 1, 2, 3, 5, 6, 8, 10, 11, 12, 14, 15};
+	skins.skin_offsets = {{0, 5}, {5, 11}};
+	skins.inverse_bind_matrices = std::views::iota(0zu, skins.joints.size())
+		| std::views::transform([&](size_t) { return glm::inverse(random_matrix(rng, false)); })
+		| std::ranges::to<std::vector>();
+	return skins;
+}
+
+TEST_CASE(compute_joint_matrices_matches_glm)
+{
+	std::mt19937 rng(0x5eed);
+	const auto skins = make_test_skins(rng);
+
+	// Every third node has a non-unit w
+	const auto node_world_matrices = std::views::iota(0, 16)
+		| std::views::transform([&](int idx) { return random_matrix(rng, idx % 3 == 0); })
+		| std::ranges::to<std::vector>();
+
+	std::vector<gltf::JointBounds> skin_bounds(skins.skin_offsets.size());
+	const auto joint_matrices = skins.compute_joint_matrices(node_world_matrices, skin_bounds);
+	CHECK(joint_matrices.size() == skins.joints.size());
+
+	for (const auto [joint_matrix, joint, inverse_bind] :
+		 std::views::zip(joint_matrices, skins.joints, skins.inverse_bind_matrices))
+		CHECK(matrix_near(joint_matrix, node_world_matrices[joint] * inverse_bind));
+
+	// Bounds hold the joint positions after the perspective divide
+	for (const auto [skin_index, bounds] : skin_bounds | std::views::enumerate)
+	{
+		const auto skin = skins[skin_index];
+
+		gltf::JointBounds expected;
+		for (const auto joint : skin.joints)
+		{
+			const auto& col = node_world_matrices[joint][3];
+			const auto position = glm::vec3(col) / col.w;
+			expected.position_min = glm::min(expected.position_min, position);
+			expected.position_max = glm::max(expected.position_max, position);
+		}
+
+		CHECK(vector_near(bounds.position_min, expected.position_min));
+		CHECK(vector_near(bounds.position_max, expected.position_max));
+	}
+
+	// Skipping the bounds leaves the matrices unchanged
+	const auto unbounded_matrices = skins.compute_joint_matrices(node_world_matrices, {});
+	CHECK(std::ranges::equal(unbounded_matrices, joint_matrices));
+}
@@ -0,0 +1,208 @@
+#include "gltf/detail/mesh/data.hpp"
+#include "test/check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <ranges>
+
+using gltf::detail::mesh::compute_smooth_tangents;
+using gltf::detail::mesh::compute_tangents;
+
+// Indexed triangle list with its expected tangent at each corner
+struct TangentCase
+{
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> texcoords;
+	std::vector<uint32_t> indices;
+	std::vector<glm::vec4> expected;
+};
+
+// Same direction within float rounding, and exactly the same bitangent sign
+static bool tangents_match(std::span<const glm::vec4> tangents, std::span<const glm::vec4> expected) noexcept
+{
+	return tangents.size() == expected.size()
+		&& std::ranges::all_of(std::views::zip(tangents, expected), [](const auto& pair) {
+			   const auto& [tangent, reference] = pair;
+			   return tangent.w == reference.w
+				   && glm::length(glm::vec3(tangent) - glm::vec3(reference)) <= 1.0e-5f;
+		   });
+}
+
+static bool compute_matches(const TangentCase& test_case) noexcept
+{
+	const auto tangents = compute_smooth_tangents(
+		test_case.positions,
+		test_case.normals,
+		test_case.texcoords,
+		test_case.indices
+	);
+	return tangents_match(tangents, test_case.expected);
+}
+
+// Bitangent rebuilt as the shaders do, `cross(normal, tangent) * w`
+static glm::vec3 rebuilt_bitangent(const glm::vec3& normal, const glm::vec4& tangent) noexcept
+{
+	return glm::cross(normal, glm::vec3(tangent)) * tangent.w;
+}
+
+static const glm::vec3 up(0.0f, 0.0f, 1.0f);
+static const glm::vec4 positive_x(1.0f, 0.0f, 0.0f, 1.0f), mirrored_x(-1.0f, 0.0f, 0.0f, -1.0f);
+
+// Unit quad in the XY plane facing +Z, wound counter-clockwise
+static TangentCase planar_quad(const std::array<glm::vec2, 4>& texcoords, const glm::vec4& expected) noexcept
+{
+	return {
+		.positions = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+		.normals = std::vector(4, up),
+		.texcoords = std::vector(std::from_range, texcoords),
+		.indices = {0, 1, 2, 0, 2, 3},
+		.expected = std::vector(6, expected),
+	};
+}
+
+TEST_CASE(tangent_planar_reference)
+{
+	// UV along XY, the tangent is +X and the bitangent +Y
+	const std::array<glm::vec2, 4> plain = {{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}};
+	CHECK(compute_matches(planar_quad(plain, positive_x)));
+
+	// U mirrored, the tangent flips to -X while the bitangent stays +Y, so w is -1
+	const std::array<glm::vec2, 4> mirrored_u = {{{1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}}};
+	CHECK(compute_matches(planar_quad(mirrored_u, mirrored_x)));
+
+	// UV rotated a quarter turn, u runs along +Y and v along -X
+	const std::array<glm::vec2, 4> rotated = {{{0.0f, 0.0f}, {0.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 0.0f}}};
+	CHECK(compute_matches(planar_quad(rotated, {0.0f, 1.0f, 0.0f, 1.0f})));
+
+	// V mirrored, the tangent stays +X while the bitangent flips to -Y
+	const std::array<glm::vec2, 4> mirrored_v = {{{0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f}}};
+	CHECK(compute_matches(planar_quad(mirrored_v, {1.0f, 0.0f, 0.0f, -1.0f})));
+}
+
+TEST_CASE(tangent_mirror_seam_reference)
+{
+	// Two quads sharing the edge at x = 0, with u = |x| mirrored across it. Corners on the seam take the
+	// tangent of their own side, not the cancelled out sum of both.
+	const TangentCase test_case = {
+		.positions = {
+			{-1.0f, 0.0f, 0.0f},
+			{0.0f, 0.0f, 0.0f},
+			{1.0f, 0.0f, 0.0f},
+			{-1.0f, 1.0f, 0.0f},
+			{0.0f, 1.0f, 0.0f},
+			{1.0f, 1.0f, 0.0f},
+		},
+		.normals = std::vector(6, up),
+		.texcoords = {{1.0f, 0.0f}, {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}},
+		.indices = {0, 1, 4, 0, 4, 3, 1, 2, 5, 1, 5, 4},
+		.expected = {
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			positive_x,
+			positive_x,
+			positive_x,
+			positive_x,
+			positive_x,
+			positive_x,
+		},
+	};
+	CHECK(compute_matches(test_case));
+
+	// The rebuilt bitangent is +Y on both sides, as v runs along +Y everywhere
+	const auto tangents = compute_smooth_tangents(
+		test_case.positions,
+		test_case.normals,
+		test_case.texcoords,
+		test_case.indices
+	);
+	CHECK(std::ranges::all_of(tangents, [](const glm::vec4& tangent) {
+		return glm::length(rebuilt_bitangent(up, tangent) - glm::vec3(0.0f, 1.0f, 0.0f)) <= 1.0e-5f;
+	}));
+
+	// Same result from the unindexed path, which welds the corners first
+	const auto unpack = [&test_case]<typename T>(const std::vector<T>& attribute) {
+		return test_case.indices
+			| std::views::transform([&attribute](uint32_t index) { return attribute[index]; })
+			| std::ranges::to<std::vector>();
+	};
+	const auto unindexed =
+		compute_tangents(unpack(test_case.positions), unpack(test_case.normals), unpack(test_case.texcoords));
+	CHECK(unindexed.has_value() && tangents_match(*unindexed, test_case.expected));
+}
+
+TEST_CASE(tangent_cylinder_reference)
+{
+	// Half cylinder of smooth normals, u around the axis and v along +Y. The angle weighted tangents of the
+	// two faces around each vertex are symmetric, so they average to the exact analytic tangent.
+	constexpr uint32_t segment_count = 12;
+
+	TangentCase test_case;
+
+	for (const auto segment : std::views::iota(0u, segment_count + 1))
+	{
+		const float u = float(segment) / segment_count;
+		const float angle = u * std::numbers::pi_v<float>;
+		const glm::vec3 normal(std::cos(angle), 0.0f, std::sin(angle));
+
+		for (const auto v : {0.0f, 1.0f})
+		{
+			test_case.positions.push_back(normal + glm::vec3(0.0f, v, 0.0f));
+			test_case.normals.push_back(normal);
+			test_case.texcoords.emplace_back(u, v);
+		}
+	}
+
+	// Wound counter-clockwise seen from outside
+	for (const auto segment : std::views::iota(0u, segment_count))
+	{
+		const uint32_t bottom0 = segment * 2, top0 = bottom0 + 1, bottom1 = bottom0 + 2, top1 = bottom0 + 3;
+		for (const auto index : {bottom0, top0, top1, bottom0, top1, bottom1})
+		{
+			// T = dP/du, and with the outward normal cross(N, T) is -Y, the opposite of dP/dv, so w is -1
+			const auto angle = test_case.texcoords[index].x * std::numbers::pi_v<float>;
+			test_case.indices.push_back(index);
+			test_case.expected.emplace_back(-std::sin(angle), 0.0f, std::cos(angle), -1.0f);
+		}
+	}
+
+	CHECK(compute_matches(test_case));
+}
+
+TEST_CASE(tangent_degenerate_reference)
+{
+	// Mirrored quad, plus a triangle with collapsed UVs sharing corner 0. The shared corner borrows the
+	// tangent and sign of its mirrored neighbours, the lone corners fall back to a tangent perpendicular to
+	// the normal with a positive sign.
+	const TangentCase test_case = {
+		.positions = {
+			{0.0f, 0.0f, 0.0f},
+			{1.0f, 0.0f, 0.0f},
+			{1.0f, 1.0f, 0.0f},
+			{0.0f, 1.0f, 0.0f},
+			{-1.0f, 0.0f, 0.0f},
+			{-1.0f, -1.0f, 0.0f},
+		},
+		.normals = std::vector(6, up),
+		.texcoords = {{1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}},
+		.indices = {0, 1, 2, 0, 2, 3, 0, 4, 5},
+		.expected = {
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			mirrored_x,
+			positive_x,
+			positive_x,
+		},
+	};
+	CHECK(compute_matches(test_case));
+}
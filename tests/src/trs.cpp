@@ -0,0 +1,66 @@
+#include "graphics/trs.hpp"
+#include "test/check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <ranges>
+
+// Entries stay within a few units, rotation terms are rounded differently from `glm::mat4_cast`
+static constexpr float max_matrix_error = 1.0e-5f;
+
+static bool matrix_near(const glm::mat4& actual, const glm::mat4& expected) noexcept
+{
+	return std::ranges::all_of(std::views::iota(0, 4), [&](int col) {
+		const auto difference = glm::abs(actual[col] - expected[col]);
+		return glm::all(glm::lessThanEqual(difference, glm::vec4(max_matrix_error)));
+	});
+}
+
+TEST_CASE(trs_compose_matches_glm)
+{
+	struct Transform
+	{
+		glm::vec3 translation;
+		glm::quat rotation;
+		glm::vec3 scale;
+	};
+
+	constexpr size_t transform_count = 40;
+
+	std::mt19937 rng(0x5eed);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f), scale(0.5f, 2.0f);
+
+	const auto transforms = std::views::iota(0zu, transform_count)
+		| std::views::transform([&](size_t) {
+			  return Transform{
+				  .translation = glm::vec3(unit(rng), unit(rng), unit(rng)),
+				  .rotation = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng))),
+				  .scale = glm::vec3(scale(rng), scale(rng), scale(rng))
+			  };
+		  })
+		| std::ranges::to<std::vector>();
+
+	graphics::TrsArray trs;
+	trs.resize(transform_count);
+	for (const auto [idx, transform] : transforms | std::views::enumerate)
+		trs.set(idx, transform.translation, transform.rotation, transform.scale);
+
+	// Counts below, at and above 8 with unaligned starts, so both the 8-wide and the scalar tail paths run
+	for (const auto [first, count] :
+		 std::views::cartesian_product(std::array{0zu, 3zu, 5zu, 13zu, 22zu}, std::views::iota(1zu, 18zu)))
+	{
+		std::vector<glm::mat4> matrices(count);
+		trs.compose(first, matrices);
+
+		for (const auto [idx, matrix] : matrices | std::views::enumerate)
+		{
+			const auto& transform = transforms[first + idx];
+			const auto expected = glm::translate(glm::mat4(1.0f), transform.translation)
+				* glm::mat4_cast(transform.rotation)
+				* glm::scale(glm::mat4(1.0f), transform.scale);
+			CHECK(matrix_near(matrix, expected));
+		}
+	}
+}
@@ -0,0 +1,12 @@
+-- Unit tests of the libraries, run with `xmake test`
+target("unit-test")
+	set_kind("binary")
+	set_languages("c++23")
+	set_group("test")
+	set_default(false)
+
+	add_includedirs("include")
+	add_files("src/**.cpp")
+
+	add_deps("render", "lib::gltf", "lib::graphics.geometry", "lib::util")
+	add_tests("default")
@@ -0,0 +1,143 @@
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <optional>
+#include <print>
+#include <span>
+#include <string_view>
+
+#include "gltf/model.hpp"
+#include "util/unwrap.hpp"
+
+static constexpr std::string_view usage =
+	"Usage: scene-bake <input.gltf|input.glb> <output> [--color raw|bc3|bc7] [--normal raw|bc5|rg16-bc5] "
+	"[--lod-levels <count>] [--lod-error <relative error>]";
+
+struct Arguments
+{
+	std::string_view input;
+	std::string_view output;
+	gltf::MaterialList::ImageConfig image_config;
+	gltf::LodConfig lod_config;
+};
+
+// Parse a whole string as a number
+template <typename T>
+static std::optional<T> parse_number(std::string_view str) noexcept
+{
+	T value;
+	const auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+	if (ec != std::errc() || end != str.data() + str.size()) return std::nullopt;
+	return value;
+}
+
+static std::optional<gltf::ColorCompressMode> parse_color_mode(std::string_view str) noexcept
+{
+	if (str == "raw") return gltf::ColorCompressMode::RGBA8_raw;
+	if (str == "bc3") return gltf::ColorCompressMode::RGBA8_BC3;
+	if (str == "bc7") return gltf::ColorCompressMode::RGBA8_BC7;
+	return std::nullopt;
+}
+
+static std::optional<gltf::NormalCompressMode> parse_normal_mode(std::string_view str) noexcept
+{
+	if (str == "raw") return gltf::NormalCompressMode::RGn_raw;
+	if (str == "bc5") return gltf::NormalCompressMode::RGn_BC5;
+	if (str == "rg16-bc5") return gltf::NormalCompressMode::RG16_raw_RG8_BC5;
+	return std::nullopt;
+}
+
+static std::expected<Arguments, util::Error> parse_arguments(std::span<const char* const> argv) noexcept
+{
+	if (argv.size() < 3) return util::Error(std::string(usage));
+
+	// Defaults match the runtime loader in the main program
+	Arguments arguments{
+		.input = argv[1],
+		.output = argv[2],
+		.image_config = {
+			.color_mode = gltf::ColorCompressMode::RGBA8_BC3,
+			.normal_mode = gltf::NormalCompressMode::RGn_BC5,
+			.parallel_compress = true,
+			.cache = nullptr
+		},
+		.lod_config = {}
+	};
+
+	for (size_t idx = 3; idx < argv.size(); idx += 2)
+	{
+		const std::string_view option = argv[idx];
+		if (idx + 1 >= argv.size()) return util::Error(std::format("Missing value for '{}'", option));
+		const std::string_view value = argv[idx + 1];
+
+		if (option == "--color")
+		{
+			const auto mode = parse_color_mode(value);
+			if (!mode) return util::Error(std::format("Unknown color mode '{}'", value));
+			arguments.image_config.color_mode = *mode;
+		}
+		else if (option == "--normal")
+		{
+			const auto mode = parse_normal_mode(value);
+			if (!mode) return util::Error(std::format("Unknown normal mode '{}'", value));
+			arguments.image_config.normal_mode = *mode;
+		}
+		else if (option == "--lod-levels")
+		{
+			const auto count = parse_number<uint32_t>(value);
+			if (!count || *count == 0) return util::Error(std::format("Invalid level count '{}'", value));
+			arguments.lod_config.max_level_count = *count;
+		}
+		else if (option == "--lod-error")
+		{
+			const auto error = parse_number<float>(value);
+			if (!error || *error < 0.0f) return util::Error(std::format("Invalid error '{}'", value));
+			arguments.lod_config.max_error = *error;
+		}
+		else
+			return util::Error(std::format("Unknown option '{}'\n{}", option, usage));
+	}
+
+	return arguments;
+}
+
+int main(int argc, const char* argv[])
+try
+{
+	const auto arguments =
+		parse_arguments(std::span(argv, argc)) | util::unwrap("Parse command line arguments failed");
+
+	const auto start_time = std::chrono::steady_clock::now();
+
+	std::println("Loading '{}'...", arguments.input);
+	const auto tinygltf_model = gltf::load_tinygltf_model_from_file(std::string(arguments.input))
+		| util::unwrap("Load glTF model failed");
+
+	std::println("Baking to '{}'...", arguments.output);
+	const auto mesh_statistics = gltf::Model::bake(
+		tinygltf_model,
+		arguments.image_config,
+		arguments.lod_config,
+		arguments.output
+	)
+		| util::unwrap("Bake scene failed");
+	std::println("{}", mesh_statistics.to_string());
+
+	const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+	std::println("Done in {:.1f}s", duration.count());
+
+	return EXIT_SUCCESS;
+}
+catch (const util::Error& e)
+{
+	std::println(std::cerr, "\033[91m[Error]\033[0m {}", e->front().message);
+	std::println(std::cerr, "===== Stack Trace =====");
+	e.dump_trace();
+	return EXIT_FAILURE;
+}
+catch (const std::exception& e)
+{
+	std::println(std::cerr, "\033[91m[Error]\033[0m {}", e.what());
+	return EXIT_FAILURE;
+}
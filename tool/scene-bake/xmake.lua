@@ -0,0 +1,8 @@
+-- Offline scene baker, produces scene files for `gltf::Model::from_baked`
+target("scene-bake")
+	set_kind("binary")
+	set_languages("c++23")
+
+	add_files("src/**.cpp")
+
+	add_deps("lib::gltf", "lib::util")
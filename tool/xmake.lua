@@ -0,0 +1,3 @@
+namespace("tool")
+	includes("*")
+namespace_end()
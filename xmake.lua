@@ -28,7 +28,7 @@ includes("xmake/rule", "xmake/task/*.lua")
 add_requires(
 	"libsdl3",
 	"glm 1.0.2",
-	"gzip-hpp v0.1.0",
+	"zlib",
 	"stb 2025.03.14",
 	"tinygltf v2.9.6",
 	"meshoptimizer v0.25",
@@ -40,4 +40,4 @@ add_requires(
 add_requireconfs("**libsdl3", {override=true, version="main"})
 add_requireconfs("**imgui", {override=true, version="v1.92.1-docking", configs={sdl3=true, sdl3_gpu=true, wchar32=true}})
 
-includes("project", "lib", "render")
+includes("project", "lib", "render", "tool", "tests", "bench")